@@ -14,7 +14,7 @@
  * @param degrees
  * @return int
  */
-int _compare_degrees(vertex u, vertex v, int* degrees) {
+static int _compare_degrees(vertex u, vertex v, int* degrees) {
     int degree_u = degrees[u];
     int degree_v = degrees[v];
 
@@ -25,139 +25,209 @@ int _compare_degrees(vertex u, vertex v, int* degrees) {
     return degree_u > degree_v ? u : v;
 }
 
-int _compare_vertex_id(vertex u, vertex v, int* _unused) {
+static int _compare_vertex_id(vertex u, vertex v, int* _unused) {
     // This param is necessary to match the expected function
     // signature for the graph_make_directed function, but it is
-    // causing an unused variable warning. This assertion is here to
+    // causing an unused variable warning. This cast is here to
     // silence the warning :)
-    assert(_unused == NULL || _unused != NULL);
+    (void)_unused;
     return max(u, v);
 }
 
-// End Helper Functions
-// Begin Specialized Clique Functions (k=1,2,3)
+/**
+ * @brief This function returns the vertex with the higher rank.
+ *
+ * @param u
+ * @param v
+ * @param ranks The position of each vertex in the ordering.
+ * @return int
+ */
+static int _compare_ranks(vertex u, vertex v, int* ranks) {
+    return ranks[u] > ranks[v] ? u : v;
+}
 
-void enumerate_three_cliques(Graph* graph, void* collection, void (*record)(void*, vertex, vertex, vertex)) {
+/**
+ * @brief Directs every edge of the param graph from its lower to its
+ * higher ranked endpoint under the param orientation.
+ *
+ * @param graph The undirected graph to orient.
+ * @param orientation The order used to rank the vertices.
+ * @return Graph* The oriented graph. The caller must delete it.
+ */
+Graph* get_oriented_graph(Graph* graph, CliqueOrientation orientation) {
     assert(graph != NULL);
     assert(graph->is_directed == false);
-    assert(graph->adjacency_matrix != NULL);
-    assert(graph->adjacency_matrix->is_set);
 
-    // Generate a degree oriented graph
-    int* undirected_degrees = graph_get_out_degrees(graph);
-    Graph* directed_graph = graph_make_directed(graph, _compare_degrees, undirected_degrees);
+    if (orientation == ORIENTATION_VERTEX_ID) {
+        return graph_make_directed(graph, _compare_vertex_id, NULL);
+    }
 
-    // Store these variables for easy access
-    CompressedSparseRow* adjacency_matrix = directed_graph->adjacency_matrix;
-    int* ptr_rows = adjacency_matrix->ptr_rows;
-    int* idx_cols = adjacency_matrix->idx_cols;
+    int* ranks = NULL;
 
-    // Loop over the (filtered) out-edges of v
-    for (vertex v = 0; v < graph->num_vertices; v++) {
-        int idx_v_begin_read = ptr_rows[v];
-        int idx_v_end_read = ptr_rows[v + 1];
+    if (orientation == ORIENTATION_DEGREE) {
+        ranks = graph_get_out_degrees(graph);
+        Graph* directed_graph = graph_make_directed(graph, _compare_degrees, ranks);
+        free(ranks);
+        return directed_graph;
+    }
 
-        for (int idx_u_nnz = idx_v_begin_read; idx_u_nnz < idx_v_end_read; idx_u_nnz++) {
-            vertex u = idx_cols[idx_u_nnz];
+    assert(orientation == ORIENTATION_DEGENERACY);
 
-            for (int idx_w_nnz = idx_u_nnz + 1; idx_w_nnz < idx_v_end_read; idx_w_nnz++) {
-                vertex w = idx_cols[idx_w_nnz];
+    CoreDecomposition* decomposition = run_core_decomposition(graph);
+    ranks = malloc(max(graph->num_vertices, 1) * sizeof(int));
 
-                if (graph_get_edge(graph, u, w) > 0) {
-                    record(collection, u, v, w);
-                }
-            }
+    for (int i = 0; i < graph->num_vertices; i++) {
+        ranks[decomposition->ordering[i]] = i;
+    }
 
-            for (int idx_w_nnz = idx_u_nnz + 1; idx_w_nnz < idx_v_end_read; idx_w_nnz++) {
-                vertex w = idx_cols[idx_w_nnz];
+    Graph* directed_graph = graph_make_directed(graph, _compare_ranks, ranks);
 
-                if (graph_get_edge(graph, u, w) > 0) {
-                    record(collection, u, v, w);
-                }
-            }
-        }
+    free(ranks);
+    core_decomposition_delete(&decomposition);
+
+    return directed_graph;
+}
+
+// End Helper Functions
+// Begin Specialized Clique Functions (k=1,2,3)
+
+/**
+ * @brief Returns the largest out degree of any vertex in the graph.
+ *
+ * This bounds the size of any intersection of out-neighborhoods, so
+ * it is used to size the intersection buffers.
+ *
+ * @param graph The graph to search.
+ * @return int The largest out degree, at least 1.
+ */
+static inline int _get_max_out_degree(Graph* graph) {
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int max_out_degree = 1;
+
+    for (vertex u = 0; u < graph->num_vertices; u++) {
+        max_out_degree = max(max_out_degree, ptr_rows[u + 1] - ptr_rows[u]);
     }
 
-    free(undirected_degrees);
-    graph_delete(&directed_graph);
+    return max_out_degree;
+}
+
+/**
+ * @brief Reports every triangle whose lowest ranked vertex is param
+ * v in the oriented graph.
+ *
+ * For every out-neighbor u of v, the out-neighbors w shared by v and
+ * u close the triangle (u, v, w). Since every triangle has exactly
+ * one vertex with out-edges to both other vertices, and exactly one
+ * of the remaining two vertices has an out-edge to the third, each
+ * triangle is reported exactly once. Each directed edge (v, u) costs
+ * one set intersection.
+ *
+ * @param directed_graph The oriented graph.
+ * @param v The vertex whose out-edges are scanned.
+ * @param buffer The intersection buffer, which must hold at least
+ * the largest out degree of the directed graph.
+ * @param collection The collection passed to param record.
+ * @param record The function called for every triangle.
+ */
+static inline void _enumerate_three_cliques_from(Graph* directed_graph, vertex v, vertex* buffer, void* collection, void (*record)(void*, vertex, vertex, vertex)) {
+    int* ptr_rows = directed_graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = directed_graph->adjacency_matrix->idx_cols;
+
+    int idx_v_begin_read = ptr_rows[v];
+    int idx_v_end_read = ptr_rows[v + 1];
+
+    for (int idx_u_nnz = idx_v_begin_read; idx_u_nnz < idx_v_end_read; idx_u_nnz++) {
+        vertex u = idx_cols[idx_u_nnz];
+
+        int* out_neighbors_v = &idx_cols[idx_v_begin_read];
+        int* out_neighbors_u = &idx_cols[ptr_rows[u]];
+        int num_common = set_intersection(out_neighbors_v, idx_v_end_read - idx_v_begin_read, out_neighbors_u, ptr_rows[u + 1] - ptr_rows[u], buffer);
+
+        for (int i = 0; i < num_common; i++) {
+            record(collection, u, v, buffer[i]);
+        }
+    }
 }
 
-void enumerate_four_cliques(Graph* graph, void* collection, void (*record)(void*, vertex, vertex, vertex, vertex)) {
+void enumerate_three_cliques(Graph* graph, CliqueOrientation orientation, void* collection, void (*record)(void*, vertex, vertex, vertex)) {
     assert(graph != NULL);
     assert(graph->is_directed == false);
     assert(graph->adjacency_matrix != NULL);
     assert(graph->adjacency_matrix->is_set);
 
-    // Generate a vertex id oriented graph
-    Graph* directed_graph = graph_make_directed(graph, _compare_vertex_id, NULL);
+    Graph* directed_graph = get_oriented_graph(graph, orientation);
+
+    vertex* buffer = malloc(_get_max_out_degree(directed_graph) * sizeof(vertex));
+
+    // Loop over the (filtered) out-edges of v
+    for (vertex v = 0; v < graph->num_vertices; v++) {
+        _enumerate_three_cliques_from(directed_graph, v, buffer, collection, record);
+    }
 
-    int* degrees = graph_get_in_degrees(directed_graph);
+    free(buffer);
+    graph_delete(&directed_graph);
+}
 
-    // Store the triangles found in the graph
-    vertex* triangle_ends = calloc(graph->num_vertices + 1, sizeof(vertex));
+/**
+ * @brief Reports every triangle, as (u, v1, v2, -1), and, if param
+ * should_list_four_cliques is set, every four-clique of the graph.
+ *
+ * @param graph The graph to search.
+ * @param orientation The order used to direct the edges.
+ * @param should_list_four_cliques False if only the triangles are
+ * needed, which skips the four-clique intersections.
+ * @param collection The collection passed to param record.
+ * @param record The function called for every clique.
+ */
+static void _enumerate_three_four_cliques(Graph* graph, CliqueOrientation orientation, bool should_list_four_cliques, void* collection, void (*record)(void*, vertex, vertex, vertex, vertex)) {
+    Graph* directed_graph = get_oriented_graph(graph, orientation);
 
     // Store these variables for easy access
     CompressedSparseRow* adjacency_matrix = directed_graph->adjacency_matrix;
     int* ptr_rows = adjacency_matrix->ptr_rows;
     int* idx_cols = adjacency_matrix->idx_cols;
 
+    // Store the triangles found for the current edge (u, v1), and
+    // the four-cliques found for the current triangle (u, v1, v2).
+    // Neither can be larger than the largest out degree.
+    int max_out_degree = _get_max_out_degree(directed_graph);
+    vertex* triangle_ends = malloc(max_out_degree * sizeof(vertex));
+    vertex* four_clique_ends = malloc(max_out_degree * sizeof(vertex));
+
     // Loop over all vertices
     for (vertex u = 0; u < directed_graph->num_vertices; u++) {
-        int idx_u_begin_read = ptr_rows[u];
         int idx_u_end_read = ptr_rows[u + 1];
 
         // Loop over neighbors of u
-        for (int idx_nnz = idx_u_begin_read; idx_nnz < idx_u_end_read; idx_nnz++) {
+        for (int idx_nnz = ptr_rows[u]; idx_nnz < idx_u_end_read; idx_nnz++) {
             vertex v1 = idx_cols[idx_nnz];
-            int count = 0;
-            // loop over another out-neighbor v2 of u, that is "ahead" of v1 in list of out-neighbors
-            // in other words, for each neighbor v1, look ahead to other neighbors v2
-            // note, the graph is directed such that the id of v1 is less than the id of v2
-            // this step looks for triangles formed by u and neighbors of u
-            for (int idx_nnz_ahead = idx_nnz + 1; idx_nnz_ahead < idx_u_end_read; idx_nnz_ahead++) {
-                vertex v2 = idx_cols[idx_nnz_ahead];
-
-                // check if there is an edge between v1 and v2
-                // since there is an edge between u, v1 and u, v2, this means there is a triangle
-                // formed by u, v1, and v2
-                if (graph_get_edge(graph, v1, v2) > 0) {
-                    record(collection, u, v1, v2, -1);
-                    triangle_ends[count] = v2;
-                    count++;
-                }
+
+            // The out-neighbors v2 of u that are also out-neighbors of
+            // v1 form the triangles (u, v1, v2). The orientation is
+            // acyclic, so each triangle is found once from the edge
+            // (u, v1) where v1 ranks between u and v2.
+            int* out_neighbors_u = &idx_cols[ptr_rows[u]];
+            int* out_neighbors_v1 = &idx_cols[ptr_rows[v1]];
+            int count = set_intersection(out_neighbors_u, idx_u_end_read - ptr_rows[u], out_neighbors_v1, ptr_rows[v1 + 1] - ptr_rows[v1], triangle_ends);
+
+            for (int idx_ref = 0; idx_ref < count; idx_ref++) {
+                record(collection, u, v1, triangle_ends[idx_ref], -1);
+            }
+
+            if (should_list_four_cliques == false) {
+                continue;
             }
 
-            // loop over all triangles formed by u, v1
-            for (int idx_ref_nnz = 0; idx_ref_nnz < count; idx_ref_nnz++) {
-                vertex v2 = triangle_ends[idx_ref_nnz];
-                vertex degree_v2 = degrees[v2];
-                vertex remaining = count - idx_ref_nnz;
-
-                int search_lower_bound = idx_ref_nnz + 1;
-
-                if (degree_v2 >= remaining) {
-                    for (int idx_ref_nnz_ahead = search_lower_bound; idx_ref_nnz_ahead < count; idx_ref_nnz_ahead++) {
-                        vertex v3 = triangle_ends[idx_ref_nnz_ahead];
-                        if (graph_get_edge(graph, v2, v3) > 0) {
-                            record(collection, u, v1, v2, v3);
-                        }
-                    }
-                } else {
-                    for (int idx_v2_nnz = ptr_rows[v2]; idx_v2_nnz < ptr_rows[v2 + 1]; idx_v2_nnz++) {
-                        vertex v3 = idx_cols[idx_v2_nnz];
-
-                        if (search_lower_bound > count - 1) {
-                            break;
-                        }
-
-                        if (v3 == u || v3 == v1) {
-                            break;
-                        }
-
-                        if (array_binary_search_range(triangle_ends, count, search_lower_bound, count - 1, v3) >= 0) {
-                            record(collection, u, v1, v2, v3);
-                        }
-                    }
+            // The triangle ends v3 that are also out-neighbors of v2
+            // form the four-cliques (u, v1, v2, v3).
+            for (int idx_ref = 0; idx_ref < count; idx_ref++) {
+                vertex v2 = triangle_ends[idx_ref];
+
+                int* out_neighbors_v2 = &idx_cols[ptr_rows[v2]];
+                int num_four_cliques = set_intersection(triangle_ends, count, out_neighbors_v2, ptr_rows[v2 + 1] - ptr_rows[v2], four_clique_ends);
+
+                for (int idx_four = 0; idx_four < num_four_cliques; idx_four++) {
+                    record(collection, u, v1, v2, four_clique_ends[idx_four]);
                 }
             }
         }
@@ -165,99 +235,1274 @@ void enumerate_four_cliques(Graph* graph, void* collection, void (*record)(void*
 
     graph_delete(&directed_graph);
     free(triangle_ends);
+    free(four_clique_ends);
+}
+
+void enumerate_four_cliques(Graph* graph, CliqueOrientation orientation, void* collection, void (*record)(void*, vertex, vertex, vertex, vertex)) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+
+    _enumerate_three_four_cliques(graph, orientation, true, collection, record);
+}
+
+// The sinks filled by enumerate_four_cliques_batched, either of which
+// may be NULL.
+typedef struct _ThreeFourSinks {
+    CliqueSink* three_sink;
+    CliqueSink* four_sink;
+} _ThreeFourSinks;
+
+/**
+ * @brief Pushes a triangle into the param sink.
+ */
+static void _push_three_clique(void* ptr_sink, vertex u, vertex v, vertex w) {
+    vertex three_clique[3] = {u, v, w};
+    clique_sink_push(ptr_sink, three_clique);
+}
+
+/**
+ * @brief Pushes a triangle, marked by a -1 fourth vertex, or a
+ * four-clique into the matching sink of param ptr_sinks.
+ */
+static void _push_three_four_clique(void* ptr_sinks, vertex u, vertex v1, vertex v2, vertex v3) {
+    _ThreeFourSinks* sinks = ptr_sinks;
+
+    if (v3 < 0) {
+        if (sinks->three_sink != NULL) {
+            _push_three_clique(sinks->three_sink, u, v1, v2);
+        }
+
+        return;
+    }
+
+    vertex four_clique[4] = {u, v1, v2, v3};
+    clique_sink_push(sinks->four_sink, four_clique);
+}
+
+/**
+ * @brief Pushes every triangle of the graph into param sink.
+ *
+ * This is enumerate_three_cliques, where the triangles are copied
+ * into the batches of the sink instead of passed to a callback one
+ * by one. The sink is flushed before returning.
+ *
+ * @param graph The graph to search.
+ * @param orientation The order used to direct the edges.
+ * @param sink The sink of three-cliques.
+ */
+void enumerate_three_cliques_batched(Graph* graph, CliqueOrientation orientation, CliqueSink* sink) {
+    assert(sink != NULL && sink->k == 3);
+
+    enumerate_three_cliques(graph, orientation, sink, _push_three_clique);
+    clique_sink_flush(sink);
+}
+
+/**
+ * @brief Pushes every triangle and four-clique of the graph into the
+ * matching sink.
+ *
+ * This is enumerate_four_cliques, where the cliques are copied into
+ * the batches of the sinks instead of passed to a callback one by
+ * one, and the triangles no longer need the -1 sentinel. Both sinks
+ * are flushed before returning.
+ *
+ * @param graph The graph to search.
+ * @param orientation The order used to direct the edges.
+ * @param three_sink The sink of three-cliques, or NULL.
+ * @param four_sink The sink of four-cliques, or NULL.
+ */
+void enumerate_four_cliques_batched(Graph* graph, CliqueOrientation orientation, CliqueSink* three_sink, CliqueSink* four_sink) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+    assert(three_sink == NULL || three_sink->k == 3);
+    assert(four_sink == NULL || four_sink->k == 4);
+
+    _ThreeFourSinks sinks = {three_sink, four_sink};
+    _enumerate_three_four_cliques(graph, orientation, four_sink != NULL, &sinks, _push_three_four_clique);
+
+    if (three_sink != NULL) {
+        clique_sink_flush(three_sink);
+    }
+
+    if (four_sink != NULL) {
+        clique_sink_flush(four_sink);
+    }
 }
 
 // End Specialized Clique Functions (k=1,2,3,4)
 // Begin Generalized Clique Functions (k>4)
 
 /**
- * @brief This function is the recursive part of Chibi-Nishizeki's
+ * @brief This function is the recursive part of Chiba-Nishizeki's
  * algorithm for finding k-cliques in a graph.
  *
- * @param graph
- * @param target_k
- * @param current_k
- * @param current_vertex
- * @param current_clique
- * @param candidates
- * @param cliques
- */
-void _find_neighbors(Graph* graph, int target_k, int current_k, int current_vertex, OrderedSet* current_clique, OrderedSet* candidates, CliqueSet* cliques) {
-    assert(current_vertex >= 0);
-    assert(current_vertex < graph->num_vertices);
-
-    // If the current clique is of size k, add it to the list of cliques
-    if (current_k == target_k) {
-        clique clique_copy = calloc(target_k, sizeof(int));
-        memcpy(clique_copy, current_clique->elements, target_k * sizeof(int));
-        clique_set_insert(cliques, clique_copy);
+ * The candidates are the common out-neighbors of every vertex of the
+ * current clique in the oriented graph, so every candidate extends it
+ * and each clique is found once from its lowest ranked vertex. The
+ * candidates of the next depth are written into buffers[depth], so
+ * nothing is allocated during the search.
+ *
+ * @param directed_graph The oriented graph.
+ * @param k The size of the cliques to find.
+ * @param depth The number of vertices in the current clique.
+ * @param candidates The vertices extending the current clique.
+ * @param num_candidates The number of candidates.
+ * @param buffers One candidate buffer per depth, each holding at least
+ * the largest out degree of the oriented graph.
+ * @param current_clique The vertices of the current clique.
+ * @param collection The collection passed to param record.
+ * @param record The function called for every k-clique.
+ */
+static void _extend_clique(Graph* directed_graph, int k, int depth, vertex* candidates, int num_candidates, vertex** buffers, vertex* current_clique, void* collection, void (*record)(void*, clique, int)) {
+    int* ptr_rows = directed_graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = directed_graph->adjacency_matrix->idx_cols;
+
+    // Every candidate completes a k-clique.
+    if (depth == k - 1) {
+        for (int i = 0; i < num_candidates; i++) {
+            current_clique[depth] = candidates[i];
+            record(collection, current_clique, k);
+        }
+
         return;
     }
 
-    OrderedSet* neighbors = graph_get_neighbors(graph, current_vertex);
-    OrderedSet* new_candidates = ordered_set_intersection(candidates, neighbors);
+    int num_remaining = k - depth - 1;
+
+    for (int i = 0; i < num_candidates; i++) {
+        vertex u = candidates[i];
+
+        // u needs at least num_remaining out-neighbors to be extended.
+        if (ptr_rows[u + 1] - ptr_rows[u] < num_remaining) {
+            continue;
+        }
+
+        int num_next_candidates = set_intersection(candidates, num_candidates, &idx_cols[ptr_rows[u]], ptr_rows[u + 1] - ptr_rows[u], buffers[depth]);
 
-    for (int i = 0; i < new_candidates->size; i++) {
-        vertex candidate = new_candidates->elements[i];
-        if (candidate > current_vertex) {
-            ordered_set_insert(current_clique, candidate);
-            _find_neighbors(graph, target_k, current_k + 1, candidate, current_clique, new_candidates, cliques);
-            ordered_set_remove(current_clique, candidate);
+        if (num_next_candidates < num_remaining) {
+            continue;
         }
+
+        current_clique[depth] = u;
+        _extend_clique(directed_graph, k, depth + 1, buffers[depth], num_next_candidates, buffers, current_clique, collection, record);
+    }
+}
+
+/**
+ * @brief Defines _extend_clique_L, the unrolled step of _extend_clique
+ * that still has to add param L vertices to the current clique. It
+ * extends the clique by each candidate and calls _extend_clique_PREV
+ * with the next candidates, written to param buffer. Since L is a
+ * constant, the pruning bounds are folded by the compiler and every
+ * step of a fixed k is a separate function without depth checks.
+ */
+#define _DEFINE_EXTEND_CLIQUE(L, PREV) \
+    static inline void _extend_clique_##L(int* ptr_rows, int* idx_cols, vertex* candidates, int num_candidates, vertex* buffer, int len_buffer, vertex* clique_end, vertex* current_clique, int k, void* collection, void (*record)(void*, clique, int)) { \
+        for (int i = 0; i < num_candidates; i++) { \
+            vertex u = candidates[i]; \
+            int out_degree = ptr_rows[u + 1] - ptr_rows[u]; \
+\
+            if (out_degree < L - 1) { \
+                continue; \
+            } \
+\
+            int num_next_candidates = set_intersection(candidates, num_candidates, &idx_cols[ptr_rows[u]], out_degree, buffer); \
+\
+            if (num_next_candidates < L - 1) { \
+                continue; \
+            } \
+\
+            *clique_end = u; \
+            _extend_clique_##PREV(ptr_rows, idx_cols, buffer, num_next_candidates, buffer + len_buffer, len_buffer, clique_end + 1, current_clique, k, collection, record); \
+        } \
     }
 
-    ordered_set_delete(&neighbors);
-    ordered_set_delete(&new_candidates);
+/**
+ * @brief The last step of the unrolled kernels, where every candidate
+ * completes a k-clique.
+ */
+static inline void _extend_clique_1(int* ptr_rows, int* idx_cols, vertex* candidates, int num_candidates, vertex* buffer, int len_buffer, vertex* clique_end, vertex* current_clique, int k, void* collection, void (*record)(void*, clique, int)) {
+    (void)ptr_rows;
+    (void)idx_cols;
+    (void)buffer;
+    (void)len_buffer;
+
+    for (int i = 0; i < num_candidates; i++) {
+        *clique_end = candidates[i];
+        record(collection, current_clique, k);
+    }
 }
 
+_DEFINE_EXTEND_CLIQUE(2, 1)
+_DEFINE_EXTEND_CLIQUE(3, 2)
+_DEFINE_EXTEND_CLIQUE(4, 3)
+_DEFINE_EXTEND_CLIQUE(5, 4)
+_DEFINE_EXTEND_CLIQUE(6, 5)
+_DEFINE_EXTEND_CLIQUE(7, 6)
+_DEFINE_EXTEND_CLIQUE(8, 7)
+_DEFINE_EXTEND_CLIQUE(9, 8)
+
+// The unrolled kernel adding L vertices to a clique, for every
+// L < CLIQUE_MAX_UNROLLED_K.
+static void (*const _extend_clique_kernels[CLIQUE_MAX_UNROLLED_K])(int*, int*, vertex*, int, vertex*, int, vertex*, vertex*, int, void*, void (*)(void*, clique, int)) = {
+    NULL,
+    _extend_clique_1,
+    _extend_clique_2,
+    _extend_clique_3,
+    _extend_clique_4,
+    _extend_clique_5,
+    _extend_clique_6,
+    _extend_clique_7,
+    _extend_clique_8,
+    _extend_clique_9,
+};
+
 /**
- * @brief This function returns the set of all k-cliques in the graph.
+ * @brief Reports every k-clique in the graph to param record.
  *
- * When k <= 3, this function uses specific functions to find each
- * k-clique. when k >= 4, this function uses Chibi-Nishizeki to find
- * each k-clique. The k-core of the input graph is computed to reduce
- * the search space of Chibi-Nishizeki.
+ * The graph is oriented with param orientation, then each vertex of
+ * the (k - 1)-core is extended with Chiba-Nishizeki's algorithm,
+ * since every vertex of a k-clique has k - 1 neighbors in it. The
+ * candidate buffers of every depth are allocated once, sized by the
+ * largest out-degree, which the degeneracy orientation bounds by the
+ * degeneracy. For k <= CLIQUE_MAX_UNROLLED_K the search is dispatched
+ * to the unrolled kernel of k, otherwise _extend_clique recurses.
+ *
+ * The clique passed to record is a buffer owned by this function and
+ * is only valid during the call, and its vertices are in the order
+ * they were added, not sorted. Callers storing the clique must copy
+ * it.
  *
  * @param graph The graph to search.
  * @param k The size of the cliques to find.
- * @return CliqueSet* Clique set containing an nxk 2D array of
- * cliques, where n is the number of k-cliques found.
+ * @param orientation The order used to direct the edges.
+ * @param collection The collection passed to param record.
+ * @param record The function called for every k-clique with the
+ * collection, the clique, and k.
  */
-CliqueSet* enumerate_k_cliques(Graph* graph, int k) {
+void enumerate_k_cliques_callback(Graph* graph, int k, CliqueOrientation orientation, void* collection, void (*record)(void*, clique, int)) {
     assert(graph != NULL);
     assert(graph->is_directed == false);
     assert(graph->adjacency_matrix != NULL);
     assert(graph->adjacency_matrix->is_set);
+    assert(k > 0);
+
+    vertex* current_clique = malloc(k * sizeof(vertex));
 
-    assert(k > 4);
+    if (k == 1) {
+        for (vertex v = 0; v < graph->num_vertices; v++) {
+            current_clique[0] = v;
+            record(collection, current_clique, k);
+        }
+
+        free(current_clique);
+        return;
+    }
 
-    // Use chiba nishizeki to find all k-cliques when k >= 4.
-    // Create the resulting set of k-cliques
-    int resize_value = 5;
-    CliqueSet* cliques = clique_set_new(k, resize_value);
+    bool* is_vertex_removed = get_vertices_not_in_k_core(graph, k - 1);
+    Graph* directed_graph = get_oriented_graph(graph, orientation);
 
-    // Compute and k-core to reduce search space
-    bool* is_vertex_removed = get_vertices_not_in_k_core(graph, k);
+    int* ptr_rows = directed_graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = directed_graph->adjacency_matrix->idx_cols;
 
-    // Create clique of size k to compute k-cliques
-    OrderedSet* current_clique = ordered_set_new(k);
+    int max_out_degree = _get_max_out_degree(directed_graph);
+    vertex** buffers = malloc(k * sizeof(vertex*));
+    vertex* buffer_storage = malloc((size_t)k * max_out_degree * sizeof(vertex));
+
+    for (int depth = 0; depth < k; depth++) {
+        buffers[depth] = &buffer_storage[(size_t)depth * max_out_degree];
+    }
 
     for (vertex v = 0; v < graph->num_vertices; v++) {
-        if (is_vertex_removed[v] == true) {
+        if (is_vertex_removed[v] == true || ptr_rows[v + 1] - ptr_rows[v] < k - 1) {
             continue;
         }
 
-        ordered_set_insert(current_clique, v);
-        OrderedSet* candidates = graph_get_neighbors(graph, v);
-        _find_neighbors(graph, k, 1, v, current_clique, candidates, cliques);
-        ordered_set_remove(current_clique, v);
-        ordered_set_delete(&candidates);
+        current_clique[0] = v;
+
+        if (k <= CLIQUE_MAX_UNROLLED_K) {
+            _extend_clique_kernels[k - 1](ptr_rows, idx_cols, &idx_cols[ptr_rows[v]], ptr_rows[v + 1] - ptr_rows[v], buffer_storage, max_out_degree, &current_clique[1], current_clique, k, collection, record);
+        } else {
+            _extend_clique(directed_graph, k, 1, &idx_cols[ptr_rows[v]], ptr_rows[v + 1] - ptr_rows[v], buffers, current_clique, collection, record);
+        }
     }
 
-    ordered_set_delete(&current_clique);
+    free(buffer_storage);
+    free(buffers);
+    free(current_clique);
     free(is_vertex_removed);
+    graph_delete(&directed_graph);
+}
+
+/**
+ * @brief This function returns the set of all k-cliques in the graph.
+ *
+ * The cliques are found with enumerate_k_cliques_callback or
+ * enumerate_k_cliques_ebbkc, depending on param engine, and stored in
+ * a clique set.
+ *
+ * @param graph The graph to search.
+ * @param k The size of the cliques to find.
+ * @param engine The listing algorithm to use.
+ * @param orientation The order used to direct the edges, only used by
+ * ENGINE_CHIBA_NISHIZEKI.
+ * @return CliqueSet* Clique set containing the n k-cliques found in
+ * lexicographic order.
+ */
+CliqueSet* enumerate_k_cliques(Graph* graph, int k, CliqueEngine engine, CliqueOrientation orientation) {
+    int initial_capacity = 16;
+    CliqueSet* cliques = clique_set_new(k, initial_capacity);
+
+    if (engine == ENGINE_EBBKC) {
+        enumerate_k_cliques_ebbkc(graph, k, cliques, clique_set_record);
+    } else {
+        enumerate_k_cliques_callback(graph, k, orientation, cliques, clique_set_record);
+    }
+
+    clique_set_finalize(cliques);
 
     return cliques;
 }
 
 // End Generalized Clique Functions
+// Begin Counting Functions
+
+/**
+ * @brief Counts the triangles of the graph without reporting them.
+ *
+ * This is enumerate_three_cliques where the common out-neighbors of
+ * each directed edge are only counted.
+ *
+ * @param graph The graph to search.
+ * @param orientation The order used to direct the edges.
+ * @return long The number of triangles.
+ */
+long count_three_cliques(Graph* graph, CliqueOrientation orientation) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+
+    Graph* directed_graph = get_oriented_graph(graph, orientation);
+    int* ptr_rows = directed_graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = directed_graph->adjacency_matrix->idx_cols;
+
+    long num_three_cliques = 0;
+
+    for (vertex v = 0; v < directed_graph->num_vertices; v++) {
+        for (int idx_u_nnz = ptr_rows[v]; idx_u_nnz < ptr_rows[v + 1]; idx_u_nnz++) {
+            vertex u = idx_cols[idx_u_nnz];
+            num_three_cliques += set_intersection_size(&idx_cols[ptr_rows[v]], ptr_rows[v + 1] - ptr_rows[v], &idx_cols[ptr_rows[u]], ptr_rows[u + 1] - ptr_rows[u]);
+        }
+    }
+
+    graph_delete(&directed_graph);
+
+    return num_three_cliques;
+}
+
+/**
+ * @brief Counts the four-cliques of the graph without reporting them.
+ *
+ * This is enumerate_four_cliques where the four-clique ends of each
+ * triangle are only counted.
+ *
+ * @param graph The graph to search.
+ * @param orientation The order used to direct the edges.
+ * @return long The number of four-cliques.
+ */
+long count_four_cliques(Graph* graph, CliqueOrientation orientation) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+
+    Graph* directed_graph = get_oriented_graph(graph, orientation);
+    int* ptr_rows = directed_graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = directed_graph->adjacency_matrix->idx_cols;
+
+    vertex* triangle_ends = malloc(_get_max_out_degree(directed_graph) * sizeof(vertex));
+    long num_four_cliques = 0;
+
+    for (vertex u = 0; u < directed_graph->num_vertices; u++) {
+        for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+            vertex v1 = idx_cols[idx_nnz];
+            int count = set_intersection(&idx_cols[ptr_rows[u]], ptr_rows[u + 1] - ptr_rows[u], &idx_cols[ptr_rows[v1]], ptr_rows[v1 + 1] - ptr_rows[v1], triangle_ends);
+
+            for (int idx_ref = 0; idx_ref < count; idx_ref++) {
+                vertex v2 = triangle_ends[idx_ref];
+                num_four_cliques += set_intersection_size(triangle_ends, count, &idx_cols[ptr_rows[v2]], ptr_rows[v2 + 1] - ptr_rows[v2]);
+            }
+        }
+    }
+
+    free(triangle_ends);
+    graph_delete(&directed_graph);
+
+    return num_four_cliques;
+}
+
+/**
+ * @brief Counts the cliques that add param l vertices from the
+ * candidates to the current clique.
+ *
+ * This is _extend_clique, except that the last two vertices are not
+ * chosen one by one: the cliques completed by a candidate u are
+ * counted as the size of the intersection of the candidates with the
+ * out-neighbors of u.
+ *
+ * @param ptr_rows The row pointers of the oriented graph.
+ * @param idx_cols The column indices of the oriented graph.
+ * @param candidates The vertices extending the current clique.
+ * @param num_candidates The number of candidates.
+ * @param l The number of vertices still to add, at least 2.
+ * @param buffers One candidate buffer per remaining level.
+ * @return long The number of cliques found.
+ */
+static long _count_clique_extensions(int* ptr_rows, int* idx_cols, vertex* candidates, int num_candidates, int l, vertex** buffers) {
+    long num_cliques = 0;
+
+    for (int i = 0; i < num_candidates; i++) {
+        vertex u = candidates[i];
+        int out_degree = ptr_rows[u + 1] - ptr_rows[u];
+
+        if (out_degree < l - 1) {
+            continue;
+        }
+
+        if (l == 2) {
+            num_cliques += set_intersection_size(candidates, num_candidates, &idx_cols[ptr_rows[u]], out_degree);
+            continue;
+        }
+
+        int num_next_candidates = set_intersection(candidates, num_candidates, &idx_cols[ptr_rows[u]], out_degree, buffers[0]);
+
+        if (num_next_candidates >= l - 1) {
+            num_cliques += _count_clique_extensions(ptr_rows, idx_cols, buffers[0], num_next_candidates, l - 1, &buffers[1]);
+        }
+    }
+
+    return num_cliques;
+}
+
+/**
+ * @brief Counts the k-cliques of the graph without reporting them.
+ *
+ * The search is the one of enumerate_k_cliques_callback, restricted
+ * to the (k - 1)-core, but the counts are accumulated by
+ * _count_clique_extensions and no function is called per clique.
+ *
+ * @param graph The graph to search.
+ * @param k The size of the cliques to count.
+ * @param orientation The order used to direct the edges.
+ * @return long The number of k-cliques.
+ */
+long count_k_cliques(Graph* graph, int k, CliqueOrientation orientation) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+    assert(k > 0);
+
+    if (k == 1) {
+        return graph->num_vertices;
+    }
+
+    if (k == 2) {
+        return graph->num_edges / 2;
+    }
+
+    bool* is_vertex_removed = get_vertices_not_in_k_core(graph, k - 1);
+    Graph* directed_graph = get_oriented_graph(graph, orientation);
+
+    int* ptr_rows = directed_graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = directed_graph->adjacency_matrix->idx_cols;
+
+    int max_out_degree = _get_max_out_degree(directed_graph);
+    vertex** buffers = malloc(k * sizeof(vertex*));
+    vertex* buffer_storage = malloc((size_t)k * max_out_degree * sizeof(vertex));
+
+    for (int depth = 0; depth < k; depth++) {
+        buffers[depth] = &buffer_storage[(size_t)depth * max_out_degree];
+    }
+
+    long num_cliques = 0;
+
+    for (vertex v = 0; v < directed_graph->num_vertices; v++) {
+        if (is_vertex_removed[v] == true || ptr_rows[v + 1] - ptr_rows[v] < k - 1) {
+            continue;
+        }
+
+        num_cliques += _count_clique_extensions(ptr_rows, idx_cols, &idx_cols[ptr_rows[v]], ptr_rows[v + 1] - ptr_rows[v], k - 1, buffers);
+    }
+
+    free(buffer_storage);
+    free(buffers);
+    free(is_vertex_removed);
+    graph_delete(&directed_graph);
+
+    return num_cliques;
+}
+
+/**
+ * @brief The state of _count_local_extensions, which is constant
+ * during the search of one graph.
+ */
+typedef struct _LocalCliqueCounts {
+    int* ptr_rows;
+    int* idx_cols;
+    // The undirected edge id of each directed entry, or NULL.
+    int* dir_edge_ids;
+    vertex** buffers;
+    vertex* current_clique;
+    // Either count array may be NULL if it is not wanted.
+    long* vertex_counts;
+    long* edge_counts;
+} _LocalCliqueCounts;
+
+/**
+ * @brief Adds the cliques that add param l vertices from the
+ * candidates to the current clique to the count of each of their
+ * vertices and edges.
+ *
+ * On the last level, each vertex and edge of the current clique is
+ * in one clique per candidate, so its count grows by the number of
+ * candidates at once, and only the counts involving a candidate are
+ * incremented one by one. The edges are directed from the earlier to
+ * the later vertex of the clique, so the id of an edge to a candidate
+ * is found by binary searching the row of the earlier vertex.
+ *
+ * @param counts The search state.
+ * @param candidates The vertices extending the current clique.
+ * @param num_candidates The number of candidates.
+ * @param l The number of vertices still to add, at least 1.
+ * @param depth The number of vertices in the current clique.
+ */
+static void _count_local_extensions(_LocalCliqueCounts* counts, vertex* candidates, int num_candidates, int l, int depth) {
+    int* ptr_rows = counts->ptr_rows;
+    int* idx_cols = counts->idx_cols;
+    vertex* current_clique = counts->current_clique;
+
+    if (l == 1) {
+        if (counts->vertex_counts != NULL) {
+            for (int i = 0; i < depth; i++) {
+                counts->vertex_counts[current_clique[i]] += num_candidates;
+            }
+
+            for (int i = 0; i < num_candidates; i++) {
+                counts->vertex_counts[candidates[i]]++;
+            }
+        }
+
+        if (counts->edge_counts != NULL) {
+            for (int i = 0; i < depth; i++) {
+                vertex u = current_clique[i];
+
+                for (int j = i + 1; j < depth; j++) {
+                    int idx_nnz = array_binary_search_range(idx_cols, ptr_rows[u + 1], ptr_rows[u], ptr_rows[u + 1] - 1, current_clique[j]);
+                    counts->edge_counts[counts->dir_edge_ids[idx_nnz]] += num_candidates;
+                }
+
+                for (int j = 0; j < num_candidates; j++) {
+                    int idx_nnz = array_binary_search_range(idx_cols, ptr_rows[u + 1], ptr_rows[u], ptr_rows[u + 1] - 1, candidates[j]);
+                    counts->edge_counts[counts->dir_edge_ids[idx_nnz]]++;
+                }
+            }
+        }
+
+        return;
+    }
+
+    for (int i = 0; i < num_candidates; i++) {
+        vertex u = candidates[i];
+        int out_degree = ptr_rows[u + 1] - ptr_rows[u];
+
+        if (out_degree < l - 1) {
+            continue;
+        }
+
+        int num_next_candidates = set_intersection(candidates, num_candidates, &idx_cols[ptr_rows[u]], out_degree, counts->buffers[depth]);
+
+        if (num_next_candidates < l - 1) {
+            continue;
+        }
+
+        current_clique[depth] = u;
+        _count_local_extensions(counts, counts->buffers[depth], num_next_candidates, l - 1, depth + 1);
+    }
+}
+
+/**
+ * @brief Runs _count_local_extensions from every vertex of the
+ * (k - 1)-core, filling the non-NULL count arrays.
+ *
+ * @param graph The graph to search.
+ * @param k The size of the cliques to count, at least 2.
+ * @param orientation The order used to direct the edges.
+ * @param edge_ids The id of each non-zero entry from
+ * graph_get_edge_ids, only used if param edge_counts is not NULL.
+ * @param vertex_counts The per-vertex counts, or NULL.
+ * @param edge_counts The per-edge counts, or NULL.
+ */
+static void _count_local_cliques(Graph* graph, int k, CliqueOrientation orientation, int* edge_ids, long* vertex_counts, long* edge_counts) {
+    bool* is_vertex_removed = get_vertices_not_in_k_core(graph, k - 1);
+    Graph* directed_graph = get_oriented_graph(graph, orientation);
+
+    int* ptr_rows = directed_graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = directed_graph->adjacency_matrix->idx_cols;
+    int* dir_edge_ids = NULL;
+
+    // Map each directed entry to the id of its undirected edge.
+    if (edge_counts != NULL) {
+        int* ptr_undirected_rows = graph->adjacency_matrix->ptr_rows;
+        int* idx_undirected_cols = graph->adjacency_matrix->idx_cols;
+        dir_edge_ids = malloc(max(directed_graph->num_edges, 1) * sizeof(int));
+
+        for (vertex v = 0; v < directed_graph->num_vertices; v++) {
+            for (int idx_nnz = ptr_rows[v]; idx_nnz < ptr_rows[v + 1]; idx_nnz++) {
+                int idx_undirected_nnz = array_binary_search_range(idx_undirected_cols, graph->num_edges, ptr_undirected_rows[v], ptr_undirected_rows[v + 1] - 1, idx_cols[idx_nnz]);
+                assert(idx_undirected_nnz >= 0);
+                dir_edge_ids[idx_nnz] = edge_ids[idx_undirected_nnz];
+            }
+        }
+    }
+
+    int max_out_degree = _get_max_out_degree(directed_graph);
+    vertex** buffers = malloc(k * sizeof(vertex*));
+    vertex* buffer_storage = malloc((size_t)k * max_out_degree * sizeof(vertex));
+
+    for (int depth = 0; depth < k; depth++) {
+        buffers[depth] = &buffer_storage[(size_t)depth * max_out_degree];
+    }
+
+    _LocalCliqueCounts counts = {
+        .ptr_rows = ptr_rows,
+        .idx_cols = idx_cols,
+        .dir_edge_ids = dir_edge_ids,
+        .buffers = buffers,
+        .current_clique = malloc(k * sizeof(vertex)),
+        .vertex_counts = vertex_counts,
+        .edge_counts = edge_counts,
+    };
+
+    for (vertex v = 0; v < directed_graph->num_vertices; v++) {
+        if (is_vertex_removed[v] == true || ptr_rows[v + 1] - ptr_rows[v] < k - 1) {
+            continue;
+        }
+
+        counts.current_clique[0] = v;
+        _count_local_extensions(&counts, &idx_cols[ptr_rows[v]], ptr_rows[v + 1] - ptr_rows[v], k - 1, 1);
+    }
+
+    free(counts.current_clique);
+    free(buffer_storage);
+    free(buffers);
+    free(dir_edge_ids);
+    free(is_vertex_removed);
+    graph_delete(&directed_graph);
+}
+
+/**
+ * @brief Counts the k-cliques containing each vertex of the graph.
+ *
+ * @param graph The graph to search.
+ * @param k The size of the cliques to count.
+ * @param orientation The order used to direct the edges.
+ * @return long* An array of size graph->num_vertices holding the
+ * number of k-cliques containing each vertex.
+ */
+long* count_k_cliques_per_vertex(Graph* graph, int k, CliqueOrientation orientation) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+    assert(k > 0);
+
+    long* vertex_counts = calloc(max(graph->num_vertices, 1), sizeof(long));
+
+    if (k == 1) {
+        for (vertex v = 0; v < graph->num_vertices; v++) {
+            vertex_counts[v] = 1;
+        }
+    } else {
+        _count_local_cliques(graph, k, orientation, NULL, vertex_counts, NULL);
+    }
+
+    return vertex_counts;
+}
+
+/**
+ * @brief Counts the k-cliques containing each edge of the graph.
+ *
+ * @param graph The graph to search.
+ * @param k The size of the cliques to count, at least 2.
+ * @param orientation The order used to direct the edges.
+ * @param edge_ids The id of each non-zero entry from
+ * graph_get_edge_ids.
+ * @return long* An array of size graph->num_edges / 2 holding the
+ * number of k-cliques containing each edge. For k = 3 these are the
+ * supports of get_edge_supports.
+ */
+long* count_k_cliques_per_edge(Graph* graph, int k, CliqueOrientation orientation, int* edge_ids) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+    assert(edge_ids != NULL);
+    assert(k > 1);
+
+    long* edge_counts = calloc(max(graph->num_edges / 2, 1), sizeof(long));
+    _count_local_cliques(graph, k, orientation, edge_ids, NULL, edge_counts);
+
+    return edge_counts;
+}
+
+// End Counting Functions
+// Begin Edge-Oriented Clique Functions
+
+/**
+ * @brief The subgraph induced by the vertices closing a triangle with
+ * the edge currently being branched on in enumerate_k_cliques_ebbkc,
+ * together with the buffers used to list its cliques.
+ *
+ * The adjacency rows are bitsets of num_words words over the local
+ * ids 0, ..., num_vertices - 1, and every buffer is sized for the
+ * largest subgraph, so nothing is allocated while branching.
+ */
+typedef struct _EdgeSubgraph {
+    int k;
+    int num_vertices;
+    int num_words;
+
+    // The graph vertex of each local id, in increasing order.
+    vertex* vertices;
+    // The greedy color of each local id, starting at 1.
+    int* colors;
+    // The undirected adjacency rows.
+    uint64_t* neighbors;
+    // The adjacency rows restricted to neighbors of lower color.
+    uint64_t* out_neighbors;
+    // One candidate bitset per branching level.
+    uint64_t* candidates;
+    // The local ids of a candidate set found to be a clique.
+    int* members;
+    // Used colors while coloring, all false between calls.
+    bool* is_color_used;
+
+    vertex* current_clique;
+    void* collection;
+    void (*record)(void*, clique, int);
+} _EdgeSubgraph;
+
+/**
+ * @brief Builds the subgraph of the edge (u, v) peeled at param
+ * rank_e.
+ *
+ * The vertices are the common neighbors w of u and v where both (u, w)
+ * and (v, w) are peeled after (u, v), and the edges are those between
+ * them peeled after (u, v). Every k-clique is then found exactly once,
+ * from its first peeled edge. By the definition of the truss number,
+ * at most truss number - 2 vertices remain.
+ *
+ * @param graph The undirected graph.
+ * @param edge_ids The id of each non-zero entry from
+ * graph_get_edge_ids.
+ * @param edge_ranks The position of each edge in the peel order.
+ * @param rank_e The position of the edge (u, v) in the peel order.
+ * @param u The first endpoint of the edge.
+ * @param v The second endpoint of the edge.
+ * @param subgraph The subgraph to fill.
+ */
+static void _build_edge_subgraph(Graph* graph, int* edge_ids, int* edge_ranks, int rank_e, vertex u, vertex v, _EdgeSubgraph* subgraph) {
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+
+    int idx_u_read = ptr_rows[u];
+    int idx_v_read = ptr_rows[v];
+    int num_vertices = 0;
+
+    while (idx_u_read < ptr_rows[u + 1] && idx_v_read < ptr_rows[v + 1]) {
+        vertex w_u = idx_cols[idx_u_read];
+        vertex w_v = idx_cols[idx_v_read];
+
+        if (w_u < w_v) {
+            idx_u_read++;
+        } else if (w_u > w_v) {
+            idx_v_read++;
+        } else {
+            if (edge_ranks[edge_ids[idx_u_read]] > rank_e && edge_ranks[edge_ids[idx_v_read]] > rank_e) {
+                subgraph->vertices[num_vertices++] = w_u;
+            }
+
+            idx_u_read++;
+            idx_v_read++;
+        }
+    }
+
+    subgraph->num_vertices = num_vertices;
+    subgraph->num_words = (num_vertices + 63) / 64;
+
+    int num_words = subgraph->num_words;
+    memset(subgraph->neighbors, 0, (size_t)num_vertices * num_words * sizeof(uint64_t));
+
+    // Merge the neighborhood of each local vertex with the sorted
+    // local vertices.
+    for (int a = 0; a < num_vertices; a++) {
+        vertex w = subgraph->vertices[a];
+        uint64_t* row = &subgraph->neighbors[(size_t)a * num_words];
+
+        int idx_w_read = ptr_rows[w];
+        int b = 0;
+
+        while (idx_w_read < ptr_rows[w + 1] && b < num_vertices) {
+            vertex x = idx_cols[idx_w_read];
+
+            if (x < subgraph->vertices[b]) {
+                idx_w_read++;
+            } else if (x > subgraph->vertices[b]) {
+                b++;
+            } else {
+                if (edge_ranks[edge_ids[idx_w_read]] > rank_e) {
+                    row[b / 64] |= 1ULL << (b % 64);
+                }
+
+                idx_w_read++;
+                b++;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Greedily colors the subgraph and orients each edge from the
+ * higher to the lower color.
+ *
+ * Adjacent vertices never share a color, so the vertices of a clique
+ * have distinct colors and a clique whose highest colored vertex has
+ * color c has at most c vertices.
+ *
+ * @param subgraph The subgraph to color.
+ */
+static void _color_edge_subgraph(_EdgeSubgraph* subgraph) {
+    int num_vertices = subgraph->num_vertices;
+    int num_words = subgraph->num_words;
+
+    for (int a = 0; a < num_vertices; a++) {
+        uint64_t* row = &subgraph->neighbors[(size_t)a * num_words];
+
+        // Only the neighbors with a lower local id are colored.
+        for (int idx_word = 0; idx_word <= a / 64; idx_word++) {
+            uint64_t word = row[idx_word];
+
+            if (idx_word == a / 64) {
+                word &= (1ULL << (a % 64)) - 1;
+            }
+
+            for (; word != 0; word &= word - 1) {
+                int b = idx_word * 64 + __builtin_ctzll(word);
+                subgraph->is_color_used[subgraph->colors[b]] = true;
+            }
+        }
+
+        int color = 1;
+        while (subgraph->is_color_used[color] == true) {
+            color++;
+        }
+
+        subgraph->colors[a] = color;
+
+        for (int idx_word = 0; idx_word <= a / 64; idx_word++) {
+            for (uint64_t word = row[idx_word]; word != 0; word &= word - 1) {
+                int b = idx_word * 64 + __builtin_ctzll(word);
+
+                if (b < a) {
+                    subgraph->is_color_used[subgraph->colors[b]] = false;
+                }
+            }
+        }
+    }
+
+    for (int a = 0; a < num_vertices; a++) {
+        uint64_t* row = &subgraph->neighbors[(size_t)a * num_words];
+        uint64_t* out_row = &subgraph->out_neighbors[(size_t)a * num_words];
+
+        for (int idx_word = 0; idx_word < num_words; idx_word++) {
+            out_row[idx_word] = 0;
+
+            for (uint64_t word = row[idx_word]; word != 0; word &= word - 1) {
+                int b = idx_word * 64 + __builtin_ctzll(word);
+
+                if (subgraph->colors[b] < subgraph->colors[a]) {
+                    out_row[idx_word] |= 1ULL << (b % 64);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Reports every combination of param l of the first
+ * num_members members, starting at param idx_begin, which all form
+ * cliques since the members do.
+ *
+ * @param subgraph The subgraph holding the members.
+ * @param num_members The number of members.
+ * @param idx_begin The first member that may be chosen.
+ * @param l The number of vertices still to choose.
+ * @param depth The number of vertices in the current clique.
+ */
+static void _record_combinations(_EdgeSubgraph* subgraph, int num_members, int idx_begin, int l, int depth) {
+    if (l == 0) {
+        subgraph->record(subgraph->collection, subgraph->current_clique, subgraph->k);
+        return;
+    }
+
+    for (int i = idx_begin; i <= num_members - l; i++) {
+        subgraph->current_clique[depth] = subgraph->vertices[subgraph->members[i]];
+        _record_combinations(subgraph, num_members, i + 1, l - 1, depth + 1);
+    }
+}
+
+/**
+ * @brief Reports every l-clique among the candidates of param level,
+ * each extending the current clique.
+ *
+ * Each l-clique is found once from its highest colored vertex, so a
+ * vertex of color below l is never branched on. When the candidates
+ * form a clique themselves, every l-combination of them is reported
+ * without further branching.
+ *
+ * @param subgraph The colored subgraph.
+ * @param l The size of the cliques to find among the candidates.
+ * @param level The level whose candidate bitset is searched.
+ * @param depth The number of vertices in the current clique.
+ */
+static void _branch_edge_subgraph(_EdgeSubgraph* subgraph, int l, int level, int depth) {
+    int num_words = subgraph->num_words;
+    uint64_t* candidates = &subgraph->candidates[(size_t)level * num_words];
+
+    int num_candidates = 0;
+    for (int idx_word = 0; idx_word < num_words; idx_word++) {
+        num_candidates += __builtin_popcountll(candidates[idx_word]);
+    }
+
+    if (num_candidates < l) {
+        return;
+    }
+
+    if (l == 1) {
+        for (int idx_word = 0; idx_word < num_words; idx_word++) {
+            for (uint64_t word = candidates[idx_word]; word != 0; word &= word - 1) {
+                subgraph->current_clique[depth] = subgraph->vertices[idx_word * 64 + __builtin_ctzll(word)];
+                subgraph->record(subgraph->collection, subgraph->current_clique, subgraph->k);
+            }
+        }
+
+        return;
+    }
+
+    // Check whether every candidate is adjacent to every other one.
+    bool is_clique = true;
+    int num_members = 0;
+
+    for (int idx_word = 0; idx_word < num_words && is_clique; idx_word++) {
+        for (uint64_t word = candidates[idx_word]; word != 0 && is_clique; word &= word - 1) {
+            int a = idx_word * 64 + __builtin_ctzll(word);
+            uint64_t* row = &subgraph->neighbors[(size_t)a * num_words];
+
+            int num_adjacent = 0;
+            for (int idx_other_word = 0; idx_other_word < num_words; idx_other_word++) {
+                num_adjacent += __builtin_popcountll(row[idx_other_word] & candidates[idx_other_word]);
+            }
+
+            is_clique = num_adjacent == num_candidates - 1;
+            subgraph->members[num_members++] = a;
+        }
+    }
+
+    if (is_clique) {
+        _record_combinations(subgraph, num_members, 0, l, depth);
+        return;
+    }
+
+    uint64_t* next_candidates = &candidates[num_words];
+
+    for (int idx_word = 0; idx_word < num_words; idx_word++) {
+        for (uint64_t word = candidates[idx_word]; word != 0; word &= word - 1) {
+            int a = idx_word * 64 + __builtin_ctzll(word);
+
+            if (subgraph->colors[a] < l) {
+                continue;
+            }
+
+            uint64_t* out_row = &subgraph->out_neighbors[(size_t)a * num_words];
+            for (int idx_other_word = 0; idx_other_word < num_words; idx_other_word++) {
+                next_candidates[idx_other_word] = candidates[idx_other_word] & out_row[idx_other_word];
+            }
+
+            subgraph->current_clique[depth] = subgraph->vertices[a];
+            _branch_edge_subgraph(subgraph, l - 1, level + 1, depth + 1);
+        }
+    }
+}
+
+/**
+ * @brief Reports every k-clique in the graph to param record using
+ * edge-oriented branching (Yuan et al.).
+ *
+ * The edges are visited in the peel order of the truss decomposition,
+ * and each edge (u, v) with truss number at least k branches into the
+ * subgraph of the vertices closing a triangle with it through edges
+ * peeled later, which has at most truss number - 2 vertices. The
+ * (k - 2)-cliques of each subgraph are listed on bitsets with the
+ * color pruning and clique early termination of
+ * _branch_edge_subgraph. Every buffer is sized by the largest truss
+ * number and allocated once.
+ *
+ * The clique passed to record is a buffer owned by this function and
+ * is only valid during the call, and its vertices are not sorted.
+ * Callers storing the clique must copy it.
+ *
+ * @param graph The graph to search, whose rows must be sorted.
+ * @param k The size of the cliques to find.
+ * @param collection The collection passed to param record.
+ * @param record The function called for every k-clique with the
+ * collection, the clique, and k.
+ */
+void enumerate_k_cliques_ebbkc(Graph* graph, int k, void* collection, void (*record)(void*, clique, int)) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+    assert(k > 0);
+
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+    vertex* current_clique = malloc(k * sizeof(vertex));
+
+    // Vertices and edges need no branching.
+    if (k <= 2) {
+        for (vertex u = 0; u < graph->num_vertices; u++) {
+            current_clique[0] = u;
+
+            if (k == 1) {
+                record(collection, current_clique, k);
+                continue;
+            }
+
+            for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+                if (idx_cols[idx_nnz] > u) {
+                    current_clique[1] = idx_cols[idx_nnz];
+                    record(collection, current_clique, k);
+                }
+            }
+        }
+
+        free(current_clique);
+        return;
+    }
+
+    TrussDecomposition* decomposition = run_truss_decomposition(graph);
+    int num_edges = decomposition->num_edges;
+
+    int* edge_ranks = malloc(max(num_edges, 1) * sizeof(int));
+    for (int i = 0; i < num_edges; i++) {
+        edge_ranks[decomposition->edge_order[i]] = i;
+    }
+
+    int max_num_vertices = max(decomposition->max_truss_number - 2, 1);
+    int max_num_words = (max_num_vertices + 63) / 64;
+
+    _EdgeSubgraph subgraph = {
+        .k = k,
+        .vertices = malloc(max_num_vertices * sizeof(vertex)),
+        .colors = malloc(max_num_vertices * sizeof(int)),
+        .neighbors = malloc((size_t)max_num_vertices * max_num_words * sizeof(uint64_t)),
+        .out_neighbors = malloc((size_t)max_num_vertices * max_num_words * sizeof(uint64_t)),
+        .candidates = malloc((size_t)(k - 1) * max_num_words * sizeof(uint64_t)),
+        .members = malloc(max_num_vertices * sizeof(int)),
+        .is_color_used = calloc(max_num_vertices + 2, sizeof(bool)),
+        .current_clique = current_clique,
+        .collection = collection,
+        .record = record,
+    };
+
+    for (int i = 0; i < num_edges; i++) {
+        int e = decomposition->edge_order[i];
+
+        // Every edge of a k-clique is in the k-truss.
+        if (decomposition->truss_numbers[e] < k) {
+            continue;
+        }
+
+        vertex u = decomposition->edge_sources[e];
+        vertex v = decomposition->edge_targets[e];
+
+        _build_edge_subgraph(graph, decomposition->edge_ids, edge_ranks, i, u, v, &subgraph);
+        assert(subgraph.num_vertices <= max_num_vertices);
+
+        if (subgraph.num_vertices < k - 2) {
+            continue;
+        }
+
+        _color_edge_subgraph(&subgraph);
+
+        int num_words = subgraph.num_words;
+        for (int idx_word = 0; idx_word < num_words; idx_word++) {
+            subgraph.candidates[idx_word] = ~0ULL;
+        }
+
+        if (subgraph.num_vertices % 64 != 0) {
+            subgraph.candidates[num_words - 1] = (1ULL << (subgraph.num_vertices % 64)) - 1;
+        }
+
+        current_clique[0] = u;
+        current_clique[1] = v;
+        _branch_edge_subgraph(&subgraph, k - 2, 0, 2);
+    }
+
+    free(subgraph.vertices);
+    free(subgraph.colors);
+    free(subgraph.neighbors);
+    free(subgraph.out_neighbors);
+    free(subgraph.candidates);
+    free(subgraph.members);
+    free(subgraph.is_color_used);
+    free(edge_ranks);
+    free(current_clique);
+    truss_decomposition_delete(&decomposition);
+}
+
+// End Edge-Oriented Clique Functions
+// Begin Parallel Clique Functions
+
+/**
+ * @brief The shared state of the workers of
+ * enumerate_three_cliques_parallel.
+ *
+ * The vertices are handed out in chunks of CLIQUE_CHUNK_SIZE through
+ * the atomic counter idx_next_vertex, so a worker that draws a chunk
+ * of high degree vertices does not hold up the others.
+ */
+typedef struct _ThreeCliqueWorkers {
+    Graph* graph;
+    Graph* directed_graph;
+    atomic_int idx_next_vertex;
+    void (*record)(void*, vertex, vertex, vertex);
+} _ThreeCliqueWorkers;
+
+typedef struct _ThreeCliqueWorker {
+    _ThreeCliqueWorkers* shared;
+    void* collection;
+} _ThreeCliqueWorker;
+
+/**
+ * @brief The entry point of each worker thread. Claims chunks of
+ * vertices until every vertex has been claimed and reports the
+ * triangles of each claimed vertex to the worker's own collection.
+ *
+ * @param ptr_worker The _ThreeCliqueWorker of the thread.
+ * @return void* Always NULL.
+ */
+static void* _run_three_clique_worker(void* ptr_worker) {
+    _ThreeCliqueWorker* worker = ptr_worker;
+    _ThreeCliqueWorkers* shared = worker->shared;
+    int num_vertices = shared->graph->num_vertices;
+
+    vertex* buffer = malloc(_get_max_out_degree(shared->directed_graph) * sizeof(vertex));
+
+    while (true) {
+        int idx_begin = atomic_fetch_add(&shared->idx_next_vertex, CLIQUE_CHUNK_SIZE);
+
+        if (idx_begin >= num_vertices) {
+            break;
+        }
+
+        int idx_end = min(idx_begin + CLIQUE_CHUNK_SIZE, num_vertices);
+
+        for (vertex v = idx_begin; v < idx_end; v++) {
+            _enumerate_three_cliques_from(shared->directed_graph, v, buffer, worker->collection, shared->record);
+        }
+    }
+
+    free(buffer);
+
+    return NULL;
+}
+
+/**
+ * @brief Returns the number of worker threads to use when the caller
+ * does not specify one, which is the number of online processors.
+ *
+ * @return int The default number of threads.
+ */
+int get_default_num_threads() {
+    long num_processors = sysconf(_SC_NPROCESSORS_ONLN);
+    return num_processors > 0 ? (int)num_processors : 1;
+}
+
+/**
+ * @brief The multithreaded variant of enumerate_three_cliques.
+ *
+ * The oriented graph is built once and shared read-only by
+ * every thread. Each thread claims chunks of vertices from an atomic
+ * counter and reports triangles to its own collection, so no locking
+ * is needed while enumerating. Once every thread has joined, the
+ * collections are reduced into collections[0] with param reduce.
+ *
+ * @param graph The undirected graph to search.
+ * @param orientation The order used to direct the edges.
+ * @param num_threads The number of threads to use. One collection
+ * must be provided per thread.
+ * @param collections The per-thread collections passed to record.
+ * @param record The function called for every triangle.
+ * @param reduce The function merging the second collection into the
+ * first. May be NULL if the caller reduces the collections itself.
+ */
+void enumerate_three_cliques_parallel(Graph* graph, CliqueOrientation orientation, int num_threads, void** collections, void (*record)(void*, vertex, vertex, vertex), void (*reduce)(void*, void*)) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+    assert(num_threads > 0);
+    assert(collections != NULL);
+
+    Graph* directed_graph = get_oriented_graph(graph, orientation);
+
+    _ThreeCliqueWorkers shared;
+    shared.graph = graph;
+    shared.directed_graph = directed_graph;
+    shared.record = record;
+    atomic_init(&shared.idx_next_vertex, 0);
+
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+    _ThreeCliqueWorker* workers = malloc(num_threads * sizeof(_ThreeCliqueWorker));
+
+    for (int i = 0; i < num_threads; i++) {
+        workers[i].shared = &shared;
+        workers[i].collection = collections[i];
+        int status = pthread_create(&threads[i], NULL, _run_three_clique_worker, &workers[i]);
+        assert(status == 0);
+        (void)status;
+    }
+
+    for (int i = 0; i < num_threads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    if (reduce != NULL) {
+        for (int i = 1; i < num_threads; i++) {
+            reduce(collections[0], collections[i]);
+        }
+    }
+
+    free(threads);
+    free(workers);
+    graph_delete(&directed_graph);
+}
+
+// End Parallel Clique Functions
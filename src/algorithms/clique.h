@@ -1,17 +1,76 @@
 #ifndef CLIQUE_H_INCLUDED
 #define CLIQUE_H_INCLUDED
 
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
 #include "../collections/clique_set.h"
+#include "../collections/clique_sink.h"
 #include "../collections/generic_linked_list.h"
 #include "../collections/graph.h"
 #include "../collections/ordered_set.h"
 #include "../utilities/array_util.h"
 #include "../utilities/math.h"
+#include "../utilities/set_intersection.h"
 #include "../utilities/stopwatch.h"
 #include "core.h"
+#include "truss.h"
+
+// The number of vertices claimed at once by each worker thread.
+#define CLIQUE_CHUNK_SIZE 64
+
+// The largest k listed by an unrolled kernel instead of the recursive
+// search of enumerate_k_cliques_callback.
+#define CLIQUE_MAX_UNROLLED_K 10
+
+// The total order used to direct each edge before listing cliques.
+// Every clique is found once from its lowest ranked vertex, so the
+// work per vertex depends on its out-degree under the order.
+typedef enum CliqueOrientation {
+    // Lower to higher degree, ties broken by id.
+    ORIENTATION_DEGREE,
+    // Lower to higher id.
+    ORIENTATION_VERTEX_ID,
+    // Earlier to later in the degeneracy ordering of the core
+    // decomposition. Every out-degree is at most the degeneracy.
+    ORIENTATION_DEGENERACY,
+} CliqueOrientation;
+
+// The algorithm used to list k-cliques.
+typedef enum CliqueEngine {
+    // Vertex-oriented branching on the oriented graph.
+    ENGINE_CHIBA_NISHIZEKI,
+    // Edge-oriented branching on the truss ordering with color
+    // pruning, which is faster for large k on dense graphs.
+    ENGINE_EBBKC,
+} CliqueEngine;
+
+// Orientation Functions
+Graph* get_oriented_graph(Graph* graph, CliqueOrientation orientation);
+
+// Enumeration Functions
+CliqueSet* enumerate_k_cliques(Graph* graph, int k, CliqueEngine engine, CliqueOrientation orientation);
+void enumerate_k_cliques_callback(Graph* graph, int k, CliqueOrientation orientation, void* collection, void (*record)(void*, clique, int));
+void enumerate_three_cliques(Graph* graph, CliqueOrientation orientation, void* collection, void (*record)(void*, vertex, vertex, vertex));
+void enumerate_four_cliques(Graph* graph, CliqueOrientation orientation, void* collection, void (*record)(void*, vertex, vertex, vertex, vertex));
+
+// Batched Enumeration Functions
+void enumerate_three_cliques_batched(Graph* graph, CliqueOrientation orientation, CliqueSink* sink);
+void enumerate_four_cliques_batched(Graph* graph, CliqueOrientation orientation, CliqueSink* three_sink, CliqueSink* four_sink);
+
+// Counting Functions
+long count_three_cliques(Graph* graph, CliqueOrientation orientation);
+long count_four_cliques(Graph* graph, CliqueOrientation orientation);
+long count_k_cliques(Graph* graph, int k, CliqueOrientation orientation);
+long* count_k_cliques_per_vertex(Graph* graph, int k, CliqueOrientation orientation);
+long* count_k_cliques_per_edge(Graph* graph, int k, CliqueOrientation orientation, int* edge_ids);
+
+// Edge-Oriented Enumeration Functions
+void enumerate_k_cliques_ebbkc(Graph* graph, int k, void* collection, void (*record)(void*, clique, int));
 
-CliqueSet* enumerate_k_cliques(Graph* graph, int k);
-void enumerate_three_cliques(Graph* graph, void* collection, void (*record)(void*, vertex, vertex, vertex));
-void enumerate_four_cliques(Graph* graph, void* collection, void (*record)(void*, vertex, vertex, vertex, vertex));
+// Parallel Enumeration Functions
+int get_default_num_threads();
+void enumerate_three_cliques_parallel(Graph* graph, CliqueOrientation orientation, int num_threads, void** collections, void (*record)(void*, vertex, vertex, vertex), void (*reduce)(void*, void*));
 
 #endif
\ No newline at end of file
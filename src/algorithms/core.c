@@ -1,11 +1,19 @@
 #include "core.h"
 
 /**
- * This class contains the partial implementation of the k-core
- * algorithm. The k-core algorithm finds the k-core of a graph, which
- * is the subgraph of the graph where each vertex has degree at least
- * k. The provided function returns a boolean array where each index
- * is true if the vertex is not in the k-core or false otherwise.
+ * This class contains the implementation of the k-core
+ * decomposition. The k-core of a graph is the subgraph of the graph
+ * where each vertex has degree at least k, and the core number of a
+ * vertex is the largest k such that the vertex is in the k-core.
+ *
+ * The core number of every vertex is computed in a single O(n + m)
+ * peel in the style of Batagelj and Zaversnik, with the vertices kept
+ * in a BucketStructure keyed by their remaining degree. The bucket
+ * structure is compacted as vertices are moved, so it holds O(n)
+ * entries rather than one per decrement. The order in
+ * which vertices are peeled is a degeneracy ordering of the graph:
+ * every vertex has at most degeneracy neighbors later in the
+ * ordering.
  *
  * It is often unnecessary to generate a new csr graph for the k-core
  * algorithm as knowing which vertices are in the k-core is sufficient
@@ -13,41 +21,395 @@
  * vertices not in the k-core of a graph.
  */
 
+// Begin Create and Delete Functions
+
 /**
- * @brief Sets the degree of a vertex to zero and queues it for
- * removal.
+ * @brief Computes the core number of every vertex and a degeneracy
+ * ordering of the param graph.
+ *
+ * The vertices are extracted from a bucket structure keyed by degree
+ * one bucket at a time. Extracting a vertex fixes its core number to
+ * its current degree and decrements every neighbor with a larger
+ * degree, which lazily moves the neighbor down one bucket in O(1).
  *
- * Once the vertex is queued for removal, it will be removed from the
- * graph and it's neighbors will be checked to see if they should be
- * removed based on their updateddegree.
+ * @param graph The undirected graph to decompose.
+ * @return CoreDecomposition* The core number of each vertex, the
+ * degeneracy of the graph, and the order the vertices were peeled.
+ */
+CoreDecomposition* run_core_decomposition(Graph* graph) {
+    assert(graph != NULL);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+
+    int num_vertices = graph->num_vertices;
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+
+    int* degrees = graph_get_out_degrees(graph);
+    BucketStructure* buckets = bucket_structure_new(num_vertices, degrees, BUCKET_NUM_OPEN_DEFAULT);
+    vertex* ordering = malloc(max(num_vertices, 1) * sizeof(vertex));
+
+    // The keys of the bucket structure are the remaining degrees and
+    // become the core numbers once every vertex has been extracted.
+    int* keys = buckets->keys;
+    int num_ordered = 0;
+    int degeneracy = 0;
+    int* batch;
+    int degree;
+    int num_batch;
+
+    while ((num_batch = bucket_structure_next_batch(buckets, &batch, &degree)) > 0) {
+        degeneracy = max(degeneracy, degree);
+
+        for (int i = 0; i < num_batch; i++) {
+            vertex u = batch[i];
+            ordering[num_ordered++] = u;
+
+            for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+                vertex v = idx_cols[idx_nnz];
+
+                // Only vertices that have not been extracted have a
+                // degree larger than the degree of u.
+                if (keys[v] > degree) {
+                    bucket_structure_decrement(buckets, v);
+                }
+            }
+        }
+    }
+
+    memcpy(degrees, keys, num_vertices * sizeof(int));
+    bucket_structure_delete(&buckets);
+
+    CoreDecomposition* decomposition = malloc(sizeof(CoreDecomposition));
+    decomposition->num_vertices = num_vertices;
+    decomposition->degeneracy = degeneracy;
+    decomposition->core_numbers = degrees;
+    decomposition->ordering = ordering;
+
+    return decomposition;
+}
+
+/**
+ * @brief Deletes the param core decomposition and all associated
+ * memory. The pointer to the core decomposition is set to NULL.
+ *
+ * @param ptr_decomposition A pointer to the core decomposition.
+ */
+void core_decomposition_delete(CoreDecomposition** ptr_decomposition) {
+    assert(ptr_decomposition != NULL);
+    assert(*ptr_decomposition != NULL);
+
+    free((*ptr_decomposition)->core_numbers);
+    free((*ptr_decomposition)->ordering);
+    free(*ptr_decomposition);
+    *ptr_decomposition = NULL;
+}
+
+// End Create and Delete Functions
+// Begin Parallel Functions
+
+/**
+ * @brief The shared state of the workers of
+ * run_core_decomposition_parallel.
+ *
+ * Every thread keeps its own buffer of the vertices that reached the
+ * current level, and the buffers are copied side by side into
+ * ordering after each round. The vertices of a round are then handed
+ * out in chunks of CORE_CHUNK_SIZE through the atomic counter
+ * idx_next_vertex.
+ */
+typedef struct _CoreWorkers {
+    Graph* graph;
+    int num_threads;
+    atomic_int* degrees;
+    vertex* ordering;
+    atomic_int idx_next_vertex;
+    pthread_barrier_t barrier;
+
+    int* buffer_sizes;
+    int* min_degrees;
+} _CoreWorkers;
+
+typedef struct _CoreWorker {
+    _CoreWorkers* shared;
+    int idx_thread;
+    int degeneracy;
+
+    int buffer_capacity;
+    vertex* buffer;
+} _CoreWorker;
+
+/**
+ * @brief Appends the param vertex to the buffer of the param worker.
+ *
+ * @param worker The worker that found the vertex.
+ * @param v The vertex to append.
+ */
+static inline void _core_worker_push(_CoreWorker* worker, vertex v) {
+    int* ptr_size = &worker->shared->buffer_sizes[worker->idx_thread];
+
+    if (*ptr_size == worker->buffer_capacity) {
+        worker->buffer_capacity = max(2 * worker->buffer_capacity, 1);
+        worker->buffer = realloc(worker->buffer, worker->buffer_capacity * sizeof(vertex));
+        assert(worker->buffer != NULL);
+    }
+
+    worker->buffer[(*ptr_size)++] = v;
+}
+
+/**
+ * @brief Sums the buffer sizes of every thread, and the sizes of the
+ * threads before the param thread.
+ *
+ * @param shared The shared state of the workers.
+ * @param idx_thread The thread to find the offset of.
+ * @param ptr_offset Set to the number of buffered vertices of the
+ * threads before param idx_thread.
+ * @return int The number of buffered vertices of every thread.
+ */
+static int _sum_buffer_sizes(_CoreWorkers* shared, int idx_thread, int* ptr_offset) {
+    int total = 0;
+
+    for (int t = 0; t < shared->num_threads; t++) {
+        if (t == idx_thread) {
+            *ptr_offset = total;
+        }
+
+        total += shared->buffer_sizes[t];
+    }
+
+    return total;
+}
+
+/**
+ * @brief The entry point of each worker thread.
+ *
+ * Every thread runs the same sequence of levels and rounds, separated
+ * by barriers, and computes the same totals from the shared buffer
+ * sizes, so no thread has to lead. A level starts with each thread
+ * scanning its own range of vertices for the ones with degree equal
+ * to the level. If there are none, the level jumps to the smallest
+ * degree seen in the scan. Each round then copies the buffers into
+ * ordering and decrements the neighbors of the round's vertices with
+ * atomic_fetch_sub. The thread whose decrement brings a neighbor down
+ * to the level appends it to its buffer for the next round, and a
+ * decrement that went below the level is undone, so every vertex is
+ * found exactly once and no degree stays below the level.
+ *
+ * @param ptr_worker The _CoreWorker of the thread.
+ * @return void* Always NULL.
+ */
+static void* _run_core_worker(void* ptr_worker) {
+    _CoreWorker* worker = ptr_worker;
+    _CoreWorkers* shared = worker->shared;
+    int* ptr_rows = shared->graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = shared->graph->adjacency_matrix->idx_cols;
+    int num_vertices = shared->graph->num_vertices;
+    int idx_thread = worker->idx_thread;
+
+    vertex v_begin = (vertex)((long)num_vertices * idx_thread / shared->num_threads);
+    vertex v_end = (vertex)((long)num_vertices * (idx_thread + 1) / shared->num_threads);
+
+    int level = 0;
+    int num_ordered = 0;
+    int offset = 0;
+
+    while (num_ordered < num_vertices) {
+        // Vertices peeled at an earlier level have a degree below the
+        // level and every other vertex has a degree of at least it.
+        int min_degree = INT_MAX;
+        shared->buffer_sizes[idx_thread] = 0;
+
+        for (vertex v = v_begin; v < v_end; v++) {
+            int degree = atomic_load_explicit(&shared->degrees[v], memory_order_relaxed);
+
+            if (degree == level) {
+                _core_worker_push(worker, v);
+            } else if (degree > level) {
+                min_degree = min(min_degree, degree);
+            }
+        }
+
+        shared->min_degrees[idx_thread] = min_degree;
+        pthread_barrier_wait(&shared->barrier);
+
+        int num_round = _sum_buffer_sizes(shared, idx_thread, &offset);
+
+        if (num_round == 0) {
+            level = INT_MAX;
+
+            for (int t = 0; t < shared->num_threads; t++) {
+                level = min(level, shared->min_degrees[t]);
+            }
+
+            pthread_barrier_wait(&shared->barrier);
+            continue;
+        }
+
+        worker->degeneracy = level;
+
+        while (num_round > 0) {
+            // A worker that found nothing may not have a buffer yet.
+            if (shared->buffer_sizes[idx_thread] > 0) {
+                memcpy(&shared->ordering[num_ordered + offset], worker->buffer, shared->buffer_sizes[idx_thread] * sizeof(vertex));
+            }
+
+            if (idx_thread == 0) {
+                atomic_store(&shared->idx_next_vertex, num_ordered);
+            }
+
+            pthread_barrier_wait(&shared->barrier);
+
+            int idx_round_end = num_ordered + num_round;
+            num_ordered = idx_round_end;
+            shared->buffer_sizes[idx_thread] = 0;
+
+            while (true) {
+                int idx_begin = atomic_fetch_add(&shared->idx_next_vertex, CORE_CHUNK_SIZE);
+
+                if (idx_begin >= idx_round_end) {
+                    break;
+                }
+
+                int idx_end = min(idx_begin + CORE_CHUNK_SIZE, idx_round_end);
+
+                for (int i = idx_begin; i < idx_end; i++) {
+                    vertex u = shared->ordering[i];
+
+                    for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+                        vertex v = idx_cols[idx_nnz];
+
+                        if (atomic_load_explicit(&shared->degrees[v], memory_order_relaxed) <= level) {
+                            continue;
+                        }
+
+                        int degree = atomic_fetch_sub(&shared->degrees[v], 1);
+
+                        if (degree == level + 1) {
+                            _core_worker_push(worker, v);
+                        } else if (degree <= level) {
+                            atomic_fetch_add(&shared->degrees[v], 1);
+                        }
+                    }
+                }
+            }
+
+            pthread_barrier_wait(&shared->barrier);
+            num_round = _sum_buffer_sizes(shared, idx_thread, &offset);
+
+            // The next round starts writing the buffer sizes, and the
+            // scan of the next level clears them, only after every
+            // thread has read them.
+            if (num_round == 0) {
+                pthread_barrier_wait(&shared->barrier);
+            }
+        }
+
+        level++;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief The multithreaded variant of run_core_decomposition, in the
+ * style of the PKC algorithm of Kabir and Madduri.
  *
- * @param vertex_id
- * @param k
- * @param vertex_degrees
- * @param removed_vertices
- * @param queue
+ * The vertices are peeled one level at a time, and each level is
+ * peeled in rounds where the frontier of a round is the set of
+ * vertices whose degree reached the level during the previous round.
+ * The degrees are decremented with atomics and each thread appends
+ * the vertices it brought down to the level to its own buffer, so
+ * there is no lock and no shared queue. Levels with no vertex are
+ * skipped, so the scans cost O(n) per distinct core number.
  *
+ * A vertex of a round has at most level neighbors that were not
+ * peeled in an earlier round, so listing the rounds in order gives a
+ * degeneracy ordering. The core numbers are identical to the ones of
+ * run_core_decomposition, but the ordering in general differs.
  *
+ * @param graph The undirected graph to decompose.
+ * @param num_threads The number of threads to use.
+ * @return CoreDecomposition* The core number of each vertex, the
+ * degeneracy of the graph, and the order the vertices were peeled.
  */
-static inline void _remove_less_than_k(vertex u, int k, int* vertex_degrees, bool* removed_vertices, Queue* queue) {
-    assert(vertex_degrees != NULL);
-    if (vertex_degrees[u] >= k) {
-        return;
+CoreDecomposition* run_core_decomposition_parallel(Graph* graph, int num_threads) {
+    assert(graph != NULL);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+    assert(num_threads > 0);
+
+    int num_vertices = graph->num_vertices;
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+
+    _CoreWorkers shared;
+    shared.graph = graph;
+    shared.num_threads = num_threads;
+    shared.degrees = malloc(max(num_vertices, 1) * sizeof(atomic_int));
+    shared.ordering = malloc(max(num_vertices, 1) * sizeof(vertex));
+    shared.buffer_sizes = calloc(num_threads, sizeof(int));
+    shared.min_degrees = malloc(num_threads * sizeof(int));
+    atomic_init(&shared.idx_next_vertex, 0);
+    pthread_barrier_init(&shared.barrier, NULL, num_threads);
+
+    for (vertex u = 0; u < num_vertices; u++) {
+        atomic_init(&shared.degrees[u], ptr_rows[u + 1] - ptr_rows[u]);
     }
 
-    if (removed_vertices[u] == true) {
-        return;
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+    _CoreWorker* workers = malloc(num_threads * sizeof(_CoreWorker));
+
+    for (int i = 0; i < num_threads; i++) {
+        workers[i].shared = &shared;
+        workers[i].idx_thread = i;
+        workers[i].degeneracy = 0;
+        workers[i].buffer_capacity = 0;
+        workers[i].buffer = NULL;
+
+        int status = pthread_create(&threads[i], NULL, _run_core_worker, &workers[i]);
+        assert(status == 0);
+        (void)status;
+    }
+
+    for (int i = 0; i < num_threads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    CoreDecomposition* decomposition = malloc(sizeof(CoreDecomposition));
+    decomposition->num_vertices = num_vertices;
+    decomposition->degeneracy = workers[0].degeneracy;
+    decomposition->core_numbers = malloc(max(num_vertices, 1) * sizeof(int));
+    decomposition->ordering = shared.ordering;
+
+    for (vertex u = 0; u < num_vertices; u++) {
+        decomposition->core_numbers[u] = atomic_load(&shared.degrees[u]);
+    }
+
+    for (int i = 0; i < num_threads; i++) {
+        free(workers[i].buffer);
     }
 
-    vertex_degrees[u] = 0;
-    queue_enqueue(queue, u);
-    removed_vertices[u] = true;
+    pthread_barrier_destroy(&shared.barrier);
+    free(threads);
+    free(workers);
+    free(shared.degrees);
+    free(shared.buffer_sizes);
+    free(shared.min_degrees);
+
+    return decomposition;
 }
 
+// End Parallel Functions
+// Begin Query Functions
+
 /**
  * @brief Finds the vertices not present in the k-core of the param
  * graph and returns a boolean array.
  *
+ * A vertex is in the k-core if and only if its core number is at
+ * least k, so this function reads the answer off of the core
+ * decomposition.
+ *
  * @param graph The graph to find the k-core of.
  * @param k The min degree of any vertex in the k-core of param graph.
  * @return bool* A boolean array indexed by vertices in the graph
@@ -55,51 +417,33 @@ static inline void _remove_less_than_k(vertex u, int k, int* vertex_degrees, boo
  * false otherwise.
  */
 bool* get_vertices_not_in_k_core(Graph* graph, int k) {
-    // Record for each vertex if it has been removed.
-    bool* removed_vertices = calloc(graph->num_vertices, sizeof(bool));
+    return get_vertices_not_in_k_core_parallel(graph, k, 1);
+}
 
-    // Initial degree of each vertex.
-    int* vertex_degrees = graph_get_out_degrees(graph);
+/**
+ * @brief The multithreaded variant of get_vertices_not_in_k_core.
+ *
+ * @param graph The graph to find the k-core of.
+ * @param k The min degree of any vertex in the k-core of param graph.
+ * @param num_threads The number of threads to use. A single thread
+ * runs the serial core decomposition.
+ * @return bool* A boolean array indexed by vertices in the graph
+ * where each index is true if the vertex is not in the k-core or
+ * false otherwise.
+ */
+bool* get_vertices_not_in_k_core_parallel(Graph* graph, int k, int num_threads) {
+    CoreDecomposition* decomposition = num_threads > 1 ? run_core_decomposition_parallel(graph, num_threads) : run_core_decomposition(graph);
 
-    // Queue of vertices to be removed. Need to visit each neighbor.
-    Queue* queue = queue_new(graph->num_vertices);
+    // Record for each vertex if it has been removed.
+    bool* removed_vertices = calloc(graph->num_vertices, sizeof(bool));
 
-    // Enqueue all initial vertices with degree less than k.
     for (vertex u = 0; u < graph->num_vertices; u++) {
-        if (vertex_degrees[u] < k && removed_vertices[u] == false) {
-            queue_enqueue(queue, u);
-            vertex_degrees[u] = 0;
-            removed_vertices[u] = true;
-        }
-        _remove_less_than_k(u, k, vertex_degrees, removed_vertices, queue);
-    }
-
-    CompressedSparseRow* adjacency_matrix = graph->adjacency_matrix;
-    int* ptr_rows = adjacency_matrix->ptr_rows;
-    int* idx_cols = adjacency_matrix->idx_cols;
-
-    // Continuously remove vertices with degree less than k, adding
-    // their neighbors to the queue if the neighbor's degree becomes
-    // less than k after the removal.
-    while (queue->size > 0) {
-        vertex removed = queue_dequeue(queue);
-        int idx_begin_read = ptr_rows[removed];
-        int idx_end_read = ptr_rows[removed + 1];
-
-        for (int i = idx_begin_read; i < idx_end_read; i++) {
-            vertex neighbor = idx_cols[i];
-            vertex_degrees[neighbor]--;
-
-            if (vertex_degrees[neighbor] < k && removed_vertices[neighbor] == false) {
-                queue_enqueue(queue, neighbor);
-                vertex_degrees[neighbor] = 0;
-                removed_vertices[neighbor] = true;
-            }
-        }
+        removed_vertices[u] = decomposition->core_numbers[u] < k;
     }
 
-    free(vertex_degrees);
-    queue_delete(&queue);
+    core_decomposition_delete(&decomposition);
 
     return removed_vertices;
-}
\ No newline at end of file
+}
+
+// End Query Functions
@@ -1,11 +1,37 @@
 #ifndef CORE_H_INCLUDED
 #define CORE_H_INCLUDED
 
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "../collections/bucket_structure.h"
 #include "../collections/graph.h"
 #include "../collections/ordered_set.h"
 #include "../collections/queue.h"
 #include "../utilities/array_util.h"
 
+// The number of vertices of a round claimed at once by a thread of
+// run_core_decomposition_parallel.
+#define CORE_CHUNK_SIZE 256
+
+typedef struct CoreDecomposition {
+    int num_vertices;
+    int degeneracy;
+
+    int* core_numbers;
+    vertex* ordering;
+} CoreDecomposition;
+
+// Create and Delete Functions
+CoreDecomposition* run_core_decomposition(Graph* graph);
+void core_decomposition_delete(CoreDecomposition** ptr_decomposition);
+
+// Parallel Functions
+CoreDecomposition* run_core_decomposition_parallel(Graph* graph, int num_threads);
+
+// Query Functions
 bool* get_vertices_not_in_k_core(Graph* graph, int k);
+bool* get_vertices_not_in_k_core_parallel(Graph* graph, int k, int num_threads);
 
-#endif
\ No newline at end of file
+#endif
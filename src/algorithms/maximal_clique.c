@@ -0,0 +1,377 @@
+#include "maximal_clique.h"
+
+/**
+ * This class contains the Bron-Kerbosch enumeration of the maximal
+ * cliques of a graph, with the pivot of Tomita et al. and the outer
+ * degeneracy ordering of Eppstein, Loffler and Strash.
+ *
+ * Every vertex v is visited in the degeneracy ordering with the
+ * candidates P, its later neighbors, and the excluded vertices X, its
+ * earlier neighbors, so every maximal clique is reported once, from
+ * its earliest vertex, and P never holds more than degeneracy
+ * vertices. Below v, a pivot u maximizing |N(u) ∩ P| is chosen from
+ * P ∪ X and only the candidates not adjacent to u are branched on.
+ *
+ * P and X are sorted vertex arrays, the representation of
+ * OrderedSet, intersected with the sorted CSR rows. The sets of every
+ * depth live on one stack of vertices that is reused across vertices
+ * and only grows when a deeper path needs more room.
+ */
+
+/**
+ * @brief The state of _extend_maximal_clique for one thread.
+ *
+ * The sets are addressed by their offset in the stack, since growing
+ * the stack may move it.
+ */
+typedef struct _MaximalCliqueSearch {
+    int* ptr_rows;
+    int* idx_cols;
+
+    vertex* stack;
+    size_t capacity;
+
+    vertex* current_clique;
+    void* collection;
+    void (*record)(void*, clique, int);
+} _MaximalCliqueSearch;
+
+/**
+ * @brief Grows the stack to hold at least param capacity vertices.
+ */
+static void _reserve_stack(_MaximalCliqueSearch* search, size_t capacity) {
+    if (capacity <= search->capacity) {
+        return;
+    }
+
+    search->capacity = max(capacity, 2 * search->capacity);
+    search->stack = realloc(search->stack, search->capacity * sizeof(vertex));
+}
+
+/**
+ * @brief Reports every maximal clique extending the current clique
+ * with vertices of P, none of which is adjacent to every vertex of X.
+ *
+ * P and X are stored back to back from param offset, and the sets of
+ * the next depth are written after them. The vertices branched on are
+ * moved from P to X once their branch is done.
+ *
+ * @param search The search state.
+ * @param offset The offset of P in the stack, followed by X.
+ * @param num_candidates The size of P.
+ * @param num_excluded The size of X.
+ * @param depth The size of the current clique.
+ */
+static void _extend_maximal_clique(_MaximalCliqueSearch* search, size_t offset, int num_candidates, int num_excluded, int depth) {
+    if (num_candidates == 0) {
+        if (num_excluded == 0) {
+            search->record(search->collection, search->current_clique, depth);
+        }
+
+        return;
+    }
+
+    int* ptr_rows = search->ptr_rows;
+    int* idx_cols = search->idx_cols;
+
+    // The branch list and both sets of the next depth are no larger
+    // than the current sets.
+    size_t offset_branches = offset + num_candidates + num_excluded;
+    size_t offset_next = offset_branches + num_candidates;
+    _reserve_stack(search, offset_next + num_candidates + num_excluded);
+
+    vertex* candidates = &search->stack[offset];
+    vertex* excluded = &search->stack[offset + num_candidates];
+
+    // Choose the pivot from P ∪ X with the most neighbors in P.
+    vertex pivot = candidates[0];
+    int max_num_adjacent = -1;
+
+    for (int i = 0; i < num_candidates + num_excluded; i++) {
+        vertex u = i < num_candidates ? candidates[i] : excluded[i - num_candidates];
+        int num_adjacent = set_intersection_size(candidates, num_candidates, &idx_cols[ptr_rows[u]], ptr_rows[u + 1] - ptr_rows[u]);
+
+        if (num_adjacent > max_num_adjacent) {
+            max_num_adjacent = num_adjacent;
+            pivot = u;
+        }
+    }
+
+    // Only the candidates not adjacent to the pivot are branched on.
+    vertex* branches = &search->stack[offset_branches];
+    int num_branches = 0;
+    int idx_pivot_read = ptr_rows[pivot];
+
+    for (int i = 0; i < num_candidates; i++) {
+        vertex w = candidates[i];
+
+        while (idx_pivot_read < ptr_rows[pivot + 1] && idx_cols[idx_pivot_read] < w) {
+            idx_pivot_read++;
+        }
+
+        if (idx_pivot_read == ptr_rows[pivot + 1] || idx_cols[idx_pivot_read] != w) {
+            branches[num_branches++] = w;
+        }
+    }
+
+    for (int idx_branch = 0; idx_branch < num_branches; idx_branch++) {
+        candidates = &search->stack[offset];
+        excluded = &search->stack[offset + num_candidates];
+        vertex w = search->stack[offset_branches + idx_branch];
+
+        int* neighbors_w = &idx_cols[ptr_rows[w]];
+        int degree_w = ptr_rows[w + 1] - ptr_rows[w];
+
+        int num_next_candidates = set_intersection(candidates, num_candidates, neighbors_w, degree_w, &search->stack[offset_next]);
+        int num_next_excluded = set_intersection(excluded, num_excluded, neighbors_w, degree_w, &search->stack[offset_next + num_next_candidates]);
+
+        search->current_clique[depth] = w;
+        _extend_maximal_clique(search, offset_next, num_next_candidates, num_next_excluded, depth + 1);
+
+        // Move w from P to X, keeping both sorted. X directly follows
+        // P, so shifting the elements between them by one suffices.
+        candidates = &search->stack[offset];
+        int idx_w = 0;
+        while (candidates[idx_w] != w) {
+            idx_w++;
+        }
+
+        int idx_insert = num_candidates;
+        while (idx_insert < num_candidates + num_excluded && candidates[idx_insert] < w) {
+            idx_insert++;
+        }
+
+        memmove(&candidates[idx_w], &candidates[idx_w + 1], (idx_insert - idx_w - 1) * sizeof(vertex));
+        candidates[idx_insert - 1] = w;
+
+        num_candidates--;
+        num_excluded++;
+    }
+}
+
+/**
+ * @brief Reports every maximal clique whose earliest vertex in the
+ * degeneracy ordering is param v.
+ *
+ * @param search The search state.
+ * @param ranks The position of each vertex in the degeneracy
+ * ordering.
+ * @param v The vertex to start from.
+ */
+static void _enumerate_maximal_cliques_from(_MaximalCliqueSearch* search, int* ranks, vertex v) {
+    int* ptr_rows = search->ptr_rows;
+    int* idx_cols = search->idx_cols;
+    int degree = ptr_rows[v + 1] - ptr_rows[v];
+
+    _reserve_stack(search, degree);
+
+    // Split the sorted neighbors into the later ones, P, followed by
+    // the earlier ones, X, both still sorted.
+    int num_candidates = 0;
+    for (int idx_nnz = ptr_rows[v]; idx_nnz < ptr_rows[v + 1]; idx_nnz++) {
+        if (ranks[idx_cols[idx_nnz]] > ranks[v]) {
+            search->stack[num_candidates++] = idx_cols[idx_nnz];
+        }
+    }
+
+    int num_excluded = 0;
+    for (int idx_nnz = ptr_rows[v]; idx_nnz < ptr_rows[v + 1]; idx_nnz++) {
+        if (ranks[idx_cols[idx_nnz]] < ranks[v]) {
+            search->stack[num_candidates + num_excluded++] = idx_cols[idx_nnz];
+        }
+    }
+
+    search->current_clique[0] = v;
+    _extend_maximal_clique(search, 0, num_candidates, num_excluded, 1);
+}
+
+/**
+ * @brief Creates the search state of one thread. The stack starts
+ * with room for the largest degree and grows on demand.
+ */
+static _MaximalCliqueSearch _maximal_clique_search_new(Graph* graph, int degeneracy, void* collection, void (*record)(void*, clique, int)) {
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int max_degree = 1;
+
+    for (vertex v = 0; v < graph->num_vertices; v++) {
+        max_degree = max(max_degree, ptr_rows[v + 1] - ptr_rows[v]);
+    }
+
+    _MaximalCliqueSearch search = {
+        .ptr_rows = ptr_rows,
+        .idx_cols = graph->adjacency_matrix->idx_cols,
+        .stack = malloc(4 * (size_t)max_degree * sizeof(vertex)),
+        .capacity = 4 * (size_t)max_degree,
+        .current_clique = malloc((degeneracy + 1) * sizeof(vertex)),
+        .collection = collection,
+        .record = record,
+    };
+
+    return search;
+}
+
+// Begin Enumeration Functions
+
+/**
+ * @brief Reports every maximal clique of the graph to param record.
+ *
+ * The clique passed to record is a buffer owned by this function and
+ * is only valid during the call. Its first vertex is the earliest in
+ * the degeneracy ordering, and the others are not sorted.
+ *
+ * @param graph The undirected graph to search, whose rows must be
+ * sorted.
+ * @param collection The collection passed to param record.
+ * @param record The function called for every maximal clique with
+ * the collection, the clique, and its size.
+ */
+void enumerate_maximal_cliques(Graph* graph, void* collection, void (*record)(void*, clique, int)) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+
+    CoreDecomposition* decomposition = run_core_decomposition(graph);
+    int* ranks = malloc(max(graph->num_vertices, 1) * sizeof(int));
+
+    for (int i = 0; i < graph->num_vertices; i++) {
+        ranks[decomposition->ordering[i]] = i;
+    }
+
+    _MaximalCliqueSearch search = _maximal_clique_search_new(graph, decomposition->degeneracy, collection, record);
+
+    for (int i = 0; i < graph->num_vertices; i++) {
+        _enumerate_maximal_cliques_from(&search, ranks, decomposition->ordering[i]);
+    }
+
+    free(search.stack);
+    free(search.current_clique);
+    free(ranks);
+    core_decomposition_delete(&decomposition);
+}
+
+// End Enumeration Functions
+// Begin Parallel Enumeration Functions
+
+/**
+ * @brief The shared state of the workers of
+ * enumerate_maximal_cliques_parallel.
+ *
+ * The positions of the degeneracy ordering are handed out in chunks
+ * of CLIQUE_CHUNK_SIZE through the atomic counter idx_next_vertex.
+ */
+typedef struct _MaximalCliqueWorkers {
+    Graph* graph;
+    CoreDecomposition* decomposition;
+    int* ranks;
+    atomic_int idx_next_vertex;
+    void (*record)(void*, clique, int);
+} _MaximalCliqueWorkers;
+
+typedef struct _MaximalCliqueWorker {
+    _MaximalCliqueWorkers* shared;
+    void* collection;
+} _MaximalCliqueWorker;
+
+/**
+ * @brief The entry point of each worker thread. Claims chunks of the
+ * degeneracy ordering until every vertex has been claimed and reports
+ * the maximal cliques starting at each claimed vertex to the worker's
+ * own collection.
+ *
+ * @param ptr_worker The _MaximalCliqueWorker of the thread.
+ * @return void* Always NULL.
+ */
+static void* _run_maximal_clique_worker(void* ptr_worker) {
+    _MaximalCliqueWorker* worker = ptr_worker;
+    _MaximalCliqueWorkers* shared = worker->shared;
+    int num_vertices = shared->graph->num_vertices;
+
+    _MaximalCliqueSearch search = _maximal_clique_search_new(shared->graph, shared->decomposition->degeneracy, worker->collection, shared->record);
+
+    while (true) {
+        int idx_begin = atomic_fetch_add(&shared->idx_next_vertex, CLIQUE_CHUNK_SIZE);
+
+        if (idx_begin >= num_vertices) {
+            break;
+        }
+
+        int idx_end = min(idx_begin + CLIQUE_CHUNK_SIZE, num_vertices);
+
+        for (int i = idx_begin; i < idx_end; i++) {
+            _enumerate_maximal_cliques_from(&search, shared->ranks, shared->decomposition->ordering[i]);
+        }
+    }
+
+    free(search.stack);
+    free(search.current_clique);
+
+    return NULL;
+}
+
+/**
+ * @brief The multithreaded variant of enumerate_maximal_cliques.
+ *
+ * The degeneracy ordering is computed once and shared read-only by
+ * every thread. Each thread claims chunks of the top-level vertex
+ * loop from an atomic counter and reports maximal cliques to its own
+ * collection with its own stack, so no locking is needed while
+ * enumerating. Once every thread has joined, the collections are
+ * reduced into collections[0] with param reduce.
+ *
+ * @param graph The undirected graph to search.
+ * @param num_threads The number of threads to use. One collection
+ * must be provided per thread.
+ * @param collections The per-thread collections passed to record.
+ * @param record The function called for every maximal clique.
+ * @param reduce The function merging the second collection into the
+ * first. May be NULL if the caller reduces the collections itself.
+ */
+void enumerate_maximal_cliques_parallel(Graph* graph, int num_threads, void** collections, void (*record)(void*, clique, int), void (*reduce)(void*, void*)) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+    assert(num_threads > 0);
+    assert(collections != NULL);
+
+    _MaximalCliqueWorkers shared;
+    shared.graph = graph;
+    shared.decomposition = run_core_decomposition(graph);
+    shared.ranks = malloc(max(graph->num_vertices, 1) * sizeof(int));
+    shared.record = record;
+    atomic_init(&shared.idx_next_vertex, 0);
+
+    for (int i = 0; i < graph->num_vertices; i++) {
+        shared.ranks[shared.decomposition->ordering[i]] = i;
+    }
+
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+    _MaximalCliqueWorker* workers = malloc(num_threads * sizeof(_MaximalCliqueWorker));
+
+    for (int i = 0; i < num_threads; i++) {
+        workers[i].shared = &shared;
+        workers[i].collection = collections[i];
+
+        int status = pthread_create(&threads[i], NULL, _run_maximal_clique_worker, &workers[i]);
+        assert(status == 0);
+        (void)status;
+    }
+
+    for (int i = 0; i < num_threads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    if (reduce != NULL) {
+        for (int i = 1; i < num_threads; i++) {
+            reduce(collections[0], collections[i]);
+        }
+    }
+
+    free(threads);
+    free(workers);
+    free(shared.ranks);
+    core_decomposition_delete(&shared.decomposition);
+}
+
+// End Parallel Enumeration Functions
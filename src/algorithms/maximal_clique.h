@@ -0,0 +1,22 @@
+#ifndef MAXIMAL_CLIQUE_H_INCLUDED
+#define MAXIMAL_CLIQUE_H_INCLUDED
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "../collections/graph.h"
+#include "../utilities/math.h"
+#include "../utilities/set_intersection.h"
+#include "clique.h"
+#include "core.h"
+
+// Enumeration Functions
+void enumerate_maximal_cliques(Graph* graph, void* collection, void (*record)(void*, clique, int));
+
+// Parallel Enumeration Functions
+void enumerate_maximal_cliques_parallel(Graph* graph, int num_threads, void** collections, void (*record)(void*, clique, int), void (*reduce)(void*, void*));
+
+#endif
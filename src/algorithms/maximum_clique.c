@@ -0,0 +1,455 @@
+#include "maximum_clique.h"
+
+/**
+ * This class contains a branch and bound search for a maximum clique
+ * of a graph, with the greedy coloring bound of Tomita's MCQ/MCS.
+ *
+ * A greedy clique gives an initial lower bound b, then every vertex
+ * outside the b-core is discarded with get_vertices_not_in_k_core,
+ * since a clique larger than b lies in the b-core. Each remaining
+ * vertex v is then searched with the candidates P, its neighbors
+ * later in the degeneracy ordering, so P holds at most degeneracy
+ * vertices and fits in a small bitset adjacency matrix. The
+ * candidates of each branch are greedily colored, and since a clique
+ * has one vertex per color class, a branch whose clique size plus
+ * number of colors cannot beat the best clique is cut.
+ *
+ * The search is anytime: the best clique is updated as soon as it is
+ * found, and when the time limit is reached the search unwinds and
+ * returns it.
+ */
+
+/**
+ * @brief The state of _expand_maximum_clique for the subgraph of one
+ * vertex.
+ *
+ * The bitsets are rows of num_words words over the local ids, and the
+ * coloring orders of every depth are stored on one stack of ints
+ * addressed by offset, since growing it may move it.
+ */
+typedef struct _MaximumCliqueSearch {
+    int num_local_vertices;
+    int num_words;
+    vertex* local_vertices;
+    uint64_t* neighbors;
+
+    // One candidate bitset per depth, plus two scratch bitsets.
+    uint64_t* candidates;
+    uint64_t* uncolored;
+    uint64_t* color_class;
+
+    int* stack;
+    size_t capacity;
+
+    int* current_clique;
+    int best_size;
+    vertex* best_clique;
+
+    clock_t deadline;
+    bool has_deadline;
+    long num_branches;
+    bool is_timed_out;
+} _MaximumCliqueSearch;
+
+/**
+ * @brief Grows the coloring stack to hold at least param capacity
+ * ints.
+ */
+static void _reserve_coloring_stack(_MaximumCliqueSearch* search, size_t capacity) {
+    if (capacity <= search->capacity) {
+        return;
+    }
+
+    search->capacity = max(capacity, 2 * search->capacity);
+    search->stack = realloc(search->stack, search->capacity * sizeof(int));
+}
+
+/**
+ * @brief Greedily colors the candidates of param depth, writing the
+ * local ids in order of nondecreasing color and their colors after
+ * them on the stack.
+ *
+ * Each color class is built by repeatedly taking the lowest candidate
+ * not yet colored that is not adjacent to the class.
+ *
+ * @param search The search state.
+ * @param depth The depth whose candidates are colored.
+ * @param offset The offset of the order on the stack.
+ * @param num_candidates The number of candidates.
+ */
+static void _color_candidates(_MaximumCliqueSearch* search, int depth, size_t offset, int num_candidates) {
+    int num_words = search->num_words;
+    uint64_t* candidates = &search->candidates[(size_t)depth * num_words];
+    uint64_t* uncolored = search->uncolored;
+    uint64_t* color_class = search->color_class;
+
+    memcpy(uncolored, candidates, num_words * sizeof(uint64_t));
+
+    int num_colored = 0;
+    int color = 0;
+
+    while (num_colored < num_candidates) {
+        color++;
+        memcpy(color_class, uncolored, num_words * sizeof(uint64_t));
+
+        for (int idx_word = 0; idx_word < num_words; idx_word++) {
+            while (color_class[idx_word] != 0) {
+                int a = idx_word * 64 + __builtin_ctzll(color_class[idx_word]);
+                uint64_t* row = &search->neighbors[(size_t)a * num_words];
+
+                uncolored[idx_word] &= ~(1ULL << (a % 64));
+                color_class[idx_word] &= ~(1ULL << (a % 64));
+
+                // The later words only lose neighbors of a.
+                for (int idx_other_word = idx_word; idx_other_word < num_words; idx_other_word++) {
+                    color_class[idx_other_word] &= ~row[idx_other_word];
+                }
+
+                search->stack[offset + num_colored] = a;
+                search->stack[offset + num_candidates + num_colored] = color;
+                num_colored++;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Records the current clique of param size as the best clique.
+ */
+static void _update_best_clique(_MaximumCliqueSearch* search, int size) {
+    search->best_size = size;
+
+    for (int i = 0; i < size; i++) {
+        search->best_clique[i] = search->local_vertices[search->current_clique[i]];
+    }
+}
+
+/**
+ * @brief Searches the candidates of param depth for a clique which,
+ * added to the current clique of param size, beats the best clique.
+ *
+ * The candidates are branched on in order of decreasing color, and
+ * once size plus the color of a candidate is at most the best size,
+ * none of the remaining candidates can improve the best clique.
+ *
+ * @param search The search state.
+ * @param depth The depth whose candidates are searched.
+ * @param offset The first free offset of the coloring stack.
+ * @param size The size of the current clique.
+ */
+static void _expand_maximum_clique(_MaximumCliqueSearch* search, int depth, size_t offset, int size) {
+    if (search->has_deadline && ++search->num_branches % MAXIMUM_CLIQUE_TIME_CHECK_INTERVAL == 0 && clock() >= search->deadline) {
+        search->is_timed_out = true;
+    }
+
+    if (search->is_timed_out) {
+        return;
+    }
+
+    int num_words = search->num_words;
+    uint64_t* candidates = &search->candidates[(size_t)depth * num_words];
+    uint64_t* next_candidates = &candidates[num_words];
+
+    int num_candidates = 0;
+    for (int idx_word = 0; idx_word < num_words; idx_word++) {
+        num_candidates += __builtin_popcountll(candidates[idx_word]);
+    }
+
+    _reserve_coloring_stack(search, offset + 2 * (size_t)num_candidates);
+    _color_candidates(search, depth, offset, num_candidates);
+
+    for (int i = num_candidates - 1; i >= 0 && !search->is_timed_out; i--) {
+        int a = search->stack[offset + i];
+        int color = search->stack[offset + num_candidates + i];
+
+        if (size + color <= search->best_size) {
+            return;
+        }
+
+        uint64_t* row = &search->neighbors[(size_t)a * num_words];
+        bool is_empty = true;
+
+        for (int idx_word = 0; idx_word < num_words; idx_word++) {
+            next_candidates[idx_word] = candidates[idx_word] & row[idx_word];
+            is_empty = is_empty && next_candidates[idx_word] == 0;
+        }
+
+        search->current_clique[size] = a;
+
+        if (is_empty) {
+            if (size + 1 > search->best_size) {
+                _update_best_clique(search, size + 1);
+            }
+        } else {
+            _expand_maximum_clique(search, depth + 1, offset + 2 * (size_t)num_candidates, size + 1);
+        }
+
+        candidates[a / 64] &= ~(1ULL << (a % 64));
+    }
+}
+
+/**
+ * @brief Returns a clique of the graph found greedily, used as the
+ * initial lower bound.
+ *
+ * From every vertex, the later neighbor in the degeneracy ordering
+ * with the largest core number is added while the candidates allow
+ * it, which tends to stay inside the densest cores.
+ *
+ * @param graph The undirected graph.
+ * @param decomposition The core decomposition of the graph.
+ * @param ranks The position of each vertex in the degeneracy
+ * ordering.
+ * @param best_clique The buffer receiving the best greedy clique.
+ * @return int The size of the clique.
+ */
+static int _find_greedy_clique(Graph* graph, CoreDecomposition* decomposition, int* ranks, vertex* best_clique) {
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+    int* core_numbers = decomposition->core_numbers;
+
+    int max_degree = 1;
+    for (vertex v = 0; v < graph->num_vertices; v++) {
+        max_degree = max(max_degree, ptr_rows[v + 1] - ptr_rows[v]);
+    }
+
+    vertex* candidates = malloc(max_degree * sizeof(vertex));
+    vertex* next_candidates = malloc(max_degree * sizeof(vertex));
+    vertex* clique_buffer = malloc((decomposition->degeneracy + 1) * sizeof(vertex));
+    int best_size = 0;
+
+    for (vertex v = 0; v < graph->num_vertices; v++) {
+        // The clique from v has at most core number + 1 vertices.
+        if (core_numbers[v] + 1 <= best_size) {
+            continue;
+        }
+
+        int num_candidates = 0;
+        for (int idx_nnz = ptr_rows[v]; idx_nnz < ptr_rows[v + 1]; idx_nnz++) {
+            if (ranks[idx_cols[idx_nnz]] > ranks[v]) {
+                candidates[num_candidates++] = idx_cols[idx_nnz];
+            }
+        }
+
+        int size = 0;
+        clique_buffer[size++] = v;
+
+        while (num_candidates > 0) {
+            vertex u = candidates[0];
+            for (int i = 1; i < num_candidates; i++) {
+                if (core_numbers[candidates[i]] > core_numbers[u]) {
+                    u = candidates[i];
+                }
+            }
+
+            clique_buffer[size++] = u;
+            num_candidates = set_intersection(candidates, num_candidates, &idx_cols[ptr_rows[u]], ptr_rows[u + 1] - ptr_rows[u], next_candidates);
+
+            vertex* temp = candidates;
+            candidates = next_candidates;
+            next_candidates = temp;
+        }
+
+        if (size > best_size) {
+            best_size = size;
+            memcpy(best_clique, clique_buffer, size * sizeof(vertex));
+        }
+    }
+
+    free(candidates);
+    free(next_candidates);
+    free(clique_buffer);
+
+    return best_size;
+}
+
+/**
+ * @brief Builds the bitset adjacency of the candidates of param v,
+ * its later neighbors in the degeneracy ordering that are not
+ * removed.
+ *
+ * @return int The number of candidates.
+ */
+static int _build_candidate_subgraph(Graph* graph, int* ranks, bool* is_vertex_removed, vertex v, _MaximumCliqueSearch* search) {
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+
+    int num_local_vertices = 0;
+    for (int idx_nnz = ptr_rows[v]; idx_nnz < ptr_rows[v + 1]; idx_nnz++) {
+        vertex u = idx_cols[idx_nnz];
+
+        if (ranks[u] > ranks[v] && is_vertex_removed[u] == false) {
+            search->local_vertices[num_local_vertices++] = u;
+        }
+    }
+
+    int num_words = (num_local_vertices + 63) / 64;
+    search->num_local_vertices = num_local_vertices;
+    search->num_words = num_words;
+    memset(search->neighbors, 0, (size_t)num_local_vertices * num_words * sizeof(uint64_t));
+
+    // Merge the row of each local vertex with the sorted local
+    // vertices.
+    for (int a = 0; a < num_local_vertices; a++) {
+        vertex w = search->local_vertices[a];
+        uint64_t* row = &search->neighbors[(size_t)a * num_words];
+
+        int idx_w_read = ptr_rows[w];
+        int b = 0;
+
+        while (idx_w_read < ptr_rows[w + 1] && b < num_local_vertices) {
+            if (idx_cols[idx_w_read] < search->local_vertices[b]) {
+                idx_w_read++;
+            } else if (idx_cols[idx_w_read] > search->local_vertices[b]) {
+                b++;
+            } else {
+                row[b / 64] |= 1ULL << (b % 64);
+                idx_w_read++;
+                b++;
+            }
+        }
+    }
+
+    return num_local_vertices;
+}
+
+// Begin Create and Delete Functions
+
+/**
+ * @brief Finds a maximum clique of the param graph.
+ *
+ * The search of each vertex v only looks for cliques among its
+ * candidates that beat the best clique minus one, and v is prepended
+ * to the clique found.
+ *
+ * @param graph The undirected graph to search, whose rows must be
+ * sorted.
+ * @param time_limit The time limit of the search in seconds of
+ * processor time, or a value <= 0 for no limit.
+ * @return MaximumClique* The largest clique found, which is a maximum
+ * clique unless is_optimal is false.
+ */
+MaximumClique* find_maximum_clique(Graph* graph, double time_limit) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+
+    int num_vertices = graph->num_vertices;
+    CoreDecomposition* decomposition = run_core_decomposition(graph);
+    int max_size = decomposition->degeneracy + 1;
+
+    int* ranks = malloc(max(num_vertices, 1) * sizeof(int));
+    for (int i = 0; i < num_vertices; i++) {
+        ranks[decomposition->ordering[i]] = i;
+    }
+
+    MaximumClique* maximum_clique = malloc(sizeof(MaximumClique));
+    maximum_clique->vertices = malloc(max_size * sizeof(vertex));
+    maximum_clique->size = _find_greedy_clique(graph, decomposition, ranks, maximum_clique->vertices);
+    maximum_clique->is_optimal = true;
+
+    // A larger clique lies in the size-core of the graph.
+    bool* is_vertex_removed = get_vertices_not_in_k_core(graph, maximum_clique->size);
+
+    int max_num_local_vertices = max(decomposition->degeneracy, 1);
+    int max_num_words = (max_num_local_vertices + 63) / 64;
+
+    _MaximumCliqueSearch search = {
+        .local_vertices = malloc(max_num_local_vertices * sizeof(vertex)),
+        .neighbors = malloc((size_t)max_num_local_vertices * max_num_words * sizeof(uint64_t)),
+        .candidates = malloc((size_t)(max_num_local_vertices + 1) * max_num_words * sizeof(uint64_t)),
+        .uncolored = malloc(max_num_words * sizeof(uint64_t)),
+        .color_class = malloc(max_num_words * sizeof(uint64_t)),
+        .stack = malloc(2 * (size_t)max_num_local_vertices * sizeof(int)),
+        .capacity = 2 * (size_t)max_num_local_vertices,
+        .current_clique = malloc(max_size * sizeof(int)),
+        .best_clique = malloc(max_size * sizeof(vertex)),
+        .has_deadline = time_limit > 0,
+        .deadline = clock() + (clock_t)(time_limit * CLOCKS_PER_SEC),
+        .num_branches = 0,
+        .is_timed_out = false,
+    };
+
+    // Visit the densest cores first, so good cliques are found early.
+    for (int i = num_vertices - 1; i >= 0 && !search.is_timed_out; i--) {
+        vertex v = decomposition->ordering[i];
+
+        if (is_vertex_removed[v] || decomposition->core_numbers[v] + 1 <= maximum_clique->size) {
+            continue;
+        }
+
+        int num_local_vertices = _build_candidate_subgraph(graph, ranks, is_vertex_removed, v, &search);
+
+        // The clique needs maximum_clique->size more vertices.
+        if (num_local_vertices < maximum_clique->size) {
+            continue;
+        }
+
+        int num_words = search.num_words;
+        for (int idx_word = 0; idx_word < num_words; idx_word++) {
+            search.candidates[idx_word] = ~0ULL;
+        }
+
+        if (num_local_vertices % 64 != 0) {
+            search.candidates[num_words - 1] = (1ULL << (num_local_vertices % 64)) - 1;
+        }
+
+        // The search looks for a clique of more than size - 1
+        // candidates, which forms a larger clique with v.
+        search.best_size = maximum_clique->size - 1;
+        _expand_maximum_clique(&search, 0, 0, 0);
+
+        if (search.best_size + 1 > maximum_clique->size) {
+            maximum_clique->size = search.best_size + 1;
+            maximum_clique->vertices[0] = v;
+            memcpy(&maximum_clique->vertices[1], search.best_clique, search.best_size * sizeof(vertex));
+        }
+    }
+
+    maximum_clique->is_optimal = !search.is_timed_out;
+
+    // Sort the vertices of the clique, which is small.
+    for (int i = 1; i < maximum_clique->size; i++) {
+        vertex val = maximum_clique->vertices[i];
+        int j = i - 1;
+
+        while (j >= 0 && maximum_clique->vertices[j] > val) {
+            maximum_clique->vertices[j + 1] = maximum_clique->vertices[j];
+            j--;
+        }
+
+        maximum_clique->vertices[j + 1] = val;
+    }
+
+    free(search.local_vertices);
+    free(search.neighbors);
+    free(search.candidates);
+    free(search.uncolored);
+    free(search.color_class);
+    free(search.stack);
+    free(search.current_clique);
+    free(search.best_clique);
+    free(is_vertex_removed);
+    free(ranks);
+    core_decomposition_delete(&decomposition);
+
+    return maximum_clique;
+}
+
+/**
+ * @brief Deletes the param maximum clique and all associated memory.
+ * The pointer to the maximum clique is set to NULL.
+ *
+ * @param ptr_maximum_clique A pointer to the maximum clique.
+ */
+void maximum_clique_delete(MaximumClique** ptr_maximum_clique) {
+    assert(ptr_maximum_clique != NULL);
+    assert(*ptr_maximum_clique != NULL);
+
+    free((*ptr_maximum_clique)->vertices);
+    free(*ptr_maximum_clique);
+    *ptr_maximum_clique = NULL;
+}
+
+// End Create and Delete Functions
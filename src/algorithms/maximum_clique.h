@@ -0,0 +1,32 @@
+#ifndef MAXIMUM_CLIQUE_H_INCLUDED
+#define MAXIMUM_CLIQUE_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../collections/graph.h"
+#include "../utilities/math.h"
+#include "../utilities/set_intersection.h"
+#include "core.h"
+
+// The number of branches between two checks of the time limit.
+#define MAXIMUM_CLIQUE_TIME_CHECK_INTERVAL 1024
+
+typedef struct MaximumClique {
+    int size;
+    // The vertices of the clique in increasing order.
+    vertex* vertices;
+    // False if the time limit stopped the search, in which case the
+    // clique is the largest one found so far.
+    bool is_optimal;
+} MaximumClique;
+
+// Create and Delete Functions
+MaximumClique* find_maximum_clique(Graph* graph, double time_limit);
+void maximum_clique_delete(MaximumClique** ptr_maximum_clique);
+
+#endif
@@ -1,6 +1,775 @@
 #include "nucleus_decomposition.h"
 
-void run_nucleus_decomposition(Graph* graph, int r, int s) {
-    printf("Running Nucleus Decomposition with r = %d and s = %d.\n", r, s);
-    graph_print(graph, true);
+/**
+ * This class contains the peeling implementation of the (r,s)
+ * nucleus decomposition. Every r-clique is assigned an s-degree,
+ * the number of s-cliques that contain it. The r-clique with the
+ * smallest s-degree is repeatedly removed and its s-degree recorded
+ * as its nucleus number. Removing an r-clique destroys every
+ * s-clique containing it, so the s-degree of every other r-clique in
+ * those s-cliques is decremented. The (1,2) nucleus decomposition is
+ * the k-core decomposition and the (2,3) nucleus decomposition is
+ * the k-truss decomposition.
+ *
+ * The r-cliques and s-cliques are enumerated with the specialized
+ * clique functions in clique.h and the smallest s-degree is found
+ * with a BucketStructure, so each decrement is O(1).
+ *
+ * run_nucleus_decomposition_local instead computes the nucleus
+ * numbers with the local h-index iteration of Sariyuce, Seshadhri
+ * and Pinar, which needs no global order and can be stopped early.
+ */
+
+// Begin Helper Functions
+
+/**
+ * @brief Computes the binomial coefficient (n choose k).
+ *
+ * @param n
+ * @param k
+ * @return int
+ */
+static inline int _choose(int n, int k) {
+    assert(n >= 0 && k >= 0 && k <= n);
+
+    int result = 1;
+    for (int i = 1; i <= k; i++) {
+        result = result * (n - k + i) / i;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Enumerates every k-clique in the graph into a sorted clique
+ * set.
+ *
+ * The 1-cliques and 2-cliques are read directly from the CSR. The
+ * 3-cliques and 4-cliques are found with the batched enumeration
+ * functions, which insert them into the set through a store sink one
+ * batch at a time. Otherwise, enumerate_k_cliques is used.
+ *
+ * @param graph The undirected graph to search.
+ * @param k The size of the cliques to find.
+ * @return CliqueSet* The set of all k-cliques in the graph.
+ */
+static CliqueSet* _enumerate_cliques(Graph* graph, int k) {
+    assert(graph != NULL);
+    assert(k > 0);
+
+    if (k > 4) {
+        return enumerate_k_cliques(graph, k, ENGINE_CHIBA_NISHIZEKI, ORIENTATION_DEGENERACY);
+    }
+
+    int initial_capacity = max(graph->num_vertices, 1);
+    CliqueSet* cliques = clique_set_new(k, initial_capacity);
+
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+
+    if (k == 1) {
+        for (vertex u = 0; u < graph->num_vertices; u++) {
+            vertex one_clique[1] = {u};
+            clique_set_insert(cliques, one_clique);
+        }
+    } else if (k == 2) {
+        // The rows of the CSR are sorted, so the edges (u, v) with
+        // u < v are inserted in order and the set stays sorted.
+        for (vertex u = 0; u < graph->num_vertices; u++) {
+            for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+                vertex v = idx_cols[idx_nnz];
+
+                if (v <= u) {
+                    continue;
+                }
+
+                vertex two_clique[2] = {u, v};
+                clique_set_insert(cliques, two_clique);
+            }
+        }
+    } else {
+        CliqueSink* sink = clique_sink_new_store(cliques);
+
+        if (k == 3) {
+            enumerate_three_cliques_batched(graph, ORIENTATION_DEGENERACY, sink);
+        } else {
+            enumerate_four_cliques_batched(graph, ORIENTATION_DEGENERACY, NULL, sink);
+        }
+
+        clique_sink_delete(&sink);
+    }
+
+    // The cliques are numbered in lexicographic order.
+    clique_set_finalize(cliques);
+
+    return cliques;
+}
+
+/**
+ * @brief Writes the index of every r-clique contained in the param
+ * s-clique into param ids.
+ *
+ * Each r-subset of the sorted s-clique is generated in
+ * lexicographic order, so every generated r-clique is also sorted
+ * and can be found in the r-clique set with clique_set_find.
+ *
+ * @param r_cliques The sorted set of r-cliques.
+ * @param s_clique The sorted s-clique.
+ * @param s The size of the s-clique.
+ * @param ids The output array of (s choose r) r-clique indices.
+ */
+static void _find_sub_clique_ids(CliqueSet* r_cliques, clique s_clique, int s, int* ids) {
+    int r = r_cliques->k;
+
+    int* idx_subset = malloc(r * sizeof(int));
+    clique sub_clique = malloc(r * sizeof(vertex));
+
+    for (int i = 0; i < r; i++) {
+        idx_subset[i] = i;
+    }
+
+    int num_ids = 0;
+
+    while (true) {
+        for (int i = 0; i < r; i++) {
+            sub_clique[i] = s_clique[idx_subset[i]];
+        }
+
+        int idx_r_clique = clique_set_find(r_cliques, sub_clique);
+        assert(idx_r_clique >= 0);
+        ids[num_ids++] = idx_r_clique;
+
+        // Advance to the next r-subset of the s-clique.
+        int i = r - 1;
+        while (i >= 0 && idx_subset[i] == s - r + i) {
+            i--;
+        }
+
+        if (i < 0) {
+            break;
+        }
+
+        idx_subset[i]++;
+        for (int j = i + 1; j < r; j++) {
+            idx_subset[j] = idx_subset[j - 1] + 1;
+        }
+    }
+
+    free(idx_subset);
+    free(sub_clique);
+}
+
+/**
+ * @brief Peels the r-cliques in increasing order of s-degree and
+ * writes the nucleus number of each r-clique.
+ *
+ * The r-cliques are extracted from a bucket structure keyed by
+ * s-degree one bucket at a time. Extracting an r-clique removes every
+ * s-clique containing it that still exists, and decrements the other
+ * r-cliques of those s-cliques that have a larger s-degree.
+ *
+ * @param num_r_cliques The number of r-cliques.
+ * @param num_sub_cliques The number of r-cliques in each s-clique.
+ * @param degrees The s-degree of each r-clique.
+ * @param ptr_incidence CSR row pointers from each r-clique to the
+ * s-cliques containing it.
+ * @param idx_incidence CSR columns of the s-cliques containing each
+ * r-clique.
+ * @param sub_clique_ids The r-cliques contained in each s-clique.
+ * @param nucleus_numbers The output nucleus number of each r-clique.
+ * @param num_s_cliques The number of s-cliques.
+ */
+static void _peel(int num_r_cliques, int num_sub_cliques, int* degrees, int* ptr_incidence, int* idx_incidence, int* sub_clique_ids, int* nucleus_numbers, int num_s_cliques) {
+    BucketStructure* buckets = bucket_structure_new(num_r_cliques, degrees, BUCKET_NUM_OPEN_DEFAULT);
+    bool* is_s_clique_removed = calloc(max(num_s_cliques, 1), sizeof(bool));
+
+    int* keys = buckets->keys;
+    int* batch;
+    int degree;
+    int num_batch;
+
+    while ((num_batch = bucket_structure_next_batch(buckets, &batch, &degree)) > 0) {
+        for (int i = 0; i < num_batch; i++) {
+            int idx_r_clique = batch[i];
+            nucleus_numbers[idx_r_clique] = degree;
+
+            for (int idx_nnz = ptr_incidence[idx_r_clique]; idx_nnz < ptr_incidence[idx_r_clique + 1]; idx_nnz++) {
+                int idx_s_clique = idx_incidence[idx_nnz];
+
+                if (is_s_clique_removed[idx_s_clique]) {
+                    continue;
+                }
+
+                is_s_clique_removed[idx_s_clique] = true;
+
+                int* sub_ids = &sub_clique_ids[idx_s_clique * num_sub_cliques];
+                for (int j = 0; j < num_sub_cliques; j++) {
+                    // Only r-cliques that have not been extracted have
+                    // a degree larger than the current degree.
+                    if (keys[sub_ids[j]] > degree) {
+                        bucket_structure_decrement(buckets, sub_ids[j]);
+                    }
+                }
+            }
+        }
+    }
+
+    bucket_structure_delete(&buckets);
+    free(is_s_clique_removed);
+}
+
+/**
+ * @brief The r-cliques of a graph and their incidence with the
+ * s-cliques of the graph, shared by the peeling and local
+ * decompositions.
+ */
+typedef struct _NucleusIncidence {
+    int num_r_cliques;
+    int num_s_cliques;
+    int num_sub_cliques;
+    int max_degree;
+
+    CliqueSet* r_cliques;
+
+    // The s-degree of each r-clique.
+    int* degrees;
+
+    // CSR from each r-clique to the s-cliques containing it.
+    int* ptr_incidence;
+    int* idx_incidence;
+
+    // The num_sub_cliques r-cliques of each s-clique.
+    int* sub_clique_ids;
+} _NucleusIncidence;
+
+/**
+ * @brief Enumerates the r-cliques and s-cliques of the param graph
+ * and builds their incidence.
+ *
+ * Every s-clique is mapped to the (s choose r) r-cliques it
+ * contains. The mapping is inverted into a CSR from each r-clique to
+ * the s-cliques that contain it, whose row lengths are the initial
+ * s-degrees. The s-cliques themselves are not kept.
+ *
+ * @param graph The undirected graph to decompose.
+ * @param r The size of the cliques being assigned nucleus numbers.
+ * @param s The size of the cliques used to measure density.
+ * @return _NucleusIncidence The incidence, freed with
+ * _nucleus_incidence_free except for the r-cliques.
+ */
+static _NucleusIncidence _build_incidence(Graph* graph, int r, int s) {
+    _NucleusIncidence incidence;
+    incidence.r_cliques = _enumerate_cliques(graph, r);
+    CliqueSet* s_cliques = _enumerate_cliques(graph, s);
+
+    int num_r_cliques = incidence.r_cliques->size;
+    int num_s_cliques = s_cliques->size;
+    int num_sub_cliques = _choose(s, r);
+
+    incidence.num_r_cliques = num_r_cliques;
+    incidence.num_s_cliques = num_s_cliques;
+    incidence.num_sub_cliques = num_sub_cliques;
+
+    // Map each s-clique to the r-cliques it contains.
+    int* sub_clique_ids = malloc(max(num_s_cliques * num_sub_cliques, 1) * sizeof(int));
+    for (int i = 0; i < num_s_cliques; i++) {
+        _find_sub_clique_ids(incidence.r_cliques, clique_set_get(s_cliques, i), s, &sub_clique_ids[i * num_sub_cliques]);
+    }
+
+    clique_set_delete(&s_cliques);
+
+    // Invert the mapping into a CSR from each r-clique to the
+    // s-cliques containing it.
+    int* degrees = calloc(max(num_r_cliques, 1), sizeof(int));
+    for (int i = 0; i < num_s_cliques * num_sub_cliques; i++) {
+        degrees[sub_clique_ids[i]]++;
+    }
+
+    int* ptr_incidence = calloc(num_r_cliques + 1, sizeof(int));
+    incidence.max_degree = 0;
+
+    for (int i = 0; i < num_r_cliques; i++) {
+        ptr_incidence[i + 1] = ptr_incidence[i] + degrees[i];
+        incidence.max_degree = max(incidence.max_degree, degrees[i]);
+    }
+
+    int* idx_incidence = malloc(max(ptr_incidence[num_r_cliques], 1) * sizeof(int));
+    int* idx_insert = malloc(max(num_r_cliques, 1) * sizeof(int));
+    memcpy(idx_insert, ptr_incidence, num_r_cliques * sizeof(int));
+
+    for (int i = 0; i < num_s_cliques; i++) {
+        for (int j = 0; j < num_sub_cliques; j++) {
+            int idx_r_clique = sub_clique_ids[i * num_sub_cliques + j];
+            idx_incidence[idx_insert[idx_r_clique]++] = i;
+        }
+    }
+
+    free(idx_insert);
+
+    incidence.degrees = degrees;
+    incidence.ptr_incidence = ptr_incidence;
+    incidence.idx_incidence = idx_incidence;
+    incidence.sub_clique_ids = sub_clique_ids;
+
+    return incidence;
+}
+
+/**
+ * @brief Frees the arrays of the param incidence. The r-cliques are
+ * not freed, as they are handed to the decomposition.
+ *
+ * @param incidence The incidence to free.
+ */
+static void _nucleus_incidence_free(_NucleusIncidence* incidence) {
+    free(incidence->degrees);
+    free(incidence->ptr_incidence);
+    free(incidence->idx_incidence);
+    free(incidence->sub_clique_ids);
+}
+
+/**
+ * @brief Creates a decomposition holding the r-cliques of the param
+ * incidence with every nucleus number set to 0.
+ *
+ * @param incidence The incidence of the decomposition.
+ * @param r The size of the cliques being assigned nucleus numbers.
+ * @param s The size of the cliques used to measure density.
+ * @return NucleusDecomposition* The new decomposition.
+ */
+static NucleusDecomposition* _nucleus_decomposition_new(_NucleusIncidence* incidence, int r, int s) {
+    NucleusDecomposition* decomposition = malloc(sizeof(NucleusDecomposition));
+    decomposition->r = r;
+    decomposition->s = s;
+    decomposition->num_r_cliques = incidence->num_r_cliques;
+    decomposition->num_s_cliques = incidence->num_s_cliques;
+    decomposition->max_nucleus_number = 0;
+    decomposition->is_exact = true;
+    decomposition->r_cliques = incidence->r_cliques;
+    decomposition->nucleus_numbers = calloc(max(incidence->num_r_cliques, 1), sizeof(int));
+    decomposition->hierarchy = NULL;
+
+    return decomposition;
+}
+
+/**
+ * @brief Peels the r-cliques of the param graph and, if requested,
+ * builds the hierarchy of nuclei from the incidence before it is
+ * freed.
+ *
+ * @param graph The undirected graph to decompose.
+ * @param r The size of the cliques being assigned nucleus numbers.
+ * @param s The size of the cliques used to measure density, r < s.
+ * @param should_build_hierarchy True if the hierarchy should be
+ * built.
+ * @return NucleusDecomposition* The decomposition.
+ */
+static NucleusDecomposition* _run_peeling_decomposition(Graph* graph, int r, int s, bool should_build_hierarchy) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+    assert(r > 0);
+    assert(r < s);
+
+    _NucleusIncidence incidence = _build_incidence(graph, r, s);
+    NucleusDecomposition* decomposition = _nucleus_decomposition_new(&incidence, r, s);
+
+    _peel(incidence.num_r_cliques, incidence.num_sub_cliques, incidence.degrees, incidence.ptr_incidence, incidence.idx_incidence, incidence.sub_clique_ids, decomposition->nucleus_numbers, incidence.num_s_cliques);
+
+    for (int i = 0; i < incidence.num_r_cliques; i++) {
+        decomposition->max_nucleus_number = max(decomposition->max_nucleus_number, decomposition->nucleus_numbers[i]);
+    }
+
+    if (should_build_hierarchy) {
+        decomposition->hierarchy = nucleus_hierarchy_new(graph, decomposition->r_cliques, decomposition->nucleus_numbers, incidence.num_s_cliques, incidence.num_sub_cliques, incidence.sub_clique_ids);
+    }
+
+    _nucleus_incidence_free(&incidence);
+
+    return decomposition;
+}
+
+// End Helper Functions
+// Begin Create and Delete Functions
+
+/**
+ * @brief Runs the (r,s) nucleus decomposition on the param graph.
+ *
+ * The function enumerates the r-cliques and s-cliques of the graph
+ * and builds the incidence from each r-clique to the s-cliques that
+ * contain it. The r-cliques are then peeled in increasing order of
+ * s-degree.
+ *
+ * @param graph The undirected graph to decompose.
+ * @param r The size of the cliques being assigned nucleus numbers.
+ * @param s The size of the cliques used to measure density, r < s.
+ * @return NucleusDecomposition* The r-cliques of the graph and the
+ * nucleus number of each r-clique, where nucleus_numbers[i] is the
+ * nucleus number of r_cliques->cliques[i].
+ */
+NucleusDecomposition* run_nucleus_decomposition(Graph* graph, int r, int s) {
+    return _run_peeling_decomposition(graph, r, s, false);
+}
+
+/**
+ * @brief Runs the (r,s) nucleus decomposition on the param graph and
+ * builds the hierarchy of its nuclei right after the peel, while the
+ * incidence of the r-cliques and s-cliques is still available.
+ *
+ * @param graph The undirected graph to decompose.
+ * @param r The size of the cliques being assigned nucleus numbers.
+ * @param s The size of the cliques used to measure density, r < s.
+ * @return NucleusDecomposition* The decomposition, with the forest
+ * of nuclei in hierarchy.
+ */
+NucleusDecomposition* run_nucleus_decomposition_hierarchy(Graph* graph, int r, int s) {
+    return _run_peeling_decomposition(graph, r, s, true);
+}
+
+/**
+ * @brief Deletes the param nucleus decomposition and all associated
+ * memory. The pointer to the nucleus decomposition is set to NULL.
+ *
+ * @param ptr_decomposition A pointer to the nucleus decomposition.
+ */
+void nucleus_decomposition_delete(NucleusDecomposition** ptr_decomposition) {
+    assert(ptr_decomposition != NULL);
+    assert(*ptr_decomposition != NULL);
+
+    clique_set_delete(&(*ptr_decomposition)->r_cliques);
+    free((*ptr_decomposition)->nucleus_numbers);
+
+    if ((*ptr_decomposition)->hierarchy != NULL) {
+        nucleus_hierarchy_delete(&(*ptr_decomposition)->hierarchy);
+    }
+
+    free(*ptr_decomposition);
+    *ptr_decomposition = NULL;
+}
+
+// End Create and Delete Functions
+// Begin Local Functions
+
+/**
+ * @brief The shared state of the workers of one iteration of
+ * run_nucleus_decomposition_local.
+ *
+ * The r-cliques are handed out in chunks of CLIQUE_CHUNK_SIZE through
+ * the atomic counter idx_next_r_clique. A synchronous iteration reads
+ * the estimates of the previous iteration from read_estimates and
+ * writes write_estimates, while an asynchronous iteration reads and
+ * writes the same array and only visits the r-cliques flagged in
+ * is_active.
+ */
+typedef struct _LocalNucleusWorkers {
+    _NucleusIncidence* incidence;
+    LocalUpdateMode mode;
+    atomic_int idx_next_r_clique;
+
+    atomic_int* read_estimates;
+    atomic_int* write_estimates;
+    atomic_bool* is_active;
+} _LocalNucleusWorkers;
+
+typedef struct _LocalNucleusWorker {
+    _LocalNucleusWorkers* shared;
+
+    // Histogram of size max_degree + 1 for the h-index.
+    int* counts;
+
+    int num_updated;
+    long sum_decrease;
+} _LocalNucleusWorker;
+
+/**
+ * @brief Computes the h-index of the s-cliques containing the param
+ * r-clique, where the value of an s-clique is the smallest estimate
+ * of its other r-cliques.
+ *
+ * Values above the s-degree d cannot raise the h-index past d, so
+ * they are clamped to d and the h-index is read off a histogram of
+ * size d + 1 in O(d).
+ *
+ * @param worker The worker computing the h-index.
+ * @param idx_r_clique The r-clique to compute the h-index of.
+ * @return int The h-index.
+ */
+static int _compute_h_index(_LocalNucleusWorker* worker, int idx_r_clique) {
+    _NucleusIncidence* incidence = worker->shared->incidence;
+    atomic_int* estimates = worker->shared->read_estimates;
+    int num_sub_cliques = incidence->num_sub_cliques;
+    int idx_begin = incidence->ptr_incidence[idx_r_clique];
+    int degree = incidence->ptr_incidence[idx_r_clique + 1] - idx_begin;
+    int* counts = worker->counts;
+
+    memset(counts, 0, (degree + 1) * sizeof(int));
+
+    for (int idx_nnz = idx_begin; idx_nnz < idx_begin + degree; idx_nnz++) {
+        int* sub_ids = &incidence->sub_clique_ids[incidence->idx_incidence[idx_nnz] * num_sub_cliques];
+        int value = degree;
+
+        for (int j = 0; j < num_sub_cliques; j++) {
+            if (sub_ids[j] != idx_r_clique) {
+                value = min(value, atomic_load_explicit(&estimates[sub_ids[j]], memory_order_relaxed));
+            }
+        }
+
+        counts[value]++;
+    }
+
+    int num_at_least = 0;
+    int h_index = degree;
+
+    for (; h_index > 0; h_index--) {
+        num_at_least += counts[h_index];
+
+        if (num_at_least >= h_index) {
+            break;
+        }
+    }
+
+    return h_index;
+}
+
+/**
+ * @brief Flags every r-clique sharing an s-clique with the param
+ * r-clique so the next asynchronous visit recomputes it.
+ *
+ * @param shared The shared state of the workers.
+ * @param idx_r_clique The r-clique whose estimate changed.
+ */
+static void _activate_neighbors(_LocalNucleusWorkers* shared, int idx_r_clique) {
+    _NucleusIncidence* incidence = shared->incidence;
+    int num_sub_cliques = incidence->num_sub_cliques;
+
+    for (int idx_nnz = incidence->ptr_incidence[idx_r_clique]; idx_nnz < incidence->ptr_incidence[idx_r_clique + 1]; idx_nnz++) {
+        int* sub_ids = &incidence->sub_clique_ids[incidence->idx_incidence[idx_nnz] * num_sub_cliques];
+
+        for (int j = 0; j < num_sub_cliques; j++) {
+            if (sub_ids[j] != idx_r_clique) {
+                atomic_store_explicit(&shared->is_active[sub_ids[j]], true, memory_order_relaxed);
+            }
+        }
+    }
+}
+
+/**
+ * @brief The entry point of each worker thread. Claims chunks of the
+ * r-cliques and replaces the estimate of each claimed r-clique with
+ * its h-index.
+ *
+ * The estimates only ever decrease, so an asynchronous worker may
+ * read an estimate another thread is about to lower without breaking
+ * convergence; it only sees a looser upper bound for that visit.
+ *
+ * @param ptr_worker The _LocalNucleusWorker of the thread.
+ * @return void* Always NULL.
+ */
+static void* _run_local_nucleus_worker(void* ptr_worker) {
+    _LocalNucleusWorker* worker = ptr_worker;
+    _LocalNucleusWorkers* shared = worker->shared;
+    int num_r_cliques = shared->incidence->num_r_cliques;
+    bool is_asynchronous = shared->mode == LOCAL_UPDATE_ASYNCHRONOUS;
+
+    while (true) {
+        int idx_begin = atomic_fetch_add(&shared->idx_next_r_clique, CLIQUE_CHUNK_SIZE);
+
+        if (idx_begin >= num_r_cliques) {
+            break;
+        }
+
+        int idx_end = min(idx_begin + CLIQUE_CHUNK_SIZE, num_r_cliques);
+
+        for (int i = idx_begin; i < idx_end; i++) {
+            int estimate = atomic_load_explicit(&shared->read_estimates[i], memory_order_relaxed);
+
+            if (is_asynchronous && atomic_exchange_explicit(&shared->is_active[i], false, memory_order_relaxed) == false) {
+                continue;
+            }
+
+            int h_index = min(_compute_h_index(worker, i), estimate);
+            atomic_store_explicit(&shared->write_estimates[i], h_index, memory_order_relaxed);
+
+            if (h_index == estimate) {
+                continue;
+            }
+
+            worker->num_updated++;
+            worker->sum_decrease += estimate - h_index;
+
+            if (is_asynchronous) {
+                _activate_neighbors(shared, i);
+            }
+        }
+    }
+
+    return NULL;
 }
+
+/**
+ * @brief Computes the (r,s) nucleus numbers with the local h-index
+ * iteration (Sariyuce, Seshadhri and Pinar).
+ *
+ * Every r-clique starts with its s-degree as its estimate. In each
+ * iteration the estimate of every r-clique is replaced by the
+ * h-index of the s-cliques containing it, where the value of an
+ * s-clique is the smallest estimate of its other r-cliques. The
+ * estimates never increase, never drop below the nucleus numbers,
+ * and reach them once an iteration changes nothing.
+ *
+ * The synchronous mode (SND) computes every estimate from the
+ * estimates of the previous iteration. The asynchronous mode (AND)
+ * updates the estimates in place, so later r-cliques of an iteration
+ * already see the lowered estimates, and only revisits the r-cliques
+ * that share an s-clique with an r-clique whose estimate changed. AND
+ * usually needs far fewer iterations and visits than SND.
+ *
+ * Each iteration is split across threads in chunks of r-cliques.
+ * After each iteration, param on_iteration is given the number of
+ * estimates that changed, and returning false stops the iteration
+ * early. The decomposition then holds upper bounds on the nucleus
+ * numbers and is_exact is false.
+ *
+ * @param graph The undirected graph to decompose.
+ * @param r The size of the cliques being assigned nucleus numbers.
+ * @param s The size of the cliques used to measure density, r < s.
+ * @param mode Synchronous (SND) or asynchronous (AND) updates.
+ * @param num_threads The number of threads to use.
+ * @param max_iterations The maximum number of iterations, or a value
+ * <= 0 for no limit.
+ * @param context Passed to param on_iteration.
+ * @param on_iteration Called with the statistics of every iteration.
+ * May be NULL.
+ * @return NucleusDecomposition* The r-cliques of the graph and the
+ * estimated nucleus number of each r-clique.
+ */
+NucleusDecomposition* run_nucleus_decomposition_local(Graph* graph, int r, int s, LocalUpdateMode mode, int num_threads, int max_iterations, void* context, bool (*on_iteration)(void*, LocalIterationStats*)) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+    assert(r > 0);
+    assert(r < s);
+    assert(num_threads > 0);
+
+    _NucleusIncidence incidence = _build_incidence(graph, r, s);
+    NucleusDecomposition* decomposition = _nucleus_decomposition_new(&incidence, r, s);
+    int num_r_cliques = incidence.num_r_cliques;
+
+    _LocalNucleusWorkers shared;
+    shared.incidence = &incidence;
+    shared.mode = mode;
+    shared.read_estimates = malloc(max(num_r_cliques, 1) * sizeof(atomic_int));
+    shared.write_estimates = shared.read_estimates;
+    shared.is_active = NULL;
+
+    for (int i = 0; i < num_r_cliques; i++) {
+        atomic_init(&shared.read_estimates[i], incidence.degrees[i]);
+    }
+
+    if (mode == LOCAL_UPDATE_SYNCHRONOUS) {
+        shared.write_estimates = malloc(max(num_r_cliques, 1) * sizeof(atomic_int));
+    } else {
+        shared.is_active = malloc(max(num_r_cliques, 1) * sizeof(atomic_bool));
+
+        for (int i = 0; i < num_r_cliques; i++) {
+            atomic_init(&shared.is_active[i], true);
+        }
+    }
+
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+    _LocalNucleusWorker* workers = malloc(num_threads * sizeof(_LocalNucleusWorker));
+
+    for (int t = 0; t < num_threads; t++) {
+        workers[t].shared = &shared;
+        workers[t].counts = malloc((incidence.max_degree + 1) * sizeof(int));
+    }
+
+    Stopwatch* stopwatch = stopwatch_new();
+    LocalIterationStats stats = {0, 0, 0, 0.0};
+    bool is_converged = false;
+
+    while (is_converged == false && (max_iterations <= 0 || stats.iteration < max_iterations)) {
+        atomic_init(&shared.idx_next_r_clique, 0);
+
+        for (int t = 0; t < num_threads; t++) {
+            workers[t].num_updated = 0;
+            workers[t].sum_decrease = 0;
+
+            int status = pthread_create(&threads[t], NULL, _run_local_nucleus_worker, &workers[t]);
+            assert(status == 0);
+            (void)status;
+        }
+
+        stats.num_updated = 0;
+        stats.sum_decrease = 0;
+
+        for (int t = 0; t < num_threads; t++) {
+            pthread_join(threads[t], NULL);
+            stats.num_updated += workers[t].num_updated;
+            stats.sum_decrease += workers[t].sum_decrease;
+        }
+
+        if (mode == LOCAL_UPDATE_SYNCHRONOUS) {
+            atomic_int* swap = shared.read_estimates;
+            shared.read_estimates = shared.write_estimates;
+            shared.write_estimates = swap;
+        }
+
+        stats.iteration++;
+        stats.seconds = stopwatch_lap(stopwatch);
+        is_converged = stats.num_updated == 0;
+
+        if (on_iteration != NULL && on_iteration(context, &stats) == false) {
+            break;
+        }
+    }
+
+    decomposition->is_exact = is_converged;
+
+    for (int i = 0; i < num_r_cliques; i++) {
+        decomposition->nucleus_numbers[i] = atomic_load(&shared.read_estimates[i]);
+        decomposition->max_nucleus_number = max(decomposition->max_nucleus_number, decomposition->nucleus_numbers[i]);
+    }
+
+    for (int t = 0; t < num_threads; t++) {
+        free(workers[t].counts);
+    }
+
+    if (mode == LOCAL_UPDATE_SYNCHRONOUS) {
+        free(shared.write_estimates);
+    }
+
+    free(shared.read_estimates);
+    free(shared.is_active);
+    free(threads);
+    free(workers);
+    stopwatch_delete(&stopwatch);
+    _nucleus_incidence_free(&incidence);
+
+    return decomposition;
+}
+
+// End Local Functions
+// Begin Utility Functions
+
+/**
+ * @brief Prints the param nucleus decomposition to stdout.
+ *
+ * @param decomposition The nucleus decomposition to print.
+ * @param should_print_newline True if a newline should be printed
+ * at the end of all print statements, false otherwise.
+ */
+void nucleus_decomposition_print(NucleusDecomposition* decomposition, bool should_print_newline) {
+    assert(decomposition != NULL);
+
+    printf("Nucleus Decomposition: { r: %d, s: %d, %d-Cliques: %d, %d-Cliques: %d, Max Nucleus: %d, Nucleus Numbers: ", decomposition->r, decomposition->s, decomposition->r, decomposition->num_r_cliques, decomposition->s, decomposition->num_s_cliques, decomposition->max_nucleus_number);
+    array_print(decomposition->nucleus_numbers, decomposition->num_r_cliques, false);
+    printf(" }");
+
+    if (should_print_newline) {
+        printf("\n");
+    }
+}
+
+// End Utility Functions
@@ -2,8 +2,11 @@
 #define NUCLEUS_DECOMPOSITION_H_INCLUDED
 
 #include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <time.h>
 
+#include "../collections/bucket_structure.h"
 #include "../collections/clique_set.h"
 #include "../collections/generic_node.h"
 #include "../collections/graph.h"
@@ -11,7 +14,53 @@
 #include "../utilities/array_util.h"
 #include "../utilities/stopwatch.h"
 #include "clique.h"
+#include "nucleus_hierarchy.h"
 
-void run_nucleus_decomposition(Graph* graph, int r, int s);
+typedef struct NucleusDecomposition {
+    int r;
+    int s;
+    int num_r_cliques;
+    int num_s_cliques;
+    int max_nucleus_number;
 
-#endif
\ No newline at end of file
+    // False if the nucleus numbers are upper bounds from a local
+    // decomposition that was stopped before converging.
+    bool is_exact;
+
+    CliqueSet* r_cliques;
+    int* nucleus_numbers;
+
+    // The forest of nuclei, or NULL if it was not built.
+    NucleusHierarchy* hierarchy;
+} NucleusDecomposition;
+
+// Whether an iteration of the local decomposition reads the
+// estimates of the previous iteration (SND) or the latest estimates
+// (AND).
+typedef enum LocalUpdateMode {
+    LOCAL_UPDATE_SYNCHRONOUS,
+    LOCAL_UPDATE_ASYNCHRONOUS
+} LocalUpdateMode;
+
+// The statistics of one iteration of the local decomposition. An
+// iteration with no updated estimate has converged. seconds is the
+// processor time of the iteration as measured by stopwatch_lap.
+typedef struct LocalIterationStats {
+    int iteration;
+    int num_updated;
+    long sum_decrease;
+    double seconds;
+} LocalIterationStats;
+
+// Create and Delete Functions
+NucleusDecomposition* run_nucleus_decomposition(Graph* graph, int r, int s);
+NucleusDecomposition* run_nucleus_decomposition_hierarchy(Graph* graph, int r, int s);
+void nucleus_decomposition_delete(NucleusDecomposition** ptr_decomposition);
+
+// Local Functions
+NucleusDecomposition* run_nucleus_decomposition_local(Graph* graph, int r, int s, LocalUpdateMode mode, int num_threads, int max_iterations, void* context, bool (*on_iteration)(void*, LocalIterationStats*));
+
+// Utility Functions
+void nucleus_decomposition_print(NucleusDecomposition* decomposition, bool should_print_newline);
+
+#endif
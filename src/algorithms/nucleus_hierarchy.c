@@ -0,0 +1,390 @@
+#include "nucleus_hierarchy.h"
+
+/**
+ * This class contains the construction of the hierarchy of nuclei
+ * from a finished (r,s) nucleus decomposition, following the
+ * disjoint-set construction of Sariyuce and Pinar. A k-nucleus is a
+ * maximal set of r-cliques with nucleus number at least k where any
+ * two r-cliques are joined by a chain of s-cliques whose r-cliques
+ * all have nucleus number at least k. Every k-nucleus is contained
+ * in exactly one (k-1)-nucleus, so the nuclei form a forest.
+ *
+ * The value of an s-clique is the smallest nucleus number of its
+ * r-cliques. The levels are swept from the largest nucleus number
+ * down, and at level k the r-cliques of every s-clique of value k are
+ * merged in a disjoint-set forest. The sets after level k are then
+ * exactly the k-nuclei. A node is only created for a set that gained
+ * an r-clique of nucleus number k at level k. A set that did not
+ * change is the same nucleus as at level k + 1 and keeps its node,
+ * and the nuclei inside a set are never traversed again once they
+ * are merged.
+ */
+
+// Begin Helper Functions
+
+/**
+ * @brief Counting sorts the param items by level.
+ *
+ * @param levels The level of each item.
+ * @param num_items The number of items.
+ * @param max_level The largest level.
+ * @param ptr_order Set to the items sorted by level.
+ * @return int* An array of size max_level + 2 where the items of
+ * level k are order[ptr[k]] to order[ptr[k + 1] - 1].
+ */
+static int* _sort_by_level(int* levels, int num_items, int max_level, int** ptr_order) {
+    int* ptr_levels = calloc(max_level + 2, sizeof(int));
+    int* order = malloc(max(num_items, 1) * sizeof(int));
+
+    for (int i = 0; i < num_items; i++) {
+        ptr_levels[levels[i] + 1]++;
+    }
+
+    for (int k = 0; k <= max_level; k++) {
+        ptr_levels[k + 1] += ptr_levels[k];
+    }
+
+    int* idx_insert = malloc((max_level + 1) * sizeof(int));
+    memcpy(idx_insert, ptr_levels, (max_level + 1) * sizeof(int));
+
+    for (int i = 0; i < num_items; i++) {
+        order[idx_insert[levels[i]]++] = i;
+    }
+
+    free(idx_insert);
+
+    *ptr_order = order;
+    return ptr_levels;
+}
+
+/**
+ * @brief Computes which nodes contain each vertex, as a CSR from
+ * every vertex to its nodes.
+ *
+ * A node contains a vertex if it is an ancestor, or itself, of the
+ * node of an r-clique containing the vertex. The walk up from each
+ * such r-clique stops at the first node already marked for the
+ * vertex, so each node of a vertex is visited once per vertex.
+ *
+ * @param hierarchy The hierarchy with parents and r_clique_nodes set.
+ * @param r_cliques The r-cliques.
+ * @param num_vertices The number of vertices of the graph.
+ * @param ptr_idx_nodes Set to the nodes of each vertex.
+ * @return int* The CSR row pointers of size num_vertices + 1.
+ */
+static int* _get_vertex_nodes(NucleusHierarchy* hierarchy, CliqueSet* r_cliques, int num_vertices, int** ptr_idx_nodes) {
+    int r = r_cliques->k;
+    int num_r_cliques = r_cliques->size;
+
+    // Invert the r-cliques into a CSR from each vertex to the
+    // r-cliques containing it.
+    int* ptr_r_cliques = calloc(num_vertices + 1, sizeof(int));
+    for (int i = 0; i < num_r_cliques * r; i++) {
+        ptr_r_cliques[r_cliques->elements[i] + 1]++;
+    }
+
+    for (vertex v = 0; v < num_vertices; v++) {
+        ptr_r_cliques[v + 1] += ptr_r_cliques[v];
+    }
+
+    int* idx_r_cliques = malloc(max(num_r_cliques * r, 1) * sizeof(int));
+    int* idx_insert = malloc(max(num_vertices, 1) * sizeof(int));
+    memcpy(idx_insert, ptr_r_cliques, num_vertices * sizeof(int));
+
+    for (int i = 0; i < num_r_cliques; i++) {
+        clique r_clique = clique_set_get(r_cliques, i);
+
+        for (int j = 0; j < r; j++) {
+            idx_r_cliques[idx_insert[r_clique[j]]++] = i;
+        }
+    }
+
+    free(idx_insert);
+
+    int* stamps = malloc(max(hierarchy->num_nodes, 1) * sizeof(int));
+    for (int i = 0; i < hierarchy->num_nodes; i++) {
+        stamps[i] = -1;
+    }
+
+    int* ptr_nodes = malloc((num_vertices + 1) * sizeof(int));
+    int capacity_nodes = max(num_r_cliques * r, 1);
+    int* idx_nodes = malloc(capacity_nodes * sizeof(int));
+    int num_nodes = 0;
+
+    for (vertex v = 0; v < num_vertices; v++) {
+        ptr_nodes[v] = num_nodes;
+
+        for (int idx_nnz = ptr_r_cliques[v]; idx_nnz < ptr_r_cliques[v + 1]; idx_nnz++) {
+            int node = hierarchy->r_clique_nodes[idx_r_cliques[idx_nnz]];
+
+            while (node != -1 && stamps[node] != v) {
+                if (num_nodes == capacity_nodes) {
+                    capacity_nodes *= 2;
+                    idx_nodes = realloc(idx_nodes, capacity_nodes * sizeof(int));
+                    assert(idx_nodes != NULL);
+                }
+
+                stamps[node] = v;
+                idx_nodes[num_nodes++] = node;
+                node = hierarchy->parents[node];
+            }
+        }
+    }
+
+    ptr_nodes[num_vertices] = num_nodes;
+
+    free(stamps);
+    free(ptr_r_cliques);
+    free(idx_r_cliques);
+
+    *ptr_idx_nodes = idx_nodes;
+    return ptr_nodes;
+}
+
+/**
+ * @brief Counts the vertices and the induced edges of every node and
+ * computes its edge density, the fraction of the vertex pairs of the
+ * nucleus that are edges.
+ *
+ * An edge (u, v) is induced by every node containing both u and v.
+ * The nodes of u are marked once, then the nodes of each neighbor v
+ * of u with v > u are checked against the marks.
+ *
+ * @param hierarchy The hierarchy with parents and r_clique_nodes set.
+ * @param graph The undirected graph that was decomposed.
+ * @param r_cliques The r-cliques.
+ */
+static void _compute_node_statistics(NucleusHierarchy* hierarchy, Graph* graph, CliqueSet* r_cliques) {
+    int num_vertices = graph->num_vertices;
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+
+    int* idx_nodes;
+    int* ptr_nodes = _get_vertex_nodes(hierarchy, r_cliques, num_vertices, &idx_nodes);
+
+    for (int i = 0; i < ptr_nodes[num_vertices]; i++) {
+        hierarchy->vertex_counts[idx_nodes[i]]++;
+    }
+
+    int* stamps = malloc(max(hierarchy->num_nodes, 1) * sizeof(int));
+    for (int i = 0; i < hierarchy->num_nodes; i++) {
+        stamps[i] = -1;
+    }
+
+    for (vertex u = 0; u < num_vertices; u++) {
+        if (ptr_nodes[u] == ptr_nodes[u + 1]) {
+            continue;
+        }
+
+        for (int i = ptr_nodes[u]; i < ptr_nodes[u + 1]; i++) {
+            stamps[idx_nodes[i]] = u;
+        }
+
+        for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+            vertex v = idx_cols[idx_nnz];
+
+            if (v <= u) {
+                continue;
+            }
+
+            for (int i = ptr_nodes[v]; i < ptr_nodes[v + 1]; i++) {
+                if (stamps[idx_nodes[i]] == u) {
+                    hierarchy->edge_counts[idx_nodes[i]]++;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < hierarchy->num_nodes; i++) {
+        long num_pairs = (long)hierarchy->vertex_counts[i] * (hierarchy->vertex_counts[i] - 1) / 2;
+        hierarchy->densities[i] = num_pairs > 0 ? (double)hierarchy->edge_counts[i] / num_pairs : 0.0;
+    }
+
+    free(stamps);
+    free(ptr_nodes);
+    free(idx_nodes);
+}
+
+// End Helper Functions
+// Begin Create and Delete Functions
+
+/**
+ * @brief Builds the hierarchy of the nuclei of a finished (r,s)
+ * nucleus decomposition.
+ *
+ * Merging two sets at level k records the nodes of both sets and
+ * clears them, so each node is recorded at most once as it stops
+ * being a root. Once every s-clique of value k has been merged, the
+ * set of every r-clique with nucleus number k gets a new node, and
+ * the recorded nodes are hung under the node of their set.
+ *
+ * @param graph The undirected graph that was decomposed.
+ * @param r_cliques The r-cliques of the decomposition.
+ * @param nucleus_numbers The nucleus number of each r-clique.
+ * @param num_s_cliques The number of s-cliques.
+ * @param num_sub_cliques The number of r-cliques in each s-clique.
+ * @param sub_clique_ids The r-cliques contained in each s-clique.
+ * @return NucleusHierarchy* The forest of nuclei.
+ */
+NucleusHierarchy* nucleus_hierarchy_new(Graph* graph, CliqueSet* r_cliques, int* nucleus_numbers, int num_s_cliques, int num_sub_cliques, int* sub_clique_ids) {
+    assert(graph != NULL);
+    assert(graph->adjacency_matrix != NULL);
+    assert(r_cliques != NULL);
+    assert(nucleus_numbers != NULL);
+
+    int num_r_cliques = r_cliques->size;
+    int max_level = 0;
+
+    for (int i = 0; i < num_r_cliques; i++) {
+        max_level = max(max_level, nucleus_numbers[i]);
+    }
+
+    int* s_levels = malloc(max(num_s_cliques, 1) * sizeof(int));
+    for (int i = 0; i < num_s_cliques; i++) {
+        s_levels[i] = nucleus_numbers[sub_clique_ids[i * num_sub_cliques]];
+
+        for (int j = 1; j < num_sub_cliques; j++) {
+            s_levels[i] = min(s_levels[i], nucleus_numbers[sub_clique_ids[i * num_sub_cliques + j]]);
+        }
+    }
+
+    int* order_r;
+    int* order_s;
+    int* ptr_r_levels = _sort_by_level(nucleus_numbers, num_r_cliques, max_level, &order_r);
+    int* ptr_s_levels = _sort_by_level(s_levels, num_s_cliques, max_level, &order_s);
+    free(s_levels);
+
+    // Every node is created for a set holding an r-clique of its
+    // level, so there are at most num_r_cliques nodes.
+    NucleusHierarchy* hierarchy = malloc(sizeof(NucleusHierarchy));
+    hierarchy->num_nodes = 0;
+    hierarchy->num_r_cliques = num_r_cliques;
+    hierarchy->parents = malloc(max(num_r_cliques, 1) * sizeof(int));
+    hierarchy->nucleus_numbers = malloc(max(num_r_cliques, 1) * sizeof(int));
+    hierarchy->r_clique_nodes = malloc(max(num_r_cliques, 1) * sizeof(int));
+
+    DisjointSet* sets = disjoint_set_new(num_r_cliques);
+
+    // The node of the set rooted at each r-clique, or -1 if the set
+    // has no node yet or was merged at the current level.
+    int* root_nodes = malloc(max(num_r_cliques, 1) * sizeof(int));
+    for (int i = 0; i < num_r_cliques; i++) {
+        root_nodes[i] = -1;
+    }
+
+    // The nodes whose sets were merged at the current level, each with
+    // an r-clique of its set.
+    int* child_r_cliques = malloc(max(num_r_cliques, 1) * sizeof(int));
+    int* child_nodes = malloc(max(num_r_cliques, 1) * sizeof(int));
+
+    for (int k = max_level; k >= 0; k--) {
+        int num_children = 0;
+
+        for (int idx_s = ptr_s_levels[k]; idx_s < ptr_s_levels[k + 1]; idx_s++) {
+            int* sub_ids = &sub_clique_ids[order_s[idx_s] * num_sub_cliques];
+
+            for (int j = 1; j < num_sub_cliques; j++) {
+                int roots[2] = {disjoint_set_find(sets, sub_ids[0]), disjoint_set_find(sets, sub_ids[j])};
+
+                if (roots[0] == roots[1]) {
+                    continue;
+                }
+
+                for (int idx_root = 0; idx_root < 2; idx_root++) {
+                    if (root_nodes[roots[idx_root]] != -1) {
+                        child_r_cliques[num_children] = roots[idx_root];
+                        child_nodes[num_children] = root_nodes[roots[idx_root]];
+                        num_children++;
+                        root_nodes[roots[idx_root]] = -1;
+                    }
+                }
+
+                disjoint_set_union(sets, roots[0], roots[1]);
+            }
+        }
+
+        for (int idx_r = ptr_r_levels[k]; idx_r < ptr_r_levels[k + 1]; idx_r++) {
+            int root = disjoint_set_find(sets, order_r[idx_r]);
+
+            if (root_nodes[root] == -1) {
+                int node = hierarchy->num_nodes++;
+                hierarchy->parents[node] = -1;
+                hierarchy->nucleus_numbers[node] = k;
+                root_nodes[root] = node;
+            }
+
+            hierarchy->r_clique_nodes[order_r[idx_r]] = root_nodes[root];
+        }
+
+        for (int i = 0; i < num_children; i++) {
+            hierarchy->parents[child_nodes[i]] = root_nodes[disjoint_set_find(sets, child_r_cliques[i])];
+        }
+    }
+
+    disjoint_set_delete(&sets);
+    free(root_nodes);
+    free(child_r_cliques);
+    free(child_nodes);
+    free(order_r);
+    free(order_s);
+    free(ptr_r_levels);
+    free(ptr_s_levels);
+
+    int num_nodes = max(hierarchy->num_nodes, 1);
+    hierarchy->parents = realloc(hierarchy->parents, num_nodes * sizeof(int));
+    hierarchy->nucleus_numbers = realloc(hierarchy->nucleus_numbers, num_nodes * sizeof(int));
+    hierarchy->vertex_counts = calloc(num_nodes, sizeof(int));
+    hierarchy->edge_counts = calloc(num_nodes, sizeof(long));
+    hierarchy->densities = calloc(num_nodes, sizeof(double));
+
+    _compute_node_statistics(hierarchy, graph, r_cliques);
+
+    return hierarchy;
+}
+
+/**
+ * @brief Deletes the param nucleus hierarchy and all associated
+ * memory. The pointer to the nucleus hierarchy is set to NULL.
+ *
+ * @param ptr_hierarchy A pointer to the nucleus hierarchy.
+ */
+void nucleus_hierarchy_delete(NucleusHierarchy** ptr_hierarchy) {
+    assert(ptr_hierarchy != NULL);
+    assert(*ptr_hierarchy != NULL);
+
+    free((*ptr_hierarchy)->parents);
+    free((*ptr_hierarchy)->nucleus_numbers);
+    free((*ptr_hierarchy)->vertex_counts);
+    free((*ptr_hierarchy)->edge_counts);
+    free((*ptr_hierarchy)->densities);
+    free((*ptr_hierarchy)->r_clique_nodes);
+    free(*ptr_hierarchy);
+    *ptr_hierarchy = NULL;
+}
+
+// End Create and Delete Functions
+// Begin Utility Functions
+
+/**
+ * @brief Prints the param nucleus hierarchy to stdout, one node per
+ * line.
+ *
+ * @param hierarchy The nucleus hierarchy to print.
+ * @param should_print_newline True if a newline should be printed
+ * at the end of all print statements, false otherwise.
+ */
+void nucleus_hierarchy_print(NucleusHierarchy* hierarchy, bool should_print_newline) {
+    assert(hierarchy != NULL);
+
+    printf("Nucleus Hierarchy: { Nodes: %d }\n", hierarchy->num_nodes);
+
+    for (int i = 0; i < hierarchy->num_nodes; i++) {
+        printf("{ Node: %d, k: %d, Parent: %d, Vertices: %d, Edges: %ld, Density: %.4f }", i, hierarchy->nucleus_numbers[i], hierarchy->parents[i], hierarchy->vertex_counts[i], hierarchy->edge_counts[i], hierarchy->densities[i]);
+
+        if (should_print_newline || i + 1 < hierarchy->num_nodes) {
+            printf("\n");
+        }
+    }
+}
+
+// End Utility Functions
@@ -0,0 +1,40 @@
+#ifndef NUCLEUS_HIERARCHY_H_INCLUDED
+#define NUCLEUS_HIERARCHY_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../collections/clique_set.h"
+#include "../collections/disjoint_set.h"
+#include "../collections/graph.h"
+#include "../utilities/array_util.h"
+
+// Node i of the forest is a k-nucleus with k = nucleus_numbers[i].
+// Children always have a smaller index and a larger nucleus number
+// than their parent, and roots have parent -1. vertex_counts and
+// edge_counts are the size of the vertex set of the nucleus and the
+// number of edges of the graph induced by it.
+typedef struct NucleusHierarchy {
+    int num_nodes;
+    int num_r_cliques;
+
+    int* parents;
+    int* nucleus_numbers;
+    int* vertex_counts;
+    long* edge_counts;
+    double* densities;
+
+    // The node of the smallest nucleus containing each r-clique.
+    int* r_clique_nodes;
+} NucleusHierarchy;
+
+// Create and Delete Functions
+NucleusHierarchy* nucleus_hierarchy_new(Graph* graph, CliqueSet* r_cliques, int* nucleus_numbers, int num_s_cliques, int num_sub_cliques, int* sub_clique_ids);
+void nucleus_hierarchy_delete(NucleusHierarchy** ptr_hierarchy);
+
+// Utility Functions
+void nucleus_hierarchy_print(NucleusHierarchy* hierarchy, bool should_print_newline);
+
+#endif
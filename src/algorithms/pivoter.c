@@ -0,0 +1,297 @@
+#include "pivoter.h"
+
+/**
+ * This class contains the pivoting clique counter of Jain and
+ * Seshadhri (Pivoter), which counts the k-cliques of every size k at
+ * once.
+ *
+ * Every vertex v is visited with the candidates P, its neighbors
+ * later in the degeneracy ordering. At each step a pivot u maximizing
+ * |N(u) ∩ P| is chosen, and only u and the candidates not adjacent to
+ * u are branched on, each with the candidates adjacent to it that
+ * were not branched on before. A branch either holds its vertex,
+ * which is in every clique below it, or takes it as a pivot, which
+ * may be left out. Every clique of the graph is then described by
+ * exactly one root to leaf path of this succinct clique tree, by its
+ * held vertices and a subset of its pivots. A leaf with h held
+ * vertices and p pivots therefore accounts for p choose j cliques of
+ * size h + j, for every j, and no clique is ever listed.
+ */
+
+/**
+ * @brief The state of _count_pivot_tree, which is constant during the
+ * count of one graph except for the held and pivot stacks.
+ */
+typedef struct _PivotTree {
+    int* ptr_rows;
+    int* idx_cols;
+
+    // Two buffers per depth, the candidates and the vertices to
+    // branch on, each holding the largest out degree.
+    vertex** candidates;
+    vertex** branches;
+
+    vertex* held;
+    vertex* pivots;
+
+    int stride;
+    double* counts;
+    double* vertex_counts;
+} _PivotTree;
+
+/**
+ * @brief Adds the cliques of a leaf with param num_held held vertices
+ * and param num_pivots pivots to the counts.
+ *
+ * A held vertex is in p choose j of the cliques of size h + j, and a
+ * pivot is in p - 1 choose j - 1 of them.
+ *
+ * @param tree The counter state.
+ * @param num_held The number of held vertices h.
+ * @param num_pivots The number of pivots p.
+ */
+static void _count_pivot_leaf(_PivotTree* tree, int num_held, int num_pivots) {
+    double num_with_pivot = 0;
+    double num_cliques = 1;
+
+    for (int j = 0; j <= num_pivots; j++) {
+        int k = num_held + j;
+        tree->counts[k] += num_cliques;
+
+        if (tree->vertex_counts != NULL) {
+            for (int i = 0; i < num_held; i++) {
+                tree->vertex_counts[(size_t)tree->held[i] * tree->stride + k] += num_cliques;
+            }
+
+            for (int i = 0; i < num_pivots; i++) {
+                tree->vertex_counts[(size_t)tree->pivots[i] * tree->stride + k] += num_with_pivot;
+            }
+        }
+
+        // Advance to p choose j + 1 and p - 1 choose j.
+        num_with_pivot = num_pivots > 0 ? num_cliques * (num_pivots - j) / num_pivots : 0;
+        num_cliques = num_cliques * (num_pivots - j) / (j + 1);
+    }
+}
+
+/**
+ * @brief Builds the succinct clique tree below the candidates at
+ * param depth and counts the cliques of its leaves.
+ *
+ * @param tree The counter state.
+ * @param num_candidates The number of candidates in
+ * tree->candidates[depth], which are sorted and are removed as they
+ * are branched on.
+ * @param depth The depth of the step.
+ * @param num_held The number of held vertices so far.
+ * @param num_pivots The number of pivots so far.
+ */
+static void _count_pivot_tree(_PivotTree* tree, int num_candidates, int depth, int num_held, int num_pivots) {
+    if (num_candidates == 0) {
+        _count_pivot_leaf(tree, num_held, num_pivots);
+        return;
+    }
+
+    int* ptr_rows = tree->ptr_rows;
+    int* idx_cols = tree->idx_cols;
+    vertex* candidates = tree->candidates[depth];
+    vertex* branches = tree->branches[depth];
+
+    // Choose the candidate with the most neighbors among the
+    // candidates as the pivot.
+    vertex pivot = candidates[0];
+    int max_num_adjacent = -1;
+
+    for (int i = 0; i < num_candidates; i++) {
+        vertex u = candidates[i];
+        int num_adjacent = set_intersection_size(candidates, num_candidates, &idx_cols[ptr_rows[u]], ptr_rows[u + 1] - ptr_rows[u]);
+
+        if (num_adjacent > max_num_adjacent) {
+            max_num_adjacent = num_adjacent;
+            pivot = u;
+        }
+    }
+
+    // Branch on the pivot first, then on every candidate not adjacent
+    // to the pivot.
+    int num_branches = 0;
+    branches[num_branches++] = pivot;
+
+    int idx_pivot_read = ptr_rows[pivot];
+    for (int i = 0; i < num_candidates; i++) {
+        vertex u = candidates[i];
+
+        while (idx_pivot_read < ptr_rows[pivot + 1] && idx_cols[idx_pivot_read] < u) {
+            idx_pivot_read++;
+        }
+
+        bool is_adjacent = idx_pivot_read < ptr_rows[pivot + 1] && idx_cols[idx_pivot_read] == u;
+
+        if (u != pivot && !is_adjacent) {
+            branches[num_branches++] = u;
+        }
+    }
+
+    for (int idx_branch = 0; idx_branch < num_branches; idx_branch++) {
+        vertex w = branches[idx_branch];
+        int num_next_candidates = set_intersection(candidates, num_candidates, &idx_cols[ptr_rows[w]], ptr_rows[w + 1] - ptr_rows[w], tree->candidates[depth + 1]);
+
+        if (idx_branch == 0) {
+            tree->pivots[num_pivots] = w;
+            _count_pivot_tree(tree, num_next_candidates, depth + 1, num_held, num_pivots + 1);
+        } else {
+            tree->held[num_held] = w;
+            _count_pivot_tree(tree, num_next_candidates, depth + 1, num_held + 1, num_pivots);
+        }
+
+        // Remove w from the candidates of the later branches.
+        int idx_write = 0;
+        for (int i = 0; i < num_candidates; i++) {
+            if (candidates[i] != w) {
+                candidates[idx_write++] = candidates[i];
+            }
+        }
+
+        num_candidates = idx_write;
+    }
+}
+
+// Begin Create and Delete Functions
+
+/**
+ * @brief Counts the k-cliques of the param graph for every k up to
+ * its clique number in one pass.
+ *
+ * The roots of the succinct clique tree are the vertices, each with
+ * its out-neighbors in the degeneracy orientation as candidates, so
+ * every candidate set has at most degeneracy vertices and the tree
+ * has depth at most degeneracy + 1. All buffers are allocated once.
+ *
+ * @param graph The undirected graph to count the cliques of.
+ * @param should_count_per_vertex True to also count the cliques of
+ * each size containing each vertex.
+ * @return CliqueCounts* The global and, if requested, per-vertex
+ * counts.
+ */
+CliqueCounts* count_all_cliques(Graph* graph, bool should_count_per_vertex) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+
+    int num_vertices = graph->num_vertices;
+    Graph* directed_graph = get_oriented_graph(graph, ORIENTATION_DEGENERACY);
+    int* ptr_dir_rows = directed_graph->adjacency_matrix->ptr_rows;
+    int* idx_dir_cols = directed_graph->adjacency_matrix->idx_cols;
+
+    int max_out_degree = 1;
+    for (vertex v = 0; v < num_vertices; v++) {
+        max_out_degree = max(max_out_degree, ptr_dir_rows[v + 1] - ptr_dir_rows[v]);
+    }
+
+    // A clique has at most max_out_degree + 1 vertices.
+    int max_depth = max_out_degree + 2;
+    int stride = max_out_degree + 2;
+
+    vertex* buffer_storage = malloc((size_t)2 * max_depth * max_out_degree * sizeof(vertex));
+    vertex** buffers = malloc(2 * max_depth * sizeof(vertex*));
+
+    for (int i = 0; i < 2 * max_depth; i++) {
+        buffers[i] = &buffer_storage[(size_t)i * max_out_degree];
+    }
+
+    _PivotTree tree = {
+        .ptr_rows = graph->adjacency_matrix->ptr_rows,
+        .idx_cols = graph->adjacency_matrix->idx_cols,
+        .candidates = buffers,
+        .branches = &buffers[max_depth],
+        .held = malloc(max_depth * sizeof(vertex)),
+        .pivots = malloc(max_depth * sizeof(vertex)),
+        .stride = stride,
+        .counts = calloc(stride, sizeof(double)),
+        .vertex_counts = should_count_per_vertex ? calloc((size_t)max(num_vertices, 1) * stride, sizeof(double)) : NULL,
+    };
+
+    for (vertex v = 0; v < num_vertices; v++) {
+        int out_degree = ptr_dir_rows[v + 1] - ptr_dir_rows[v];
+        memcpy(tree.candidates[0], &idx_dir_cols[ptr_dir_rows[v]], out_degree * sizeof(vertex));
+
+        tree.held[0] = v;
+        _count_pivot_tree(&tree, out_degree, 0, 1, 0);
+    }
+
+    CliqueCounts* clique_counts = malloc(sizeof(CliqueCounts));
+    clique_counts->num_vertices = num_vertices;
+    clique_counts->max_clique_size = 0;
+
+    for (int k = 1; k < stride; k++) {
+        if (tree.counts[k] > 0) {
+            clique_counts->max_clique_size = k;
+        }
+    }
+
+    // Shrink the rows of the per-vertex counts to the clique number.
+    int new_stride = clique_counts->max_clique_size + 1;
+
+    if (tree.vertex_counts != NULL) {
+        for (vertex v = 0; v < num_vertices; v++) {
+            memmove(&tree.vertex_counts[(size_t)v * new_stride], &tree.vertex_counts[(size_t)v * stride], new_stride * sizeof(double));
+        }
+
+        tree.vertex_counts = realloc(tree.vertex_counts, (size_t)max(num_vertices, 1) * new_stride * sizeof(double));
+    }
+
+    clique_counts->counts = realloc(tree.counts, new_stride * sizeof(double));
+    clique_counts->vertex_counts = tree.vertex_counts;
+
+    free(tree.held);
+    free(tree.pivots);
+    free(buffers);
+    free(buffer_storage);
+    graph_delete(&directed_graph);
+
+    return clique_counts;
+}
+
+/**
+ * @brief Deletes the param clique counts and all associated memory.
+ * The pointer to the clique counts is set to NULL.
+ *
+ * @param ptr_clique_counts A pointer to the clique counts.
+ */
+void clique_counts_delete(CliqueCounts** ptr_clique_counts) {
+    assert(ptr_clique_counts != NULL);
+    assert(*ptr_clique_counts != NULL);
+
+    free((*ptr_clique_counts)->counts);
+    free((*ptr_clique_counts)->vertex_counts);
+    free(*ptr_clique_counts);
+    *ptr_clique_counts = NULL;
+}
+
+// End Create and Delete Functions
+// Begin Utility Functions
+
+/**
+ * @brief Returns the number of k-cliques containing param v, which is
+ * 0 for k larger than the clique number.
+ *
+ * @param clique_counts The clique counts with per-vertex counts.
+ * @param v The vertex.
+ * @param k The size of the cliques.
+ * @return double The number of k-cliques containing v.
+ */
+double clique_counts_get_vertex(CliqueCounts* clique_counts, vertex v, int k) {
+    assert(clique_counts != NULL);
+    assert(clique_counts->vertex_counts != NULL);
+    assert(v >= 0 && v < clique_counts->num_vertices);
+    assert(k > 0);
+
+    if (k > clique_counts->max_clique_size) {
+        return 0;
+    }
+
+    return clique_counts->vertex_counts[(size_t)v * (clique_counts->max_clique_size + 1) + k];
+}
+
+// End Utility Functions
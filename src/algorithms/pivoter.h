@@ -0,0 +1,36 @@
+#ifndef PIVOTER_H_INCLUDED
+#define PIVOTER_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../collections/graph.h"
+#include "../utilities/math.h"
+#include "../utilities/set_intersection.h"
+#include "clique.h"
+
+// The counts are doubles, since the number of k-cliques in a clique
+// of n vertices is n choose k, which overflows a long for n > 66.
+typedef struct CliqueCounts {
+    int num_vertices;
+    // The clique number of the graph.
+    int max_clique_size;
+
+    // counts[k] is the number of k-cliques, for 1 <= k <=
+    // max_clique_size, and counts[0] is 0.
+    double* counts;
+    // vertex_counts[v * (max_clique_size + 1) + k] is the number of
+    // k-cliques containing v, or NULL if not requested.
+    double* vertex_counts;
+} CliqueCounts;
+
+// Create and Delete Functions
+CliqueCounts* count_all_cliques(Graph* graph, bool should_count_per_vertex);
+void clique_counts_delete(CliqueCounts** ptr_clique_counts);
+
+// Utility Functions
+double clique_counts_get_vertex(CliqueCounts* clique_counts, vertex v, int k);
+
+#endif
@@ -0,0 +1,464 @@
+#include "three_four_nucleus.h"
+
+/**
+ * This class contains a memory-lean implementation of the (3,4)
+ * nucleus decomposition. The nucleus number of a triangle is the
+ * largest k such that the triangle is in a subgraph where every
+ * triangle is contained in at least k 4-cliques.
+ *
+ * run_nucleus_decomposition stores every triangle in a hashed clique
+ * set and, for every 4-clique, the ids of its four triangles twice
+ * over (once per 4-clique and once in the incidence from each
+ * triangle), which grows with the number of 4-cliques. As
+ * run_truss_decomposition does for triangles, no 4-clique is ever
+ * stored here. Each triangle is one third vertex in a per-edge index
+ * plus its 4-clique count, and the 4-cliques of a triangle are found
+ * again when it is peeled by intersecting the sorted neighborhoods
+ * of its three vertices. The memory used is O(n + m + T) for T
+ * triangles: besides the graph and the edge ids, the index takes one
+ * vertex per triangle, and the peel takes one key and two flags per
+ * triangle plus the entries of the bucket structure, which compacts
+ * itself to hold at most 2T + BUCKET_NUM_OPEN_DEFAULT entries however
+ * many 4-cliques there are.
+ *
+ * Triangle ids are ints like every vertex and edge id in the repo, so
+ * at most INT_MAX triangles are supported. The 4-clique count of a
+ * triangle is below n and fits an int, and the total number of
+ * 4-cliques is a long.
+ */
+
+// Begin Helper Functions
+
+typedef struct _TriangleIndex {
+    int num_edges;
+    int num_triangles;
+    int num_nnzs;
+
+    int* ptr_rows;
+    int* idx_cols;
+    int* edge_ids;
+
+    int* ptr_triangles;
+    vertex* third_vertices;
+} _TriangleIndex;
+
+/**
+ * @brief Finds the id of the triangle (a, b, c) where a < b < c.
+ *
+ * The edge (a, b) is found by binary searching the row of a, then c
+ * is binary searched among the third vertices of the edge.
+ *
+ * @param index The triangle index.
+ * @param a The smallest vertex of the triangle.
+ * @param b The middle vertex of the triangle.
+ * @param c The largest vertex of the triangle.
+ * @return int The id of the triangle.
+ */
+static inline int _find_triangle(_TriangleIndex* index, vertex a, vertex b, vertex c) {
+    int idx_nnz = array_binary_search_range(index->idx_cols, index->num_nnzs, index->ptr_rows[a], index->ptr_rows[a + 1] - 1, b);
+    assert(idx_nnz >= 0);
+
+    int e = index->edge_ids[idx_nnz];
+    int idx_triangle = array_binary_search_range(index->third_vertices, index->num_triangles, index->ptr_triangles[e], index->ptr_triangles[e + 1] - 1, c);
+    assert(idx_triangle >= 0);
+
+    return idx_triangle;
+}
+
+/**
+ * @brief Finds the id of the triangle with the three param vertices,
+ * which need not be sorted.
+ */
+static inline int _find_triangle_unsorted(_TriangleIndex* index, vertex a, vertex b, vertex c) {
+    vertex swap;
+
+    if (a > b) {
+        swap = a;
+        a = b;
+        b = swap;
+    }
+
+    if (b > c) {
+        swap = b;
+        b = c;
+        c = swap;
+    }
+
+    if (a > b) {
+        swap = a;
+        a = b;
+        b = swap;
+    }
+
+    return _find_triangle(index, a, b, c);
+}
+
+/**
+ * @brief Finds the edge indexing the param triangle, the largest edge
+ * whose first triangle is at most the param triangle.
+ *
+ * @param index The triangle index.
+ * @param idx_triangle The triangle to find the edge of.
+ * @return int The id of the edge (u, v) of the triangle (u, v, w).
+ */
+static inline int _get_triangle_edge(_TriangleIndex* index, int idx_triangle) {
+    int e_low = 0;
+    int e_high = index->num_edges - 1;
+
+    while (e_low < e_high) {
+        int e_mid = (e_low + e_high + 1) / 2;
+
+        if (index->ptr_triangles[e_mid] <= idx_triangle) {
+            e_low = e_mid;
+        } else {
+            e_high = e_mid - 1;
+        }
+    }
+
+    return e_low;
+}
+
+/**
+ * @brief Lists the triangles (u, v, w), u < v < w, of every edge
+ * (u, v) by merging the sorted neighborhoods of u and v and keeping
+ * the common neighbors larger than v.
+ *
+ * @param index The triangle index with the graph and edges set.
+ * @param edge_sources The smaller endpoint of each edge.
+ * @param edge_targets The larger endpoint of each edge.
+ * @return bool False if there are more than INT_MAX triangles.
+ */
+static bool _build_triangle_index(_TriangleIndex* index, vertex* edge_sources, vertex* edge_targets) {
+    int* ptr_rows = index->ptr_rows;
+    int* idx_cols = index->idx_cols;
+
+    int capacity_triangles = max(index->num_edges, 1);
+    index->ptr_triangles = malloc((index->num_edges + 1) * sizeof(int));
+    index->third_vertices = malloc(capacity_triangles * sizeof(vertex));
+    index->num_triangles = 0;
+
+    for (int e = 0; e < index->num_edges; e++) {
+        vertex u = edge_sources[e];
+        vertex v = edge_targets[e];
+        index->ptr_triangles[e] = index->num_triangles;
+
+        int idx_u_read = ptr_rows[u];
+        int idx_v_read = ptr_rows[v];
+
+        while (idx_u_read < ptr_rows[u + 1] && idx_v_read < ptr_rows[v + 1]) {
+            vertex w_u = idx_cols[idx_u_read];
+            vertex w_v = idx_cols[idx_v_read];
+
+            if (w_u < w_v) {
+                idx_u_read++;
+                continue;
+            }
+
+            if (w_u > w_v) {
+                idx_v_read++;
+                continue;
+            }
+
+            idx_u_read++;
+            idx_v_read++;
+
+            if (w_u <= v) {
+                continue;
+            }
+
+            if (index->num_triangles == capacity_triangles) {
+                if (capacity_triangles == INT_MAX) {
+                    return false;
+                }
+
+                capacity_triangles = (int)((long)capacity_triangles * 2 < INT_MAX ? (long)capacity_triangles * 2 : INT_MAX);
+                index->third_vertices = realloc(index->third_vertices, capacity_triangles * sizeof(vertex));
+                assert(index->third_vertices != NULL);
+            }
+
+            index->third_vertices[index->num_triangles++] = w_u;
+        }
+    }
+
+    index->ptr_triangles[index->num_edges] = index->num_triangles;
+    index->third_vertices = realloc(index->third_vertices, max(index->num_triangles, 1) * sizeof(vertex));
+
+    return true;
+}
+
+/**
+ * @brief Counts the 4-cliques containing each triangle.
+ *
+ * Every 4-clique (a, b, c, d), a < b < c < d, is found once from its
+ * smallest triangle (a, b, c) by merging the third vertices of the
+ * edge (a, b) after c, which are the common neighbors of a and b
+ * larger than c, with the neighborhood of c. The triangle (a, b, d)
+ * is then the position of d among the third vertices of (a, b), and
+ * the triangles (a, c, d) and (b, c, d) are looked up.
+ *
+ * @param index The triangle index.
+ * @param edge_sources The smaller endpoint of each edge.
+ * @param edge_targets The larger endpoint of each edge.
+ * @param ptr_num_four_cliques Set to the number of 4-cliques.
+ * @return int* The number of 4-cliques containing each triangle.
+ */
+static int* _count_triangle_four_cliques(_TriangleIndex* index, vertex* edge_sources, vertex* edge_targets, long* ptr_num_four_cliques) {
+    int* ptr_rows = index->ptr_rows;
+    int* idx_cols = index->idx_cols;
+    int* counts = calloc(max(index->num_triangles, 1), sizeof(int));
+    long num_four_cliques = 0;
+
+    for (int e = 0; e < index->num_edges; e++) {
+        vertex a = edge_sources[e];
+        vertex b = edge_targets[e];
+        int idx_triangles_end = index->ptr_triangles[e + 1];
+
+        for (int t = index->ptr_triangles[e]; t < idx_triangles_end; t++) {
+            vertex c = index->third_vertices[t];
+
+            int idx_third_read = t + 1;
+            int idx_c_read = ptr_rows[c];
+
+            while (idx_third_read < idx_triangles_end && idx_c_read < ptr_rows[c + 1]) {
+                vertex d_ab = index->third_vertices[idx_third_read];
+                vertex d_c = idx_cols[idx_c_read];
+
+                if (d_ab < d_c) {
+                    idx_third_read++;
+                    continue;
+                }
+
+                if (d_ab > d_c) {
+                    idx_c_read++;
+                    continue;
+                }
+
+                counts[t]++;
+                counts[idx_third_read]++;
+                counts[_find_triangle(index, a, c, d_ab)]++;
+                counts[_find_triangle(index, b, c, d_ab)]++;
+                num_four_cliques++;
+
+                idx_third_read++;
+                idx_c_read++;
+            }
+        }
+    }
+
+    *ptr_num_four_cliques = num_four_cliques;
+    return counts;
+}
+
+// End Helper Functions
+// Begin Create and Delete Functions
+
+/**
+ * @brief Runs the (3,4) nucleus decomposition on the param graph
+ * without storing any 4-clique.
+ *
+ * The triangles are extracted from a bucket structure keyed by their
+ * remaining 4-clique count one bucket at a time. Extracting the
+ * triangle (a, b, c) fixes its nucleus number to its current count,
+ * then every d adjacent to all of a, b and c is found with a
+ * three-way merge of their sorted neighborhoods. If none of the
+ * triangles (a, b, d), (a, c, d) and (b, c, d) has been extracted,
+ * the 4-clique (a, b, c, d) still exists and the count of each of
+ * them larger than the count of (a, b, c) is decremented. Recovering
+ * the 4-cliques costs O(d(a) + d(b) + d(c)) per triangle in place of
+ * the stored 4-cliques and incidence of run_nucleus_decomposition.
+ *
+ * @param graph The undirected graph to decompose.
+ * @return ThreeFourNucleusDecomposition* The triangle index and the
+ * nucleus number of each triangle in lexicographic order, or NULL if
+ * the graph has more than INT_MAX triangles.
+ */
+ThreeFourNucleusDecomposition* run_three_four_nucleus_decomposition(Graph* graph) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+
+    int num_edges = graph->num_edges / 2;
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+
+    int* reverse_edges = graph_get_reverse_edges(graph);
+    int* edge_ids = graph_get_edge_ids(graph, reverse_edges);
+    free(reverse_edges);
+
+    // Record the endpoints (u, v), u < v, of each edge.
+    vertex* edge_sources = malloc(max(num_edges, 1) * sizeof(vertex));
+    vertex* edge_targets = malloc(max(num_edges, 1) * sizeof(vertex));
+
+    for (vertex u = 0; u < graph->num_vertices; u++) {
+        for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+            if (idx_cols[idx_nnz] > u) {
+                edge_sources[edge_ids[idx_nnz]] = u;
+                edge_targets[edge_ids[idx_nnz]] = idx_cols[idx_nnz];
+            }
+        }
+    }
+
+    _TriangleIndex index;
+    index.num_edges = num_edges;
+    index.num_nnzs = graph->num_edges;
+    index.ptr_rows = ptr_rows;
+    index.idx_cols = idx_cols;
+    index.edge_ids = edge_ids;
+
+    if (_build_triangle_index(&index, edge_sources, edge_targets) == false) {
+        free(index.ptr_triangles);
+        free(index.third_vertices);
+        free(edge_ids);
+        free(edge_sources);
+        free(edge_targets);
+
+        return NULL;
+    }
+
+    long num_four_cliques;
+    int* counts = _count_triangle_four_cliques(&index, edge_sources, edge_targets, &num_four_cliques);
+
+    // The keys of the bucket structure are the remaining counts and
+    // become the nucleus numbers once every triangle has been
+    // extracted. The counts are copied, so they are freed for the
+    // peel.
+    BucketStructure* buckets = bucket_structure_new(index.num_triangles, counts, BUCKET_NUM_OPEN_DEFAULT);
+    free(counts);
+    bool* is_triangle_removed = calloc(max(index.num_triangles, 1), sizeof(bool));
+
+    int* keys = buckets->keys;
+    int* batch;
+    int count;
+    int num_batch;
+
+    while ((num_batch = bucket_structure_next_batch(buckets, &batch, &count)) > 0) {
+        for (int i = 0; i < num_batch; i++) {
+            int t = batch[i];
+            int e = _get_triangle_edge(&index, t);
+            vertex a = edge_sources[e];
+            vertex b = edge_targets[e];
+            vertex c = index.third_vertices[t];
+
+            int idx_a_read = ptr_rows[a];
+            int idx_b_read = ptr_rows[b];
+            int idx_c_read = ptr_rows[c];
+
+            while (idx_a_read < ptr_rows[a + 1] && idx_b_read < ptr_rows[b + 1] && idx_c_read < ptr_rows[c + 1]) {
+                vertex d_a = idx_cols[idx_a_read];
+                vertex d_b = idx_cols[idx_b_read];
+                vertex d_c = idx_cols[idx_c_read];
+                vertex d = max(d_a, max(d_b, d_c));
+
+                if (d_a < d) {
+                    idx_a_read++;
+                    continue;
+                }
+
+                if (d_b < d) {
+                    idx_b_read++;
+                    continue;
+                }
+
+                if (d_c < d) {
+                    idx_c_read++;
+                    continue;
+                }
+
+                idx_a_read++;
+                idx_b_read++;
+                idx_c_read++;
+
+                int other_triangles[3] = {
+                    _find_triangle_unsorted(&index, a, b, d),
+                    _find_triangle_unsorted(&index, a, c, d),
+                    _find_triangle_unsorted(&index, b, c, d),
+                };
+
+                // The 4-clique was already destroyed by an earlier
+                // triangle.
+                if (is_triangle_removed[other_triangles[0]] || is_triangle_removed[other_triangles[1]] || is_triangle_removed[other_triangles[2]]) {
+                    continue;
+                }
+
+                for (int j = 0; j < 3; j++) {
+                    if (keys[other_triangles[j]] > count) {
+                        bucket_structure_decrement(buckets, other_triangles[j]);
+                    }
+                }
+            }
+
+            is_triangle_removed[t] = true;
+        }
+    }
+
+    free(is_triangle_removed);
+    free(edge_ids);
+
+    int* nucleus_numbers = malloc(max(index.num_triangles, 1) * sizeof(int));
+    memcpy(nucleus_numbers, keys, index.num_triangles * sizeof(int));
+    bucket_structure_delete(&buckets);
+
+    ThreeFourNucleusDecomposition* decomposition = malloc(sizeof(ThreeFourNucleusDecomposition));
+    decomposition->num_edges = num_edges;
+    decomposition->num_triangles = index.num_triangles;
+    decomposition->num_four_cliques = num_four_cliques;
+    decomposition->max_nucleus_number = 0;
+    decomposition->edge_sources = edge_sources;
+    decomposition->edge_targets = edge_targets;
+    decomposition->ptr_triangles = index.ptr_triangles;
+    decomposition->third_vertices = index.third_vertices;
+    decomposition->nucleus_numbers = nucleus_numbers;
+
+    for (int t = 0; t < index.num_triangles; t++) {
+        decomposition->max_nucleus_number = max(decomposition->max_nucleus_number, nucleus_numbers[t]);
+    }
+
+    return decomposition;
+}
+
+/**
+ * @brief Deletes the param (3,4) nucleus decomposition and all
+ * associated memory. The pointer to the decomposition is set to NULL.
+ *
+ * @param ptr_decomposition A pointer to the decomposition.
+ */
+void three_four_nucleus_decomposition_delete(ThreeFourNucleusDecomposition** ptr_decomposition) {
+    assert(ptr_decomposition != NULL);
+    assert(*ptr_decomposition != NULL);
+
+    free((*ptr_decomposition)->edge_sources);
+    free((*ptr_decomposition)->edge_targets);
+    free((*ptr_decomposition)->ptr_triangles);
+    free((*ptr_decomposition)->third_vertices);
+    free((*ptr_decomposition)->nucleus_numbers);
+    free(*ptr_decomposition);
+    *ptr_decomposition = NULL;
+}
+
+// End Create and Delete Functions
+// Begin Query Functions
+
+/**
+ * @brief Writes the sorted vertices of the param triangle.
+ *
+ * @param decomposition The (3,4) nucleus decomposition.
+ * @param idx_triangle The id of the triangle.
+ * @param triangle The output array of 3 vertices.
+ */
+void three_four_nucleus_get_triangle(ThreeFourNucleusDecomposition* decomposition, int idx_triangle, vertex* triangle) {
+    assert(decomposition != NULL);
+    assert(idx_triangle >= 0 && idx_triangle < decomposition->num_triangles);
+    assert(triangle != NULL);
+
+    _TriangleIndex index;
+    index.num_edges = decomposition->num_edges;
+    index.ptr_triangles = decomposition->ptr_triangles;
+
+    int e = _get_triangle_edge(&index, idx_triangle);
+    triangle[0] = decomposition->edge_sources[e];
+    triangle[1] = decomposition->edge_targets[e];
+    triangle[2] = decomposition->third_vertices[idx_triangle];
+}
+
+// End Query Functions
@@ -0,0 +1,41 @@
+#ifndef THREE_FOUR_NUCLEUS_H_INCLUDED
+#define THREE_FOUR_NUCLEUS_H_INCLUDED
+
+#include <assert.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "../collections/bucket_structure.h"
+#include "../collections/graph.h"
+#include "../utilities/array_util.h"
+#include "../utilities/math.h"
+
+// The triangle (u, v, w), u < v < w, is indexed by the id of the edge
+// (u, v) and its third vertex w. The triangles of edge e are
+// ptr_triangles[e] to ptr_triangles[e + 1] - 1 in increasing order of
+// third vertex, so the triangles are numbered in lexicographic order,
+// the same order as the 3-cliques of run_nucleus_decomposition.
+// Triangle ids are ints like every other id in the repo, so at most
+// INT_MAX triangles are supported.
+typedef struct ThreeFourNucleusDecomposition {
+    int num_edges;
+    int num_triangles;
+    long num_four_cliques;
+    int max_nucleus_number;
+
+    vertex* edge_sources;
+    vertex* edge_targets;
+    int* ptr_triangles;
+    vertex* third_vertices;
+    int* nucleus_numbers;
+} ThreeFourNucleusDecomposition;
+
+// Create and Delete Functions
+ThreeFourNucleusDecomposition* run_three_four_nucleus_decomposition(Graph* graph);
+void three_four_nucleus_decomposition_delete(ThreeFourNucleusDecomposition** ptr_decomposition);
+
+// Query Functions
+void three_four_nucleus_get_triangle(ThreeFourNucleusDecomposition* decomposition, int idx_triangle, vertex* triangle);
+
+#endif
@@ -0,0 +1,247 @@
+#include "truss.h"
+
+/**
+ * This class contains the implementation of the k-truss
+ * decomposition, which is the (2,3) nucleus decomposition. The
+ * k-truss of a graph is the subgraph where every edge is contained in
+ * at least k - 2 triangles, and the truss number of an edge is the
+ * largest k such that the edge is in the k-truss.
+ *
+ * Unlike run_nucleus_decomposition, no triangle is ever stored. The
+ * support (triangle count) of every edge is computed from the degree
+ * oriented graph, and the triangles of an edge are recovered during
+ * peeling by intersecting the sorted neighborhoods of its endpoints.
+ * The memory used is O(n + m). The decrements during peeling are
+ * one per triangle, but the BucketStructure of the edges compacts its
+ * stale entries and holds O(m) of them at any time.
+ */
+
+// Begin Support Functions
+
+/**
+ * @brief Counts the number of triangles containing each edge of the
+ * param graph.
+ *
+ * The graph is oriented from lower to higher degree, as in
+ * enumerate_three_cliques. Every triangle then has exactly one
+ * vertex v with out-edges to both other vertices u and w, and the
+ * triangle is found exactly once by intersecting the out-neighbors
+ * of v and u for the directed edge (v, u). Both out-neighborhoods are
+ * sorted so the intersection is a linear merge.
+ *
+ * @param graph The undirected graph to count the triangles of.
+ * @param edge_ids The id of each non-zero entry from
+ * graph_get_edge_ids.
+ * @return int* An array of size graph->num_edges / 2 holding the
+ * number of triangles containing each edge.
+ */
+int* get_edge_supports(Graph* graph, int* edge_ids) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+    assert(edge_ids != NULL);
+
+    int num_edges = graph->num_edges / 2;
+    int* supports = calloc(max(num_edges, 1), sizeof(int));
+
+    // Generate a degree oriented graph
+    Graph* directed_graph = get_oriented_graph(graph, ORIENTATION_DEGREE);
+
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+    int* ptr_dir_rows = directed_graph->adjacency_matrix->ptr_rows;
+    int* idx_dir_cols = directed_graph->adjacency_matrix->idx_cols;
+
+    // Map each directed entry to the id of its undirected edge.
+    int* dir_edge_ids = malloc(max(directed_graph->num_edges, 1) * sizeof(int));
+
+    for (vertex v = 0; v < directed_graph->num_vertices; v++) {
+        for (int idx_nnz = ptr_dir_rows[v]; idx_nnz < ptr_dir_rows[v + 1]; idx_nnz++) {
+            int idx_undirected_nnz = array_binary_search_range(idx_cols, graph->num_edges, ptr_rows[v], ptr_rows[v + 1] - 1, idx_dir_cols[idx_nnz]);
+            assert(idx_undirected_nnz >= 0);
+            dir_edge_ids[idx_nnz] = edge_ids[idx_undirected_nnz];
+        }
+    }
+
+    for (vertex v = 0; v < directed_graph->num_vertices; v++) {
+        for (int idx_u_nnz = ptr_dir_rows[v]; idx_u_nnz < ptr_dir_rows[v + 1]; idx_u_nnz++) {
+            vertex u = idx_dir_cols[idx_u_nnz];
+
+            int idx_v_read = ptr_dir_rows[v];
+            int idx_u_read = ptr_dir_rows[u];
+
+            // Merge the out-neighbors of v and u. Every common
+            // out-neighbor w closes the triangle (v, u, w).
+            while (idx_v_read < ptr_dir_rows[v + 1] && idx_u_read < ptr_dir_rows[u + 1]) {
+                vertex w_v = idx_dir_cols[idx_v_read];
+                vertex w_u = idx_dir_cols[idx_u_read];
+
+                if (w_v < w_u) {
+                    idx_v_read++;
+                } else if (w_v > w_u) {
+                    idx_u_read++;
+                } else {
+                    supports[dir_edge_ids[idx_u_nnz]]++;
+                    supports[dir_edge_ids[idx_v_read]]++;
+                    supports[dir_edge_ids[idx_u_read]]++;
+                    idx_v_read++;
+                    idx_u_read++;
+                }
+            }
+        }
+    }
+
+    free(dir_edge_ids);
+    graph_delete(&directed_graph);
+
+    return supports;
+}
+
+// End Support Functions
+// Begin Create and Delete Functions
+
+/**
+ * @brief Runs the k-truss decomposition on the param graph.
+ *
+ * The edges are extracted from a bucket structure keyed by support
+ * one bucket at a time. Extracting the edge (u, v) fixes its truss
+ * number to its current support + 2, then the triangles (u, v, w)
+ * that still exist are found by merging the sorted neighborhoods of
+ * u and v. The support of the edges (u, w) and (v, w) is decremented
+ * if it is larger than the support of (u, v). Each decrement is O(1),
+ * so the total work is dominated by the neighborhood merges, O(sum
+ * over edges of d(u) + d(v)).
+ *
+ * @param graph The undirected graph to decompose.
+ * @return TrussDecomposition* The endpoints and truss number of each
+ * edge, where the edges are numbered in lexicographic order, and the
+ * order the edges were peeled in.
+ */
+TrussDecomposition* run_truss_decomposition(Graph* graph) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+
+    int num_edges = graph->num_edges / 2;
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+
+    int* reverse_edges = graph_get_reverse_edges(graph);
+    int* edge_ids = graph_get_edge_ids(graph, reverse_edges);
+    free(reverse_edges);
+
+    // Record the endpoints (u, v), u < v, of each edge.
+    vertex* edge_sources = malloc(max(num_edges, 1) * sizeof(vertex));
+    vertex* edge_targets = malloc(max(num_edges, 1) * sizeof(vertex));
+
+    for (vertex u = 0; u < graph->num_vertices; u++) {
+        for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+            if (idx_cols[idx_nnz] > u) {
+                edge_sources[edge_ids[idx_nnz]] = u;
+                edge_targets[edge_ids[idx_nnz]] = idx_cols[idx_nnz];
+            }
+        }
+    }
+
+    // The keys of the bucket structure are the remaining supports and
+    // become the truss numbers (minus 2) once every edge has been
+    // extracted.
+    int* supports = get_edge_supports(graph, edge_ids);
+
+    BucketStructure* buckets = bucket_structure_new(num_edges, supports, BUCKET_NUM_OPEN_DEFAULT);
+    int* edge_order = malloc(max(num_edges, 1) * sizeof(int));
+    bool* is_edge_removed = calloc(max(num_edges, 1), sizeof(bool));
+
+    int* keys = buckets->keys;
+    int num_ordered = 0;
+    int* batch;
+    int support;
+    int num_batch;
+
+    while ((num_batch = bucket_structure_next_batch(buckets, &batch, &support)) > 0) {
+        for (int i = 0; i < num_batch; i++) {
+            int e = batch[i];
+            vertex u = edge_sources[e];
+            vertex v = edge_targets[e];
+            edge_order[num_ordered++] = e;
+
+            int idx_u_read = ptr_rows[u];
+            int idx_v_read = ptr_rows[v];
+
+            while (idx_u_read < ptr_rows[u + 1] && idx_v_read < ptr_rows[v + 1]) {
+                vertex w_u = idx_cols[idx_u_read];
+                vertex w_v = idx_cols[idx_v_read];
+
+                if (w_u < w_v) {
+                    idx_u_read++;
+                    continue;
+                }
+
+                if (w_u > w_v) {
+                    idx_v_read++;
+                    continue;
+                }
+
+                int triangle_edges[2] = {edge_ids[idx_u_read], edge_ids[idx_v_read]};
+                idx_u_read++;
+                idx_v_read++;
+
+                // The triangle was already destroyed by an earlier edge.
+                if (is_edge_removed[triangle_edges[0]] || is_edge_removed[triangle_edges[1]]) {
+                    continue;
+                }
+
+                for (int j = 0; j < 2; j++) {
+                    if (keys[triangle_edges[j]] > support) {
+                        bucket_structure_decrement(buckets, triangle_edges[j]);
+                    }
+                }
+            }
+
+            is_edge_removed[e] = true;
+        }
+    }
+
+    memcpy(supports, keys, num_edges * sizeof(int));
+    bucket_structure_delete(&buckets);
+    free(is_edge_removed);
+
+    TrussDecomposition* decomposition = malloc(sizeof(TrussDecomposition));
+    decomposition->num_edges = num_edges;
+    decomposition->max_truss_number = 2;
+    decomposition->edge_sources = edge_sources;
+    decomposition->edge_targets = edge_targets;
+    decomposition->edge_ids = edge_ids;
+    decomposition->truss_numbers = supports;
+    decomposition->edge_order = edge_order;
+
+    for (int e = 0; e < num_edges; e++) {
+        supports[e] += 2;
+        decomposition->max_truss_number = max(decomposition->max_truss_number, supports[e]);
+    }
+
+    return decomposition;
+}
+
+/**
+ * @brief Deletes the param truss decomposition and all associated
+ * memory. The pointer to the truss decomposition is set to NULL.
+ *
+ * @param ptr_decomposition A pointer to the truss decomposition.
+ */
+void truss_decomposition_delete(TrussDecomposition** ptr_decomposition) {
+    assert(ptr_decomposition != NULL);
+    assert(*ptr_decomposition != NULL);
+
+    free((*ptr_decomposition)->edge_sources);
+    free((*ptr_decomposition)->edge_targets);
+    free((*ptr_decomposition)->edge_ids);
+    free((*ptr_decomposition)->truss_numbers);
+    free((*ptr_decomposition)->edge_order);
+    free(*ptr_decomposition);
+    *ptr_decomposition = NULL;
+}
+
+// End Create and Delete Functions
@@ -0,0 +1,34 @@
+#ifndef TRUSS_H_INCLUDED
+#define TRUSS_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "../collections/bucket_structure.h"
+#include "../collections/graph.h"
+#include "../utilities/array_util.h"
+#include "../utilities/math.h"
+#include "clique.h"
+
+typedef struct TrussDecomposition {
+    int num_edges;
+    int max_truss_number;
+
+    vertex* edge_sources;
+    vertex* edge_targets;
+    int* edge_ids;
+    int* truss_numbers;
+    // The edges in the order they were peeled. Every edge has at most
+    // truss number - 2 triangles with edges peeled after it.
+    int* edge_order;
+} TrussDecomposition;
+
+// Create and Delete Functions
+TrussDecomposition* run_truss_decomposition(Graph* graph);
+void truss_decomposition_delete(TrussDecomposition** ptr_decomposition);
+
+// Support Functions
+int* get_edge_supports(Graph* graph, int* edge_ids);
+
+#endif
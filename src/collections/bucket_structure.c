@@ -0,0 +1,575 @@
+#include "bucket_structure.h"
+
+/**
+ * This class contains a bucket structure for peeling in the style of
+ * Julienne (Dhulipala, Blelloch and Shun). Every element has an
+ * integer key and the elements are extracted a whole bucket at a time
+ * in increasing order of key.
+ *
+ * Only a window of num_open buckets, holding the keys key_begin to
+ * key_begin + num_open - 1, is materialized. Every element with a
+ * larger key sits unordered in a single overflow bucket, so the
+ * memory does not depend on the largest key. When every open bucket
+ * has been extracted, the window is moved to the smallest key left in
+ * the overflow bucket and the overflow bucket is redistributed.
+ *
+ * Moves are lazy. Changing the key of an element appends it to its
+ * new bucket and leaves its old entry behind, and an entry is only
+ * checked against the current key of its element when its bucket is
+ * extracted. A key change is then O(1) amortized with no search, and
+ * a batch of key changes can be appended by many threads at once.
+ * Once the buckets hold BUCKET_COMPACTION_FACTOR entries per element,
+ * they are rebuilt from the current keys and shrunk to fit. This costs
+ * O(num_elements) after at least that many appends, so it is O(1)
+ * amortized, and it bounds the memory by O(num_elements + num_open)
+ * however many key changes there are.
+ *
+ * Keys are never lowered below the key of the current bucket. An
+ * element lowered to the current key lands in the bucket that was
+ * just extracted, and is returned by the next call to
+ * bucket_structure_next_batch with the same key.
+ */
+
+// Begin Helper Functions
+
+/**
+ * @brief Grows the param bucket to hold at least param min_capacity
+ * elements.
+ *
+ * @param bucket The bucket to grow.
+ * @param min_capacity The minimum capacity after growing.
+ */
+static void _bucket_reserve(Bucket* bucket, int min_capacity) {
+    if (bucket->capacity >= min_capacity) {
+        return;
+    }
+
+    int new_capacity = max(bucket->capacity, 1);
+
+    while (new_capacity < min_capacity) {
+        new_capacity *= 2;
+    }
+
+    bucket->elements = realloc(bucket->elements, new_capacity * sizeof(int));
+    assert(bucket->elements != NULL);
+    bucket->capacity = new_capacity;
+}
+
+/**
+ * @brief Appends the param element to the param bucket.
+ *
+ * @param bucket The bucket to append to.
+ * @param element The element to append.
+ */
+static inline void _bucket_append(Bucket* bucket, int element) {
+    if (bucket->size == bucket->capacity) {
+        _bucket_reserve(bucket, bucket->size + 1);
+    }
+
+    bucket->elements[bucket->size++] = element;
+}
+
+/**
+ * @brief Gets the open bucket holding the param key.
+ *
+ * @param buckets The bucket structure.
+ * @param key A key no smaller than key_begin.
+ * @return int The index of the open bucket, or -1 if the key is past
+ * the window and belongs in the overflow bucket.
+ */
+static inline int _get_bucket_index(BucketStructure* buckets, int key) {
+    int idx_bucket = key - buckets->key_begin;
+    return idx_bucket < buckets->num_open ? idx_bucket : -1;
+}
+
+/**
+ * @brief Appends the param element to the bucket of its current key.
+ *
+ * @param buckets The bucket structure.
+ * @param element The element to place.
+ */
+static inline void _place(BucketStructure* buckets, int element) {
+    int idx_bucket = _get_bucket_index(buckets, buckets->keys[element]);
+    _bucket_append(idx_bucket < 0 ? &buckets->overflow : &buckets->open[idx_bucket], element);
+    buckets->num_entries++;
+}
+
+/**
+ * @brief Checks if the buckets hold enough entries to be compacted.
+ */
+static inline bool _should_compact(BucketStructure* buckets) {
+    return buckets->num_entries >= (long)BUCKET_COMPACTION_FACTOR * buckets->num_elements + buckets->num_open;
+}
+
+/**
+ * @brief Drops every stale entry by refilling the buckets with one
+ * entry per element that has not been extracted. Every bucket is
+ * first shrunk to the number of entries it will hold.
+ *
+ * Elements lowered to the current key are placed in the current
+ * bucket as usual, and the batch buffer is not touched, so this is
+ * safe while a batch is being processed.
+ *
+ * @param buckets The bucket structure.
+ */
+static void _compact(BucketStructure* buckets) {
+    int num_counts = buckets->num_open + 1;
+    int* counts = calloc(num_counts, sizeof(int));
+
+    for (int element = 0; element < buckets->num_elements; element++) {
+        if (buckets->is_extracted[element] == false) {
+            counts[_get_bucket_index(buckets, buckets->keys[element]) + 1]++;
+        }
+    }
+
+    for (int idx_count = 0; idx_count < num_counts; idx_count++) {
+        Bucket* bucket = idx_count == 0 ? &buckets->overflow : &buckets->open[idx_count - 1];
+        bucket->size = 0;
+
+        if (counts[idx_count] == 0) {
+            free(bucket->elements);
+            *bucket = (Bucket){0, 0, NULL};
+        } else if (bucket->capacity > counts[idx_count]) {
+            bucket->elements = realloc(bucket->elements, counts[idx_count] * sizeof(int));
+            assert(bucket->elements != NULL);
+            bucket->capacity = counts[idx_count];
+        }
+    }
+
+    free(counts);
+    buckets->num_entries = 0;
+
+    for (int element = 0; element < buckets->num_elements; element++) {
+        if (buckets->is_extracted[element] == false) {
+            _place(buckets, element);
+        }
+    }
+}
+
+/**
+ * @brief Moves the window of open buckets to start at the smallest
+ * key in the overflow bucket and redistributes the overflow bucket.
+ *
+ * Only called once every open bucket is empty, so every element that
+ * has not been extracted has a key past the old window and has an
+ * entry in the overflow bucket.
+ *
+ * @param buckets The bucket structure.
+ */
+static void _advance_window(BucketStructure* buckets) {
+    Bucket* overflow = &buckets->overflow;
+    int min_key = -1;
+    int num_live = 0;
+
+    // Drop the stale entries and find the smallest live key.
+    for (int i = 0; i < overflow->size; i++) {
+        int element = overflow->elements[i];
+
+        if (buckets->is_extracted[element]) {
+            continue;
+        }
+
+        if (min_key < 0 || buckets->keys[element] < min_key) {
+            min_key = buckets->keys[element];
+        }
+
+        overflow->elements[num_live++] = element;
+    }
+
+    assert(num_live > 0);
+
+    buckets->key_begin = min_key;
+    buckets->idx_current = 0;
+    buckets->num_entries -= overflow->size;
+    overflow->size = 0;
+
+    // The live entries are packed at the front, and the overflow
+    // bucket can only be refilled up to where it is being read.
+    for (int i = 0; i < num_live; i++) {
+        _place(buckets, overflow->elements[i]);
+    }
+}
+
+/**
+ * @brief A thread's share of a batch update.
+ *
+ * The first pass sets the new keys and counts the entries each
+ * thread appends to each bucket, where count index 0 is the overflow
+ * bucket and count index i + 1 is open bucket i. The second pass
+ * writes the entries at the offsets given by the prefix sums of the
+ * counts over the threads.
+ */
+typedef struct _BucketUpdateWorker {
+    BucketStructure* buckets;
+    int* elements;
+    int* new_keys;
+    int* destinations;
+    int idx_begin;
+    int idx_end;
+    bool is_scatter_pass;
+
+    int* counts;
+    int* offsets;
+} _BucketUpdateWorker;
+
+/**
+ * @brief Runs one pass of a batch update over the updates assigned to
+ * the param worker.
+ *
+ * @param ptr_worker The _BucketUpdateWorker to run.
+ * @return void* Always NULL.
+ */
+static void* _run_bucket_update_worker(void* ptr_worker) {
+    _BucketUpdateWorker* worker = (_BucketUpdateWorker*)ptr_worker;
+    BucketStructure* buckets = worker->buckets;
+    int key_current = bucket_structure_get_current_key(buckets);
+
+    for (int i = worker->idx_begin; i < worker->idx_end; i++) {
+        int element = worker->elements[i];
+
+        if (worker->is_scatter_pass) {
+            int idx_count = worker->destinations[i];
+
+            if (idx_count < 0) {
+                continue;
+            }
+
+            Bucket* bucket = idx_count == 0 ? &buckets->overflow : &buckets->open[idx_count - 1];
+            bucket->elements[worker->offsets[idx_count]++] = element;
+            continue;
+        }
+
+        assert(buckets->is_extracted[element] == false);
+
+        int old_key = buckets->keys[element];
+        int new_key = max(worker->new_keys[i], key_current);
+        int idx_old = _get_bucket_index(buckets, old_key);
+        int idx_new = _get_bucket_index(buckets, new_key);
+
+        buckets->keys[element] = new_key;
+
+        // An element that stays in the overflow bucket keeps its
+        // entry there.
+        if (new_key == old_key || (idx_old < 0 && idx_new < 0)) {
+            worker->destinations[i] = -1;
+            continue;
+        }
+
+        worker->destinations[i] = idx_new + 1;
+        worker->counts[idx_new + 1]++;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Runs the param workers, on their own threads if there are
+ * more than one.
+ *
+ * @param workers The workers to run.
+ * @param num_threads The number of workers.
+ */
+static void _run_bucket_update_workers(_BucketUpdateWorker* workers, int num_threads) {
+    if (num_threads == 1) {
+        _run_bucket_update_worker(&workers[0]);
+        return;
+    }
+
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+
+    for (int t = 0; t < num_threads; t++) {
+        int status = pthread_create(&threads[t], NULL, _run_bucket_update_worker, &workers[t]);
+        assert(status == 0);
+        (void)status;
+    }
+
+    for (int t = 0; t < num_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    free(threads);
+}
+
+// End Helper Functions
+// Begin Create and Delete Functions
+
+/**
+ * @brief Creates a new BucketStructure holding the elements 0 to
+ * num_elements - 1.
+ *
+ * @param num_elements The number of elements.
+ * @param keys The initial non-negative key of each element. Copied.
+ * @param num_open The number of buckets in the window.
+ * @return BucketStructure* A pointer to the new BucketStructure.
+ */
+BucketStructure* bucket_structure_new(int num_elements, int* keys, int num_open) {
+    assert(num_elements >= 0);
+    assert(num_elements == 0 || keys != NULL);
+    assert(num_open > 0);
+
+    BucketStructure* buckets = malloc(sizeof(BucketStructure));
+    buckets->num_elements = num_elements;
+    buckets->num_remaining = num_elements;
+    buckets->num_open = num_open;
+    buckets->key_begin = 0;
+    buckets->idx_current = 0;
+    buckets->num_entries = 0;
+
+    buckets->keys = malloc(max(num_elements, 1) * sizeof(int));
+    buckets->is_extracted = calloc(max(num_elements, 1), sizeof(bool));
+    buckets->open = calloc(num_open, sizeof(Bucket));
+    buckets->overflow = (Bucket){0, 0, NULL};
+    buckets->batch = (Bucket){0, 0, NULL};
+
+    if (num_elements > 0) {
+        memcpy(buckets->keys, keys, num_elements * sizeof(int));
+        buckets->key_begin = keys[0];
+    }
+
+    for (int i = 0; i < num_elements; i++) {
+        assert(keys[i] >= 0);
+        buckets->key_begin = min(buckets->key_begin, keys[i]);
+    }
+
+    for (int i = 0; i < num_elements; i++) {
+        _place(buckets, i);
+    }
+
+    return buckets;
+}
+
+/**
+ * @brief Deletes the param bucket structure and all associated
+ * memory. The pointer to the bucket structure is set to NULL.
+ *
+ * @param ptr_buckets A pointer to the bucket structure.
+ */
+void bucket_structure_delete(BucketStructure** ptr_buckets) {
+    assert(ptr_buckets != NULL);
+    assert(*ptr_buckets != NULL);
+
+    BucketStructure* buckets = *ptr_buckets;
+
+    for (int i = 0; i < buckets->num_open; i++) {
+        free(buckets->open[i].elements);
+    }
+
+    free(buckets->open);
+    free(buckets->overflow.elements);
+    free(buckets->batch.elements);
+    free(buckets->keys);
+    free(buckets->is_extracted);
+    free(buckets);
+    *ptr_buckets = NULL;
+}
+
+// End Create and Delete Functions
+// Begin Manipulation Functions
+
+/**
+ * @brief Extracts every element in the lowest non-empty bucket.
+ *
+ * The bucket is swapped with the batch buffer rather than copied, so
+ * elements moved into the current bucket while the batch is processed
+ * are kept apart from it and returned by the next call.
+ *
+ * @param buckets The bucket structure.
+ * @param ptr_batch Set to the extracted elements. Owned by the bucket
+ * structure and valid until the next call.
+ * @param ptr_key Set to the key of the extracted elements.
+ * @return int The number of extracted elements, or 0 once every
+ * element has been extracted.
+ */
+int bucket_structure_next_batch(BucketStructure* buckets, int** ptr_batch, int* ptr_key) {
+    assert(buckets != NULL);
+    assert(ptr_batch != NULL);
+    assert(ptr_key != NULL);
+
+    while (buckets->num_remaining > 0) {
+        while (buckets->idx_current < buckets->num_open && buckets->open[buckets->idx_current].size == 0) {
+            buckets->idx_current++;
+        }
+
+        if (buckets->idx_current == buckets->num_open) {
+            _advance_window(buckets);
+            continue;
+        }
+
+        int key = bucket_structure_get_current_key(buckets);
+        Bucket extracted = buckets->open[buckets->idx_current];
+        buckets->open[buckets->idx_current] = buckets->batch;
+        buckets->open[buckets->idx_current].size = 0;
+        buckets->batch = extracted;
+        buckets->num_entries -= extracted.size;
+
+        // Drop the entries of elements that have moved or were
+        // already extracted through a duplicate entry.
+        int num_live = 0;
+        for (int i = 0; i < extracted.size; i++) {
+            int element = extracted.elements[i];
+
+            if (buckets->is_extracted[element] || buckets->keys[element] != key) {
+                continue;
+            }
+
+            buckets->is_extracted[element] = true;
+            buckets->batch.elements[num_live++] = element;
+        }
+
+        buckets->batch.size = num_live;
+
+        if (num_live > 0) {
+            buckets->num_remaining -= num_live;
+            *ptr_batch = buckets->batch.elements;
+            *ptr_key = key;
+            return num_live;
+        }
+    }
+
+    *ptr_batch = NULL;
+    return 0;
+}
+
+/**
+ * @brief Lowers the key of the param element by one, unless it is
+ * already at the key of the current bucket.
+ *
+ * @param buckets The bucket structure.
+ * @param element An element that has not been extracted.
+ * @return int The new key of the element.
+ */
+int bucket_structure_decrement(BucketStructure* buckets, int element) {
+    assert(buckets != NULL);
+    assert(element >= 0 && element < buckets->num_elements);
+    assert(buckets->is_extracted[element] == false);
+
+    int key = buckets->keys[element];
+
+    if (key <= bucket_structure_get_current_key(buckets)) {
+        return key;
+    }
+
+    buckets->keys[element] = key - 1;
+
+    // Compacting places the element in its new bucket.
+    if (_should_compact(buckets)) {
+        _compact(buckets);
+        return key - 1;
+    }
+
+    // An element that stays past the window keeps its entry in the
+    // overflow bucket.
+    int idx_bucket = _get_bucket_index(buckets, key - 1);
+    if (idx_bucket >= 0) {
+        _bucket_append(&buckets->open[idx_bucket], element);
+        buckets->num_entries++;
+    }
+
+    return key - 1;
+}
+
+/**
+ * @brief Sets the keys of a batch of elements, splitting the batch
+ * across threads.
+ *
+ * Every thread sets the keys of a contiguous range of the batch and
+ * counts the entries it appends to each bucket. The counts are prefix
+ * summed over the threads per bucket, each bucket is grown once, and
+ * every thread then writes its entries at its own offsets, so no
+ * locks or atomics are needed.
+ *
+ * @param buckets The bucket structure.
+ * @param elements The distinct elements to update, none of which has
+ * been extracted.
+ * @param new_keys The new key of each element. Keys below the key of
+ * the current bucket are raised to it.
+ * @param num_updates The number of elements to update.
+ * @param num_threads The maximum number of threads to use.
+ */
+void bucket_structure_update_batch(BucketStructure* buckets, int* elements, int* new_keys, int num_updates, int num_threads) {
+    assert(buckets != NULL);
+    assert(num_updates == 0 || (elements != NULL && new_keys != NULL));
+    assert(num_threads > 0);
+
+    num_threads = max(min(num_threads, num_updates / BUCKET_MIN_UPDATES_PER_THREAD), 1);
+
+    int num_counts = buckets->num_open + 1;
+    int* destinations = malloc(max(num_updates, 1) * sizeof(int));
+    int* counts = calloc(num_threads * num_counts, sizeof(int));
+    _BucketUpdateWorker* workers = malloc(num_threads * sizeof(_BucketUpdateWorker));
+
+    for (int t = 0; t < num_threads; t++) {
+        workers[t].buckets = buckets;
+        workers[t].elements = elements;
+        workers[t].new_keys = new_keys;
+        workers[t].destinations = destinations;
+        workers[t].idx_begin = (int)((long)num_updates * t / num_threads);
+        workers[t].idx_end = (int)((long)num_updates * (t + 1) / num_threads);
+        workers[t].is_scatter_pass = false;
+        workers[t].counts = &counts[t * num_counts];
+        workers[t].offsets = workers[t].counts;
+    }
+
+    _run_bucket_update_workers(workers, num_threads);
+
+    // Turn the counts of each thread into its write offsets.
+    for (int idx_count = 0; idx_count < num_counts; idx_count++) {
+        Bucket* bucket = idx_count == 0 ? &buckets->overflow : &buckets->open[idx_count - 1];
+        int offset = bucket->size;
+
+        for (int t = 0; t < num_threads; t++) {
+            int count = counts[t * num_counts + idx_count];
+            counts[t * num_counts + idx_count] = offset;
+            offset += count;
+        }
+
+        _bucket_reserve(bucket, offset);
+        buckets->num_entries += offset - bucket->size;
+        bucket->size = offset;
+    }
+
+    for (int t = 0; t < num_threads; t++) {
+        workers[t].is_scatter_pass = true;
+    }
+
+    _run_bucket_update_workers(workers, num_threads);
+
+    if (_should_compact(buckets)) {
+        _compact(buckets);
+    }
+
+    free(destinations);
+    free(counts);
+    free(workers);
+}
+
+// End Manipulation Functions
+// Begin Utility Functions
+
+/**
+ * @brief Gets the key of the current bucket. No key is ever lowered
+ * below it.
+ *
+ * @param buckets The bucket structure.
+ * @return int The key of the current bucket.
+ */
+int bucket_structure_get_current_key(BucketStructure* buckets) {
+    assert(buckets != NULL);
+
+    return buckets->key_begin + buckets->idx_current;
+}
+
+/**
+ * @brief Checks if every element has been extracted.
+ *
+ * @param buckets The bucket structure.
+ * @return true If every element has been extracted.
+ * @return false Otherwise.
+ */
+bool bucket_structure_is_empty(BucketStructure* buckets) {
+    assert(buckets != NULL);
+
+    return buckets->num_remaining == 0;
+}
+
+// End Utility Functions
@@ -0,0 +1,65 @@
+#ifndef BUCKET_STRUCTURE_H_INCLUDED
+#define BUCKET_STRUCTURE_H_INCLUDED
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../utilities/array_util.h"
+
+// The number of open buckets used by the peeling algorithms.
+#define BUCKET_NUM_OPEN_DEFAULT 128
+
+// The minimum number of updates per thread before a batch update is
+// split across threads.
+#define BUCKET_MIN_UPDATES_PER_THREAD 4096
+
+// The buckets are compacted once they hold this many entries per
+// element.
+#define BUCKET_COMPACTION_FACTOR 2
+
+typedef struct Bucket {
+    int size;
+    int capacity;
+    int* elements;
+} Bucket;
+
+// Open bucket i holds the elements with key key_begin + i and the
+// overflow bucket holds every element with a larger key. Buckets are
+// filled lazily, so a bucket may hold stale entries for elements that
+// have since moved to a lower bucket or have been extracted. Stale
+// entries are dropped when their bucket is extracted, or all at once
+// when num_entries reaches BUCKET_COMPACTION_FACTOR * num_elements.
+typedef struct BucketStructure {
+    int num_elements;
+    int num_remaining;
+    int num_open;
+    int key_begin;
+    int idx_current;
+    long num_entries;
+
+    int* keys;
+    bool* is_extracted;
+
+    Bucket* open;
+    Bucket overflow;
+    Bucket batch;
+} BucketStructure;
+
+// Create and Delete Functions
+BucketStructure* bucket_structure_new(int num_elements, int* keys, int num_open);
+void bucket_structure_delete(BucketStructure** ptr_buckets);
+
+// Manipulation Functions
+int bucket_structure_next_batch(BucketStructure* buckets, int** ptr_batch, int* ptr_key);
+int bucket_structure_decrement(BucketStructure* buckets, int element);
+void bucket_structure_update_batch(BucketStructure* buckets, int* elements, int* new_keys, int num_updates, int num_threads);
+
+// Utility Functions
+int bucket_structure_get_current_key(BucketStructure* buckets);
+bool bucket_structure_is_empty(BucketStructure* buckets);
+
+#endif
@@ -28,25 +28,142 @@ int _compare_cliques(clique clique_a, clique clique_b, int k) {
     return 0;
 }
 
+// The clique size used by _compare_cliques_qsort, since qsort passes
+// no context to the comparator.
+static _Thread_local int _qsort_k;
+
+/**
+ * @brief Compares two cliques of size _qsort_k for qsort.
+ */
+static int _compare_cliques_qsort(const void* clique_a, const void* clique_b) {
+    return _compare_cliques((clique)clique_a, (clique)clique_b, _qsort_k);
+}
+
+/**
+ * @brief Sorts the vertices of the param clique in ascending order.
+ * Cliques are small, so insertion sort is used.
+ */
+static inline void _sort_clique(clique clique_to_sort, int k) {
+    for (int i = 1; i < k; i++) {
+        vertex val = clique_to_sort[i];
+        int j = i - 1;
+
+        while (j >= 0 && clique_to_sort[j] > val) {
+            clique_to_sort[j + 1] = clique_to_sort[j];
+            j--;
+        }
+
+        clique_to_sort[j + 1] = val;
+    }
+}
+
+/**
+ * @brief Hashes the vertices of a sorted clique.
+ */
+static inline uint64_t _hash_clique(clique clique_to_hash, int k) {
+    uint64_t hash = 0x9E3779B97F4A7C15ULL;
+
+    for (int i = 0; i < k; i++) {
+        hash ^= (uint32_t)clique_to_hash[i];
+        hash *= 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 33;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Returns the slot of the hash table holding the param sorted
+ * clique, or the empty slot where it would be inserted.
+ *
+ * The table uses linear probing, and every slot holds the index of a
+ * clique in the buffer or -1 if it is empty.
+ */
+static inline int _find_slot(CliqueSet* clique_set, clique clique_to_find) {
+    int mask = clique_set->num_slots - 1;
+    int idx_slot = _hash_clique(clique_to_find, clique_set->k) & mask;
+
+    while (clique_set->slots[idx_slot] != -1) {
+        if (_compare_cliques(clique_to_find, clique_set_get(clique_set, clique_set->slots[idx_slot]), clique_set->k) == 0) {
+            break;
+        }
+
+        idx_slot = (idx_slot + 1) & mask;
+    }
+
+    return idx_slot;
+}
+
+/**
+ * @brief Rebuilds the hash table with param num_slots slots, which
+ * must be a power of two larger than the size of the set.
+ */
+static void _rebuild_slots(CliqueSet* clique_set, int num_slots) {
+    free(clique_set->slots);
+
+    clique_set->num_slots = num_slots;
+    clique_set->slots = malloc(num_slots * sizeof(int));
+    memset(clique_set->slots, -1, num_slots * sizeof(int));
+
+    for (int i = 0; i < clique_set->size; i++) {
+        clique_set->slots[_find_slot(clique_set, clique_set_get(clique_set, i))] = i;
+    }
+}
+
+/**
+ * @brief Grows the buffer of the clique set geometrically until it
+ * can hold at least param min_capacity cliques, keeping the hash
+ * table at most half full.
+ */
+static void _reserve(CliqueSet* clique_set, int min_capacity) {
+    if (min_capacity > clique_set->capacity) {
+        int capacity = max(clique_set->capacity, 1);
+        while (capacity < min_capacity) {
+            capacity *= 2;
+        }
+
+        clique_set->capacity = capacity;
+        clique_set->elements = realloc(clique_set->elements, (size_t)capacity * clique_set->k * sizeof(vertex));
+        assert(clique_set->elements != NULL);
+    }
+
+    if (2 * min_capacity > clique_set->num_slots) {
+        int num_slots = clique_set->num_slots;
+        while (2 * min_capacity > num_slots) {
+            num_slots *= 2;
+        }
+
+        _rebuild_slots(clique_set, num_slots);
+    }
+}
+
 /**
  * @brief Create a new CliqueSet object.
  *
  * @param k The size of each clique in the set.
- * @param resize_value The resize amount is the value by which
- * the capacity of the queue is increased or decreased when the queue
- * is full or empty, respectively.
+ * @param initial_capacity The number of cliques the set can hold
+ * before its buffer first grows. The buffer doubles whenever it is
+ * full.
  * @return CliqueSet* The new clique set.
  */
-CliqueSet* clique_set_new(int k, int resize_value) {
+CliqueSet* clique_set_new(int k, int initial_capacity) {
     assert(k > 0);
-    assert(resize_value > 0);
+    assert(initial_capacity > 0);
 
     CliqueSet* clique_set = malloc(sizeof(CliqueSet));
     clique_set->k = k;
     clique_set->size = 0;
-    clique_set->capacity = resize_value;
-    clique_set->resize_value = resize_value;
-    clique_set->cliques = malloc(sizeof(clique) * clique_set->resize_value);
+    clique_set->capacity = initial_capacity;
+    clique_set->elements = malloc((size_t)initial_capacity * k * sizeof(vertex));
+    clique_set->is_sorted = true;
+
+    int num_slots = 2;
+    while (num_slots < 2 * initial_capacity) {
+        num_slots *= 2;
+    }
+
+    clique_set->slots = NULL;
+    _rebuild_slots(clique_set, num_slots);
 
     return clique_set;
 }
@@ -54,28 +171,20 @@ CliqueSet* clique_set_new(int k, int resize_value) {
 /**
  * @brief Create a deep copy of a CliqueSet object.
  *
- * The function creates a new clique size with the same k and resize
- * value as the original clique set. The function then copies each
- * clique in the original clique set into the new clique set by
- * iterating through the set and copying each clique into the new
- * array and inserting the new clique set into the new clique set.
- *
  * @param clique_set The clique set to copy.
  * @return CliqueSet* The deep copy of the clique set.
  */
 CliqueSet* clique_set_copy(CliqueSet* clique_set) {
     assert(clique_set != NULL);
 
-    CliqueSet* copy = clique_set_new(clique_set->k, clique_set->resize_value);
-    copy->cliques = realloc(copy->cliques, sizeof(clique) * clique_set->capacity);
-    assert(copy->cliques != NULL);
+    CliqueSet* copy = malloc(sizeof(CliqueSet));
+    memcpy(copy, clique_set, sizeof(CliqueSet));
 
-    for (int i = 0; i < clique_set->size; i++) {
-        clique curr_clique = clique_set->cliques[i];
-        clique copy_clique = malloc(sizeof(int) * clique_set->k);
-        memcpy(copy_clique, curr_clique, sizeof(vertex) * clique_set->k);
-        copy->cliques[i] = copy_clique;
-    }
+    copy->elements = malloc((size_t)clique_set->capacity * clique_set->k * sizeof(vertex));
+    memcpy(copy->elements, clique_set->elements, (size_t)clique_set->size * clique_set->k * sizeof(vertex));
+
+    copy->slots = malloc(clique_set->num_slots * sizeof(int));
+    memcpy(copy->slots, clique_set->slots, clique_set->num_slots * sizeof(int));
 
     return copy;
 }
@@ -83,9 +192,7 @@ CliqueSet* clique_set_copy(CliqueSet* clique_set) {
 /**
  * @brief Delete a CliqueSet object and all associated memory.
  *
- * This function deletes all cliques in the clique set and then
- * deletes the array of cliques and the clique set itself. The pointer
- * to the clique set is set to NULL.
+ * The pointer to the clique set is set to NULL.
  *
  * @param ptr_clique_set A pointer to the clique set to delete.
  */
@@ -93,13 +200,8 @@ void clique_set_delete(CliqueSet** ptr_clique_set) {
     assert(ptr_clique_set != NULL);
     assert(*ptr_clique_set != NULL);
 
-    CliqueSet* clique_set = *ptr_clique_set;
-
-    for (int i = 0; i < clique_set->size; i++) {
-        free(clique_set->cliques[i]);
-    }
-
-    free(clique_set->cliques);
+    free((*ptr_clique_set)->elements);
+    free((*ptr_clique_set)->slots);
     free(*ptr_clique_set);
 
     *ptr_clique_set = NULL;
@@ -108,13 +210,13 @@ void clique_set_delete(CliqueSet** ptr_clique_set) {
 /**
  * @brief Insert a clique into a clique set.
  *
- * Since each clique is ordered, binary sort is used to find the
- * correct position to insert the clique. If the clique is already
- * in the clique set, the function returns false. Otherwise, the
- * clique is inserted into the clique set and the function returns
- * true. Note, although the look up is O(log(n)), the insert is
- * O(n) since the array must be shifted to make room for the new
- * clique.
+ * The param clique is sorted in place then looked up in the hash
+ * table of the set. If the clique is already in the clique set, the
+ * function returns false. Otherwise, the clique is copied to the end
+ * of the buffer, so the caller keeps ownership of it, and the
+ * function returns true. Each insert is O(k) expected, but the
+ * cliques are kept in insertion order until clique_set_finalize is
+ * called.
  *
  * @param clique_set The clique set to insert the clique into.
  * @param clique_to_insert The clique to insert into the clique set.
@@ -125,71 +227,140 @@ bool clique_set_insert(CliqueSet* clique_set, clique clique_to_insert) {
     assert(clique_set != NULL);
     assert(clique_to_insert != NULL);
 
+    int k = clique_set->k;
+
     // clique[0] < clique[1] < ... < clique[k]
-    // Necessary to ensure the clique set is sorted for binary search
-    // Binary search used for insert and membership operations
-    qsort(clique_to_insert, clique_set->k, sizeof(int), cmp_ints_asc);
-
-    // If the clique set is full, resize the clique set to make room
-    // for the new clique.
-    if (clique_set->size == clique_set->capacity) {
-        clique_set->capacity += clique_set->resize_value;
-        clique_set->cliques = realloc(clique_set->cliques, sizeof(clique_to_insert) * clique_set->capacity);
-        assert(clique_set->cliques != NULL);
+    // Necessary so every ordering of the vertices hashes the same
+    _sort_clique(clique_to_insert, k);
+
+    int idx_slot = _find_slot(clique_set, clique_to_insert);
+    if (clique_set->slots[idx_slot] != -1) {
+        return false;
     }
 
-    // If the clique set is empty, insert the clique at the first
-    // position.
-    if (clique_set->size == 0) {
-        clique_set->cliques[0] = clique_to_insert;
-        clique_set->size++;
-        return true;
+    // Growing may rebuild the table, which moves the empty slot.
+    if (clique_set->size == clique_set->capacity || 2 * (clique_set->size + 1) > clique_set->num_slots) {
+        _reserve(clique_set, clique_set->size + 1);
+        idx_slot = _find_slot(clique_set, clique_to_insert);
     }
 
-    // Binary search to find the correct position to insert the clique
-    int idx_lower_bound = 0;
-    int idx_upper_bound = clique_set->size - 1;
+    // The set stays sorted as long as cliques arrive in order.
+    if (clique_set->is_sorted && clique_set->size > 0) {
+        clique_set->is_sorted = _compare_cliques(clique_set_get(clique_set, clique_set->size - 1), clique_to_insert, k) < 0;
+    }
 
-    while (idx_lower_bound <= idx_upper_bound) {
-        int idx_middle = (idx_lower_bound + idx_upper_bound) / 2;
-        clique curr_clique = clique_set->cliques[idx_middle];
+    memcpy(&clique_set->elements[(size_t)clique_set->size * k], clique_to_insert, k * sizeof(vertex));
+    clique_set->slots[idx_slot] = clique_set->size;
+    clique_set->size++;
 
-        int comparison = _compare_cliques(clique_to_insert, curr_clique, clique_set->k);
+    return true;
+}
 
-        if (comparison == 0) {
-            return false;
-        }
+/**
+ * @brief Inserts a copy of the param clique into the clique set
+ * passed as param ptr_clique_set, leaving the param clique untouched.
+ *
+ * This matches the record signature of enumerate_k_cliques_callback.
+ *
+ * @param ptr_clique_set The CliqueSet of k-cliques.
+ * @param clique_to_record The clique to insert.
+ * @param k The size of the clique.
+ */
+void clique_set_record(void* ptr_clique_set, clique clique_to_record, int k) {
+    assert(ptr_clique_set != NULL);
+    assert(((CliqueSet*)ptr_clique_set)->k == k);
 
-        if (comparison == -1) {
-            idx_upper_bound = idx_middle - 1;
-        } else {
-            idx_lower_bound = idx_middle + 1;
-        }
+    vertex clique_copy[k];
+    memcpy(clique_copy, clique_to_record, k * sizeof(vertex));
+    clique_set_insert(ptr_clique_set, clique_copy);
+}
+
+/**
+ * @brief Inserts every clique of the param buffer into a clique set.
+ *
+ * The buffer holds num_cliques cliques back to back, as in the set
+ * itself, and every clique is sorted in place. Room for the whole
+ * batch is reserved once, then each clique is inserted as in
+ * clique_set_insert.
+ *
+ * @param clique_set The clique set to insert the cliques into.
+ * @param cliques The cliques to insert.
+ * @param num_cliques The number of cliques in the buffer.
+ */
+void clique_set_insert_batch(CliqueSet* clique_set, vertex* cliques, int num_cliques) {
+    assert(clique_set != NULL);
+    assert(cliques != NULL || num_cliques == 0);
+
+    _reserve(clique_set, clique_set->size + num_cliques);
+
+    for (int i = 0; i < num_cliques; i++) {
+        clique_set_insert(clique_set, &cliques[(size_t)i * clique_set->k]);
     }
+}
+
+/**
+ * @brief Sorts the cliques of a clique set in lexicographic order.
+ *
+ * Sorting once after all inserts is O(n * log(n)), instead of keeping
+ * the buffer sorted on every insert. The indices of the cliques
+ * change, so views and indices taken before are invalidated.
+ *
+ * @param clique_set The clique set to sort.
+ */
+void clique_set_finalize(CliqueSet* clique_set) {
+    assert(clique_set != NULL);
 
-    // If the clique is to be inserted in the middle of the clique
-    // set, shift the array to make room for the new clique.
-    if (idx_lower_bound < clique_set->size) {
-        int num_cliques_to_move = clique_set->size - idx_lower_bound;
-        int num_bytes_to_move = sizeof(clique) * num_cliques_to_move;
-        clique* src = &clique_set->cliques[idx_lower_bound];
-        clique* dst = &clique_set->cliques[idx_lower_bound + 1];
-        memmove(dst, src, num_bytes_to_move);
+    if (clique_set->is_sorted) {
+        return;
     }
 
-    // Insert the clique into the clique set and increment the size.
-    clique_set->cliques[idx_lower_bound] = clique_to_insert;
-    clique_set->size++;
-    return true;
+    _qsort_k = clique_set->k;
+    qsort(clique_set->elements, clique_set->size, clique_set->k * sizeof(vertex), _compare_cliques_qsort);
+
+    _rebuild_slots(clique_set, clique_set->num_slots);
+    clique_set->is_sorted = true;
+}
+
+/**
+ * @brief Returns a view of a clique in a clique set. The view points
+ * into the set's buffer and is invalidated by any insertion.
+ *
+ * @param clique_set The clique set.
+ * @param idx_clique The index of the clique.
+ * @return clique The sorted vertices of the clique.
+ */
+clique clique_set_get(CliqueSet* clique_set, int idx_clique) {
+    assert(clique_set != NULL);
+    assert(idx_clique >= 0 && idx_clique < clique_set->size);
+
+    return &clique_set->elements[(size_t)idx_clique * clique_set->k];
+}
+
+/**
+ * @brief Finds the index of a clique in a clique set.
+ *
+ * The param clique must already be sorted in ascending order. The
+ * clique is looked up in the hash table in O(k) expected time.
+ *
+ * @param clique_set The clique set to search.
+ * @param clique_to_find The sorted clique to search for.
+ * @return int The index of the clique in the clique set if it
+ * exists, otherwise -1.
+ */
+int clique_set_find(CliqueSet* clique_set, clique clique_to_find) {
+    assert(clique_set != NULL);
+    assert(clique_to_find != NULL);
+
+    return clique_set->slots[_find_slot(clique_set, clique_to_find)];
 }
 
 /**
  * @brief Frees all unused memory in a clique set.
  *
- * Since the resize amount can be larger than 1, it is possible
- * that the clique set has unused memory. This function frees
- * the unused memory and sets the capacity to the current size of the
- * clique set.
+ * Since the buffer grows geometrically, it is possible that the
+ * clique set has unused memory. This function frees the unused memory
+ * and sets the capacity to the current size of the clique set. The
+ * hash table is kept, so the set can still be searched.
  *
  * @param clique_set The clique set to free unused memory from.
  */
@@ -198,15 +369,23 @@ void clique_set_fit(CliqueSet* clique_set) {
 
     // If the clique set is already at capacity, then there is no
     // unused memory to free.
-    if (clique_set->size == clique_set->capacity) {
+    if (clique_set->size == clique_set->capacity || clique_set->size == 0) {
         return;
     }
 
     clique_set->capacity = clique_set->size;
-    clique_set->cliques = realloc(clique_set->cliques, sizeof(clique) * clique_set->capacity);
-    assert(clique_set->cliques != NULL);
+    clique_set->elements = realloc(clique_set->elements, (size_t)clique_set->capacity * clique_set->k * sizeof(vertex));
+    assert(clique_set->elements != NULL);
 }
 
+/**
+ * @brief Checks whether two clique sets hold the same cliques, in any
+ * order.
+ *
+ * @param clique_set_a
+ * @param clique_set_b
+ * @return bool True if the sets are equal, false otherwise.
+ */
 bool clique_set_is_equal(CliqueSet* clique_set_a, CliqueSet* clique_set_b) {
     if (clique_set_a == NULL && clique_set_b == NULL) {
         return true;
@@ -216,18 +395,12 @@ bool clique_set_is_equal(CliqueSet* clique_set_a, CliqueSet* clique_set_b) {
         return false;
     }
 
-    if (clique_set_a->size != clique_set_b->size) {
+    if (clique_set_a->k != clique_set_b->k || clique_set_a->size != clique_set_b->size) {
         return false;
     }
 
     for (int i = 0; i < clique_set_a->size; i++) {
-        clique clique_a = clique_set_a->cliques[i];
-        clique clique_b = clique_set_b->cliques[i];
-
-        assert(clique_a != NULL);
-        assert(clique_b != NULL);
-
-        if (memcmp(clique_a, clique_b, sizeof(int) * clique_set_a->k) != 0) {
+        if (clique_set_find(clique_set_b, clique_set_get(clique_set_a, i)) == -1) {
             return false;
         }
     }
@@ -247,7 +420,7 @@ void clique_set_print(CliqueSet* clique_set, bool should_print_newline) {
     printf("Cliques: { Size: %d, Elements: [", clique_set->size);
     for (int i = 0; i < clique_set->size; i++) {
         printf("(");
-        array_print(clique_set->cliques[i], clique_set->k, false);
+        array_print(clique_set_get(clique_set, i), clique_set->k, false);
 
         if (i == clique_set->size - 1) {
             printf(")");
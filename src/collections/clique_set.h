@@ -3,27 +3,43 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 #include "../utilities/array_util.h"
 #include "graph.h"
 
+// The cliques are stored back to back in one buffer, so clique i is
+// elements[i * k] to elements[i * k + k - 1]. The cliques are kept in
+// insertion order and deduplicated with an open addressing hash table
+// of num_slots slots, each holding the index of a clique or -1.
 typedef struct CliqueSet {
     int k;
     int size;
     int capacity;
-    int resize_value;
-    clique* cliques;
+    vertex* elements;
+
+    int num_slots;
+    int* slots;
+
+    // True if the cliques are in lexicographic order.
+    bool is_sorted;
 } CliqueSet;
 
-CliqueSet* clique_set_new(int k, int resize_value);
+CliqueSet* clique_set_new(int k, int initial_capacity);
 CliqueSet* clique_set_copy(CliqueSet* clique_set);
 void clique_set_delete(CliqueSet** ptr_clique_set);
 
 bool clique_set_insert(CliqueSet* clique_set, clique clique);
+void clique_set_record(void* ptr_clique_set, clique clique, int k);
+void clique_set_insert_batch(CliqueSet* clique_set, vertex* cliques, int num_cliques);
+void clique_set_finalize(CliqueSet* clique_set);
+clique clique_set_get(CliqueSet* clique_set, int idx_clique);
+int clique_set_find(CliqueSet* clique_set, clique clique);
+void clique_set_fit(CliqueSet* clique_set);
 void clique_set_print(CliqueSet* clique_set, bool should_print_newline);
 void clique_set_print_n(CliqueSet* clique_set);
 
 bool clique_set_is_equal(CliqueSet* clique_set_a, CliqueSet* clique_set_b);
-#endif
\ No newline at end of file
+#endif
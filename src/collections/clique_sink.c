@@ -0,0 +1,210 @@
+#include "clique_sink.h"
+
+/**
+ * This class contains a sink that receives cliques from the
+ * enumeration functions in fixed size batches, instead of one
+ * callback per clique. Each batch is stored by vertex position, so
+ * consumers process it with tight loops over contiguous arrays.
+ */
+
+// Begin Built-in Consumer Functions
+
+/**
+ * @brief Adds the number of cliques of the batch to the long passed
+ * as param ptr_count.
+ */
+static void _consume_count(void* ptr_count, vertex* columns, int k, int num_cliques) {
+    (void)columns;
+    (void)k;
+    *(long*)ptr_count += num_cliques;
+}
+
+/**
+ * @brief Inserts every clique of the batch into the clique set passed
+ * as param ptr_clique_set.
+ */
+static void _consume_store(void* ptr_clique_set, vertex* columns, int k, int num_cliques) {
+    vertex cliques[CLIQUE_SINK_BATCH_SIZE * k];
+
+    for (int i = 0; i < k; i++) {
+        vertex* column = &columns[i * CLIQUE_SINK_BATCH_SIZE];
+
+        for (int j = 0; j < num_cliques; j++) {
+            cliques[j * k + i] = column[j];
+        }
+    }
+
+    clique_set_insert_batch(ptr_clique_set, cliques, num_cliques);
+}
+
+/**
+ * @brief Adds one to the count of every vertex of every clique of the
+ * batch, where the counts are passed as param vertex_counts.
+ */
+static void _consume_vertex_count(void* vertex_counts, vertex* columns, int k, int num_cliques) {
+    long* counts = vertex_counts;
+
+    for (int i = 0; i < k; i++) {
+        vertex* column = &columns[i * CLIQUE_SINK_BATCH_SIZE];
+
+        for (int j = 0; j < num_cliques; j++) {
+            counts[column[j]]++;
+        }
+    }
+}
+
+/**
+ * @brief Writes every clique of the batch on its own line of the file
+ * passed as param file, with the vertices separated by spaces.
+ */
+static void _consume_file(void* file, vertex* columns, int k, int num_cliques) {
+    for (int j = 0; j < num_cliques; j++) {
+        for (int i = 0; i < k; i++) {
+            fprintf(file, i == k - 1 ? "%d\n" : "%d ", columns[i * CLIQUE_SINK_BATCH_SIZE + j]);
+        }
+    }
+}
+
+/**
+ * @brief Flushes the stream of the file sink.
+ */
+static void _finish_file(void* file) {
+    fflush(file);
+}
+
+// End Built-in Consumer Functions
+// Begin Create and Delete Functions
+
+/**
+ * @brief Creates a sink of k-cliques handing each batch to param
+ * consume.
+ *
+ * @param k The size of the cliques.
+ * @param target The first argument of param consume and param finish.
+ * @param consume The function called with the target, the columns,
+ * k, and the number of cliques of each batch.
+ * @param finish The function called with the target after each
+ * flush, or NULL.
+ * @return CliqueSink* The new sink.
+ */
+CliqueSink* clique_sink_new(int k, void* target, void (*consume)(void*, vertex*, int, int), void (*finish)(void*)) {
+    assert(k > 0);
+    assert(consume != NULL);
+
+    CliqueSink* sink = malloc(sizeof(CliqueSink));
+    sink->k = k;
+    sink->num_buffered = 0;
+    sink->columns = malloc((size_t)k * CLIQUE_SINK_BATCH_SIZE * sizeof(vertex));
+    sink->target = target;
+    sink->consume = consume;
+    sink->finish = finish;
+
+    return sink;
+}
+
+/**
+ * @brief Creates a sink adding the number of cliques it receives to
+ * the long at param ptr_count.
+ */
+CliqueSink* clique_sink_new_counter(int k, long* ptr_count) {
+    assert(ptr_count != NULL);
+    return clique_sink_new(k, ptr_count, _consume_count, NULL);
+}
+
+/**
+ * @brief Creates a sink inserting the cliques it receives into param
+ * clique_set.
+ */
+CliqueSink* clique_sink_new_store(CliqueSet* clique_set) {
+    assert(clique_set != NULL);
+    return clique_sink_new(clique_set->k, clique_set, _consume_store, NULL);
+}
+
+/**
+ * @brief Creates a sink adding one to param vertex_counts for every
+ * vertex of every clique it receives.
+ */
+CliqueSink* clique_sink_new_vertex_counter(int k, long* vertex_counts) {
+    assert(vertex_counts != NULL);
+    return clique_sink_new(k, vertex_counts, _consume_vertex_count, NULL);
+}
+
+/**
+ * @brief Creates a sink writing the cliques it receives to param
+ * file, one clique per line. The file is not closed by the sink.
+ */
+CliqueSink* clique_sink_new_file(int k, FILE* file) {
+    assert(file != NULL);
+    return clique_sink_new(k, file, _consume_file, _finish_file);
+}
+
+/**
+ * @brief Flushes then deletes the param sink and all associated
+ * memory. The target is not deleted. The pointer to the sink is set
+ * to NULL.
+ *
+ * @param ptr_sink A pointer to the sink.
+ */
+void clique_sink_delete(CliqueSink** ptr_sink) {
+    assert(ptr_sink != NULL);
+    assert(*ptr_sink != NULL);
+
+    clique_sink_flush(*ptr_sink);
+
+    free((*ptr_sink)->columns);
+    free(*ptr_sink);
+    *ptr_sink = NULL;
+}
+
+// End Create and Delete Functions
+// Begin Batch Functions
+
+/**
+ * @brief Hands the buffered cliques to the consumer and empties the
+ * batch.
+ *
+ * @param sink The sink to consume.
+ */
+void clique_sink_consume_batch(CliqueSink* sink) {
+    assert(sink != NULL);
+
+    if (sink->num_buffered > 0) {
+        sink->consume(sink->target, sink->columns, sink->k, sink->num_buffered);
+        sink->num_buffered = 0;
+    }
+}
+
+/**
+ * @brief Hands the last partial batch to the consumer, then calls the
+ * finish hook. The target is complete once the sink is flushed.
+ *
+ * @param sink The sink to flush.
+ */
+void clique_sink_flush(CliqueSink* sink) {
+    assert(sink != NULL);
+
+    clique_sink_consume_batch(sink);
+
+    if (sink->finish != NULL) {
+        sink->finish(sink->target);
+    }
+}
+
+/**
+ * @brief Pushes the clique into the sink passed as param ptr_sink.
+ *
+ * This matches the record signature of enumerate_k_cliques_callback
+ * and enumerate_k_cliques_ebbkc.
+ *
+ * @param ptr_sink The CliqueSink to push into.
+ * @param clique_to_record The clique to push.
+ * @param k The size of the clique.
+ */
+void clique_sink_record(void* ptr_sink, clique clique_to_record, int k) {
+    assert(ptr_sink != NULL);
+    assert(((CliqueSink*)ptr_sink)->k == k);
+
+    clique_sink_push(ptr_sink, clique_to_record);
+}
+
+// End Batch Functions
@@ -0,0 +1,64 @@
+#ifndef CLIQUE_SINK_H_INCLUDED
+#define CLIQUE_SINK_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "clique_set.h"
+#include "graph.h"
+
+// The number of cliques buffered before the sink is flushed.
+#define CLIQUE_SINK_BATCH_SIZE 256
+
+// The cliques are buffered in structure of arrays layout, so vertex i
+// of buffered clique j is columns[i * CLIQUE_SINK_BATCH_SIZE + j] and
+// each vertex position of a batch is one contiguous array. consume is
+// called with every full batch and with the last partial batch when
+// the sink is flushed, then finish is called, if set, once the sink
+// is flushed.
+typedef struct CliqueSink {
+    int k;
+    int num_buffered;
+    vertex* columns;
+
+    void* target;
+    void (*consume)(void* target, vertex* columns, int k, int num_cliques);
+    void (*finish)(void* target);
+} CliqueSink;
+
+// Create and Delete Functions
+CliqueSink* clique_sink_new(int k, void* target, void (*consume)(void*, vertex*, int, int), void (*finish)(void*));
+CliqueSink* clique_sink_new_counter(int k, long* ptr_count);
+CliqueSink* clique_sink_new_store(CliqueSet* clique_set);
+CliqueSink* clique_sink_new_vertex_counter(int k, long* vertex_counts);
+CliqueSink* clique_sink_new_file(int k, FILE* file);
+void clique_sink_delete(CliqueSink** ptr_sink);
+
+// Batch Functions
+void clique_sink_consume_batch(CliqueSink* sink);
+void clique_sink_flush(CliqueSink* sink);
+void clique_sink_record(void* ptr_sink, clique clique_to_record, int k);
+
+/**
+ * @brief Appends a clique to the current batch of the sink, handing
+ * the batch to the consumer once it is full.
+ *
+ * This is defined in the header so enumeration loops inline the
+ * copy and only make a call once per batch.
+ *
+ * @param sink The sink to push the clique into.
+ * @param clique_to_push The k vertices of the clique.
+ */
+static inline void clique_sink_push(CliqueSink* sink, const vertex* clique_to_push) {
+    for (int i = 0; i < sink->k; i++) {
+        sink->columns[i * CLIQUE_SINK_BATCH_SIZE + sink->num_buffered] = clique_to_push[i];
+    }
+
+    if (++sink->num_buffered == CLIQUE_SINK_BATCH_SIZE) {
+        clique_sink_consume_batch(sink);
+    }
+}
+
+#endif
@@ -1,5 +1,310 @@
 #include "compressed_sparse_row.h"
 
+// Begin Parallel Parser Functions
+
+// Rows with fewer entries than this are insertion sorted.
+#define CSR_INSERTION_SORT_THRESHOLD 16
+
+typedef struct _CsrParseShared {
+    int num_rows;
+    int num_cols;
+    int num_threads;
+    bool is_directed;
+
+    // The entry counts[t * num_threads + r] is the number of entries
+    // parsed by thread t whose row is owned by thread r, and
+    // offsets[t * num_threads + r] is where thread t writes them in
+    // bucketed_entries.
+    int* counts;
+    int* offsets;
+    int* bucketed_entries;
+
+    CompressedSparseRow* csr;
+} _CsrParseShared;
+
+typedef struct _CsrParseWorker {
+    _CsrParseShared* shared;
+    int idx_thread;
+
+    const char* chunk_begin;
+    const char* chunk_end;
+
+    // The parsed edges as (u, v) pairs.
+    int* edges;
+    int num_edges;
+    int capacity_edges;
+
+    // False if a line of the chunk is malformed, or a row built by the
+    // worker lists a vertex twice.
+    bool is_valid;
+} _CsrParseWorker;
+
+/**
+ * @brief Parses the non-negative integer starting at param ptr.
+ *
+ * @param ptr The first digit of the integer.
+ * @param end One past the last readable character.
+ * @param ref_value Set to the parsed integer.
+ * @return const char* One past the last digit of the integer, or NULL
+ * if ptr is not at a digit or the integer is larger than INT_MAX.
+ */
+static inline const char* _parse_int(const char* ptr, const char* end, int* ref_value) {
+    if (ptr == end || *ptr < '0' || *ptr > '9') {
+        return NULL;
+    }
+
+    long value = 0;
+    while (ptr < end && *ptr >= '0' && *ptr <= '9') {
+        value = value * 10 + (*ptr - '0');
+        ptr++;
+
+        if (value > INT_MAX) {
+            return NULL;
+        }
+    }
+
+    *ref_value = (int)value;
+    return ptr;
+}
+
+/**
+ * @brief Skips the spaces, tabs, and carriage returns starting at
+ * param ptr, but not newlines.
+ */
+static inline const char* _skip_blanks(const char* ptr, const char* end) {
+    while (ptr < end && (*ptr == ' ' || *ptr == '\t' || *ptr == '\r')) {
+        ptr++;
+    }
+
+    return ptr;
+}
+
+/**
+ * @brief Returns one past the next newline at or after param ptr, or
+ * param end if there is none.
+ */
+static inline const char* _skip_line(const char* ptr, const char* end) {
+    const char* newline = memchr(ptr, '\n', end - ptr);
+    return newline == NULL ? end : newline + 1;
+}
+
+/**
+ * @brief Returns the thread that owns param idx_row. Thread r owns the
+ * contiguous rows idx_row with idx_row * num_threads / num_rows == r.
+ */
+static inline int _get_row_owner(_CsrParseShared* shared, int idx_row) {
+    return (long)idx_row * shared->num_threads / shared->num_rows;
+}
+
+/**
+ * @brief Returns the first row owned by param idx_thread.
+ */
+static inline int _get_first_owned_row(_CsrParseShared* shared, int idx_thread) {
+    return ((long)idx_thread * shared->num_rows + shared->num_threads - 1) / shared->num_threads;
+}
+
+/**
+ * @brief Runs param function on every worker on its own thread and
+ * waits for all of them to finish.
+ */
+static void _run_parse_workers(_CsrParseWorker* workers, int num_threads, void* (*function)(void*)) {
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+
+    for (int t = 0; t < num_threads; t++) {
+        int status = pthread_create(&threads[t], NULL, function, &workers[t]);
+        assert(status == 0);
+        (void)status;
+    }
+
+    for (int t = 0; t < num_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    free(threads);
+}
+
+/**
+ * @brief Parses the edges of a worker's chunk and counts how many
+ * entries fall in the rows of each owner. Blank lines and lines
+ * starting with '%' or '#' are skipped, and anything after the second
+ * integer on a line is ignored. Parsing stops at the first line that
+ * does not start with two vertices in range or that is a self-loop,
+ * which marks the worker as invalid.
+ */
+static void* _parse_chunk(void* arg) {
+    _CsrParseWorker* worker = arg;
+    _CsrParseShared* shared = worker->shared;
+    int* counts = shared->counts + worker->idx_thread * shared->num_threads;
+
+    const char* ptr = worker->chunk_begin;
+    const char* end = worker->chunk_end;
+
+    while (ptr < end) {
+        ptr = _skip_blanks(ptr, end);
+
+        if (ptr == end) {
+            break;
+        }
+
+        if (*ptr == '\n') {
+            ptr++;
+            continue;
+        }
+
+        if (*ptr == '%' || *ptr == '#') {
+            ptr = _skip_line(ptr, end);
+            continue;
+        }
+
+        int idx_row, idx_col;
+        ptr = _parse_int(ptr, end, &idx_row);
+
+        if (ptr != NULL) {
+            ptr = _parse_int(_skip_blanks(ptr, end), end, &idx_col);
+        }
+
+        // A malformed or out of range vertex would index past the
+        // counts and the rows, so it is an error even without
+        // assertions.
+        if (ptr == NULL || idx_row < 0 || idx_row >= shared->num_rows || idx_col < 0 || idx_col >= shared->num_cols || idx_row == idx_col) {
+            worker->is_valid = false;
+            return NULL;
+        }
+
+        ptr = _skip_line(ptr, end);
+
+        if (worker->num_edges == worker->capacity_edges) {
+            worker->capacity_edges *= 2;
+            worker->edges = realloc(worker->edges, 2 * worker->capacity_edges * sizeof(int));
+        }
+
+        worker->edges[2 * worker->num_edges] = idx_row;
+        worker->edges[2 * worker->num_edges + 1] = idx_col;
+        worker->num_edges++;
+
+        counts[_get_row_owner(shared, idx_row)]++;
+
+        if (shared->is_directed == false) {
+            counts[_get_row_owner(shared, idx_col)]++;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Moves a worker's parsed entries, and the reverse entries if
+ * the graph is undirected, into the bucket of the thread owning their
+ * row. Every worker writes to its own reserved slots, so no
+ * synchronization is needed.
+ */
+static void* _bucket_entries(void* arg) {
+    _CsrParseWorker* worker = arg;
+    _CsrParseShared* shared = worker->shared;
+    int* offsets = shared->offsets + worker->idx_thread * shared->num_threads;
+    int* bucketed_entries = shared->bucketed_entries;
+
+    for (int i = 0; i < worker->num_edges; i++) {
+        int idx_row = worker->edges[2 * i];
+        int idx_col = worker->edges[2 * i + 1];
+
+        int idx_entry = offsets[_get_row_owner(shared, idx_row)]++;
+        bucketed_entries[2 * idx_entry] = idx_row;
+        bucketed_entries[2 * idx_entry + 1] = idx_col;
+
+        if (shared->is_directed == false) {
+            idx_entry = offsets[_get_row_owner(shared, idx_col)]++;
+            bucketed_entries[2 * idx_entry] = idx_col;
+            bucketed_entries[2 * idx_entry + 1] = idx_row;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Builds the rows owned by a worker from its bucket. The
+ * degrees of the owned rows are counted, prefix summed starting from
+ * the first entry of the bucket into the row pointers, then the
+ * entries are scattered into their rows and every row is sorted. The
+ * weight of every entry is set to 1. A row listing a vertex twice
+ * marks the worker as invalid.
+ */
+static void* _build_owned_rows(void* arg) {
+    _CsrParseWorker* worker = arg;
+    _CsrParseShared* shared = worker->shared;
+    CompressedSparseRow* csr = shared->csr;
+    int num_threads = shared->num_threads;
+
+    int idx_row_begin = _get_first_owned_row(shared, worker->idx_thread);
+    int idx_row_end = _get_first_owned_row(shared, worker->idx_thread + 1);
+
+    // The bucket of this thread starts where the last thread's slot of
+    // the previous bucket ended.
+    int idx_entry_begin = worker->idx_thread == 0 ? 0 : shared->offsets[(num_threads - 1) * num_threads + worker->idx_thread - 1];
+    int idx_entry_end = shared->offsets[(num_threads - 1) * num_threads + worker->idx_thread];
+
+    for (int idx_row = idx_row_begin; idx_row < idx_row_end; idx_row++) {
+        csr->ptr_rows[idx_row] = 0;
+    }
+
+    for (int idx_entry = idx_entry_begin; idx_entry < idx_entry_end; idx_entry++) {
+        csr->ptr_rows[shared->bucketed_entries[2 * idx_entry]]++;
+    }
+
+    int* cursors = malloc(max(idx_row_end - idx_row_begin, 1) * sizeof(int));
+    int offset = idx_entry_begin;
+
+    for (int idx_row = idx_row_begin; idx_row < idx_row_end; idx_row++) {
+        int degree = csr->ptr_rows[idx_row];
+        csr->ptr_rows[idx_row] = offset;
+        cursors[idx_row - idx_row_begin] = offset;
+        offset += degree;
+    }
+
+    for (int idx_entry = idx_entry_begin; idx_entry < idx_entry_end; idx_entry++) {
+        int idx_row = shared->bucketed_entries[2 * idx_entry];
+        csr->idx_cols[cursors[idx_row - idx_row_begin]++] = shared->bucketed_entries[2 * idx_entry + 1];
+    }
+
+    free(cursors);
+
+    for (int idx_row = idx_row_begin; idx_row < idx_row_end; idx_row++) {
+        int* row = csr->idx_cols + csr->ptr_rows[idx_row];
+        int len_row = (idx_row + 1 < idx_row_end ? csr->ptr_rows[idx_row + 1] : idx_entry_end) - csr->ptr_rows[idx_row];
+
+        if (len_row < CSR_INSERTION_SORT_THRESHOLD) {
+            for (int i = 1; i < len_row; i++) {
+                int val = row[i];
+                int j = i - 1;
+
+                while (j >= 0 && row[j] > val) {
+                    row[j + 1] = row[j];
+                    j--;
+                }
+
+                row[j + 1] = val;
+            }
+        } else {
+            qsort(row, len_row, sizeof(int), cmp_ints_asc);
+        }
+
+        // Every edge must be listed only once.
+        for (int i = 1; i < len_row; i++) {
+            if (row[i - 1] == row[i]) {
+                worker->is_valid = false;
+            }
+        }
+    }
+
+    for (int idx_entry = idx_entry_begin; idx_entry < idx_entry_end; idx_entry++) {
+        csr->edge_weights[idx_entry] = 1;
+    }
+
+    return NULL;
+}
+
+// End Parallel Parser Functions
 // Begin Create and Delete Functions
 
 /**
@@ -33,6 +338,9 @@ CompressedSparseRow* csr_new(int num_rows, int num_cols, int num_nnzs) {
     csr->idx_cols = calloc(csr->num_nnzs, sizeof(int));
     csr->edge_weights = calloc(csr->num_nnzs, sizeof(int));
 
+    csr->mapped_region = NULL;
+    csr->len_mapped_region = 0;
+
     csr->is_set = false;
 
     return csr;
@@ -79,10 +387,14 @@ CompressedSparseRow* csr_new_from_file(FILE* file, int num_rows, int num_cols, i
 
     for (int idx_nnz = 0; idx_nnz < csr->num_nnzs; idx_nnz++) {
         // Read the next line of the file into the buffer.
-        assert(fgets(buffer, len_buffer, file) != NULL);
+        char* line = fgets(buffer, len_buffer, file);
+        assert(line != NULL);
+        (void)line;
 
         // Parse the row and column indices from the buffer.
-        assert(sscanf(buffer, "%d %d\n", &idx_row, &idx_col) == 2);
+        int num_parsed = sscanf(buffer, "%d %d\n", &idx_row, &idx_col);
+        assert(num_parsed == 2);
+        (void)num_parsed;
 
         // Check that the row and column indices are within range of
         // the valid number of rows and columns.
@@ -219,6 +531,162 @@ CompressedSparseRow* csr_new_from_file(FILE* file, int num_rows, int num_cols, i
     return csr_undirected;
 }
 
+/**
+ * @brief Creates a new CompressedSparseRow object from the edge list
+ * in the param buffer using multiple threads.
+ *
+ * The buffer holds the edge lines of a graph file, usually a memory
+ * mapping of the file past the first two lines. Unlike
+ * csr_new_from_file, the edges may be listed in any order. The buffer
+ * is split into one chunk per thread, where every chunk boundary is
+ * moved forward to the start of the next line, and the rows are split
+ * into one contiguous range per thread. Each thread parses its chunk
+ * and counts its entries per row range. A prefix sum over these counts
+ * reserves disjoint slots, into which each thread moves its entries,
+ * and the reverse entries if the graph is undirected, grouped by row
+ * range. Each thread then counts the degrees of its own rows, prefix
+ * sums them into the row pointers, scatters the entries of its range
+ * into their rows, and sorts the rows. No step needs atomics or
+ * locks.
+ *
+ * @param buffer The edge list, which need not be null-terminated.
+ * @param len_buffer The number of characters in the buffer.
+ * @param num_rows The number of rows in the matrix.
+ * @param num_cols The number of columns in the matrix.
+ * @param num_edges The number of edges listed in the buffer.
+ * @param is_directed False if the reverse of every edge should also
+ * be added.
+ * @param num_threads The number of threads to use.
+ * @return CompressedSparseRow* The CompressedSparseRow object parsed
+ * from the buffer, or NULL if the buffer does not list exactly
+ * num_edges edges, has a malformed line, lists a vertex out of range
+ * or a self-loop, or lists an edge twice.
+ */
+CompressedSparseRow* csr_new_from_buffer_parallel(const char* buffer, size_t len_buffer, int num_rows, int num_cols, int num_edges, bool is_directed, int num_threads) {
+    assert(buffer != NULL || len_buffer == 0);
+    assert(num_threads > 0);
+
+    int num_nnzs = is_directed ? num_edges : num_edges * 2;
+
+    // Every row range must be non-empty for the ownership arithmetic.
+    num_threads = max(min(num_threads, num_rows), 1);
+
+    _CsrParseShared shared;
+    shared.num_rows = num_rows;
+    shared.num_cols = num_cols;
+    shared.num_threads = num_threads;
+    shared.is_directed = is_directed;
+    shared.counts = calloc(num_threads * num_threads, sizeof(int));
+    shared.offsets = malloc(num_threads * num_threads * sizeof(int));
+    shared.bucketed_entries = NULL;
+    shared.csr = NULL;
+
+    _CsrParseWorker* workers = malloc(num_threads * sizeof(_CsrParseWorker));
+    const char* end = buffer + len_buffer;
+    const char* chunk_begin = buffer;
+
+    for (int t = 0; t < num_threads; t++) {
+        const char* chunk_end = buffer + len_buffer * (t + 1) / num_threads;
+
+        // Move the boundary past the end of the line it splits.
+        if (chunk_end < end && chunk_end > chunk_begin && chunk_end[-1] != '\n') {
+            chunk_end = _skip_line(chunk_end, end);
+        }
+
+        chunk_end = chunk_end < chunk_begin ? chunk_begin : chunk_end;
+
+        workers[t].shared = &shared;
+        workers[t].idx_thread = t;
+        workers[t].chunk_begin = chunk_begin;
+        workers[t].chunk_end = chunk_end;
+        workers[t].num_edges = 0;
+        workers[t].is_valid = true;
+
+        // Every edge line takes at least 4 characters, so this is
+        // usually enough to never grow.
+        workers[t].capacity_edges = max((int)((chunk_end - chunk_begin) / 8), 16);
+        workers[t].edges = malloc(2 * workers[t].capacity_edges * sizeof(int));
+
+        chunk_begin = chunk_end;
+    }
+
+    if (num_rows > 0) {
+        _run_parse_workers(workers, num_threads, _parse_chunk);
+    }
+
+    int num_parsed_edges = 0;
+    bool is_valid = true;
+
+    for (int t = 0; t < num_threads; t++) {
+        num_parsed_edges += workers[t].num_edges;
+        is_valid = is_valid && workers[t].is_valid;
+    }
+
+    // The arrays are sized from the header, so a buffer listing a
+    // different number of edges would overflow them.
+    if (is_valid == false || num_parsed_edges != num_edges) {
+        for (int t = 0; t < num_threads; t++) {
+            free(workers[t].edges);
+        }
+
+        free(workers);
+        free(shared.counts);
+        free(shared.offsets);
+
+        return NULL;
+    }
+
+    CompressedSparseRow* csr = csr_new(num_rows, num_cols, num_nnzs);
+    shared.csr = csr;
+
+    // Reserve the slots of each thread grouped by owner, so the bucket
+    // of owner r holds the entries of all threads for rows of r.
+    int offset = 0;
+    for (int r = 0; r < num_threads; r++) {
+        for (int t = 0; t < num_threads; t++) {
+            shared.offsets[t * num_threads + r] = offset;
+            offset += shared.counts[t * num_threads + r];
+        }
+    }
+
+    assert(offset == num_nnzs);
+
+    shared.bucketed_entries = malloc(max(2 * num_nnzs, 1) * sizeof(int));
+    csr->ptr_rows[num_rows] = num_nnzs;
+
+    if (num_rows > 0) {
+        _run_parse_workers(workers, num_threads, _bucket_entries);
+
+        // The edges are no longer needed once bucketed.
+        for (int t = 0; t < num_threads; t++) {
+            free(workers[t].edges);
+            workers[t].edges = NULL;
+        }
+
+        _run_parse_workers(workers, num_threads, _build_owned_rows);
+    }
+
+    for (int t = 0; t < num_threads; t++) {
+        free(workers[t].edges);
+        is_valid = is_valid && workers[t].is_valid;
+    }
+
+    free(workers);
+    free(shared.counts);
+    free(shared.offsets);
+    free(shared.bucketed_entries);
+
+    // Duplicate edges are only found once the rows are sorted.
+    if (is_valid == false) {
+        csr_delete(&csr);
+        return NULL;
+    }
+
+    csr->is_set = true;
+
+    return csr;
+}
+
 /**
  * @brief Creates a deep copy of the given CompressedSparseRow object.
  *
@@ -230,7 +698,15 @@ CompressedSparseRow* csr_copy(CompressedSparseRow* csr) {
     CompressedSparseRow* copy = csr_new(csr->num_rows, csr->num_cols, csr->num_nnzs);
     memcpy(copy->ptr_rows, csr->ptr_rows, csr->num_ptr_rows * sizeof(int));
     memcpy(copy->idx_cols, csr->idx_cols, csr->num_nnzs * sizeof(int));
-    memcpy(copy->edge_weights, csr->edge_weights, csr->num_nnzs * sizeof(int));
+
+    // An unweighted CSR has no weights array.
+    if (csr->edge_weights == NULL) {
+        free(copy->edge_weights);
+        copy->edge_weights = NULL;
+    } else {
+        memcpy(copy->edge_weights, csr->edge_weights, csr->num_nnzs * sizeof(int));
+    }
+
     copy->is_set = csr->is_set;
     return copy;
 }
@@ -239,13 +715,23 @@ CompressedSparseRow* csr_copy(CompressedSparseRow* csr) {
  * @brief Deletes the given CompressedSparseRow object.
  *
  * All associated memory is freed and the pointer
- * CompressedSparseRow** is set to NULL.
+ * CompressedSparseRow** is set to NULL. If the CSR is a view of a
+ * memory mapped file, the file is unmapped instead.
  *
  * @param csr
  */
 void csr_delete(CompressedSparseRow** csr) {
     assert(csr != NULL && *csr != NULL);
 
+    // The arrays are views into the mapping, so only the mapping is
+    // released.
+    if ((*csr)->mapped_region != NULL) {
+        munmap((*csr)->mapped_region, (*csr)->len_mapped_region);
+        free(*csr);
+        *csr = NULL;
+        return;
+    }
+
     free((*csr)->ptr_rows);
     free((*csr)->idx_cols);
     free((*csr)->edge_weights);
@@ -354,7 +840,7 @@ CompressedSparseRow* csr_reduce(CompressedSparseRow* csr, int num_rows, int num_
             }
 
             idx_cols[idx_nnz] = idx_col;
-            idx_weights[idx_nnz] = idx_ref_weights[idx_nnz];
+            idx_weights[idx_nnz] = idx_ref_weights == NULL ? 1 : idx_ref_weights[idx_ref_nnz];
 
             idx_nnz++;
         }
@@ -401,7 +887,11 @@ bool csr_is_equal(CompressedSparseRow* first, CompressedSparseRow* second) {
         return false;
     }
 
-    if (array_is_equal(first->edge_weights, second->edge_weights, first->num_nnzs, second->num_nnzs) == false) {
+    if ((first->edge_weights == NULL) != (second->edge_weights == NULL)) {
+        return false;
+    }
+
+    if (first->edge_weights != NULL && array_is_equal(first->edge_weights, second->edge_weights, first->num_nnzs, second->num_nnzs) == false) {
         return false;
     }
 
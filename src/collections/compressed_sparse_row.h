@@ -2,12 +2,17 @@
 #define CSR_H_INCLUDED
 
 #include <assert.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 
 #include "../utilities/array_util.h"
+#include "../utilities/math.h"
 
 typedef struct CompressedSparseRow {
     int num_rows;
@@ -20,12 +25,18 @@ typedef struct CompressedSparseRow {
     int *idx_cols;
     int *edge_weights;
 
+    // When the arrays are views of a memory mapped file, the mapping
+    // is released on delete instead of freeing each array.
+    void *mapped_region;
+    size_t len_mapped_region;
+
     bool is_set;
 } CompressedSparseRow;
 
 // Create and Delete Functions
 CompressedSparseRow *csr_new(int num_rows, int num_cols, int num_nnzs);
 CompressedSparseRow *csr_new_from_file(FILE *file, int num_rows, int num_cols, int num_nnzs, bool is_directed);
+CompressedSparseRow *csr_new_from_buffer_parallel(const char *buffer, size_t len_buffer, int num_rows, int num_cols, int num_edges, bool is_directed, int num_threads);
 CompressedSparseRow *csr_copy(CompressedSparseRow *csr);
 void csr_delete(CompressedSparseRow **crs);
 
@@ -0,0 +1,130 @@
+#include "disjoint_set.h"
+
+/**
+ * This class contains a disjoint-set (union-find) forest over the
+ * elements 0 to num_elements - 1. Finding a root compresses the path
+ * to it, and the union of two sets hangs the smaller tree under the
+ * larger one, so any sequence of operations runs in near-linear
+ * time.
+ */
+
+// Begin Create and Delete Functions
+
+/**
+ * @brief Creates a new DisjointSet where every element is in its own
+ * set.
+ *
+ * @param num_elements The number of elements.
+ * @return DisjointSet* A pointer to the new DisjointSet.
+ */
+DisjointSet* disjoint_set_new(int num_elements) {
+    assert(num_elements >= 0);
+
+    DisjointSet* disjoint_set = malloc(sizeof(DisjointSet));
+    disjoint_set->num_elements = num_elements;
+    disjoint_set->num_sets = num_elements;
+    disjoint_set->parents = malloc(max(num_elements, 1) * sizeof(int));
+    disjoint_set->sizes = malloc(max(num_elements, 1) * sizeof(int));
+
+    for (int i = 0; i < num_elements; i++) {
+        disjoint_set->parents[i] = i;
+        disjoint_set->sizes[i] = 1;
+    }
+
+    return disjoint_set;
+}
+
+/**
+ * @brief Deletes the param disjoint set and all associated memory.
+ * The pointer to the disjoint set is set to NULL.
+ *
+ * @param ptr_disjoint_set A pointer to the disjoint set.
+ */
+void disjoint_set_delete(DisjointSet** ptr_disjoint_set) {
+    assert(ptr_disjoint_set != NULL);
+    assert(*ptr_disjoint_set != NULL);
+
+    free((*ptr_disjoint_set)->parents);
+    free((*ptr_disjoint_set)->sizes);
+    free(*ptr_disjoint_set);
+    *ptr_disjoint_set = NULL;
+}
+
+// End Create and Delete Functions
+// Begin Manipulation Functions
+
+/**
+ * @brief Finds the root of the set containing the param element, then
+ * points every element on the path directly at the root.
+ *
+ * @param disjoint_set The disjoint set.
+ * @param element The element to find the set of.
+ * @return int The root of the set containing the element.
+ */
+int disjoint_set_find(DisjointSet* disjoint_set, int element) {
+    assert(disjoint_set != NULL);
+    assert(element >= 0 && element < disjoint_set->num_elements);
+
+    int* parents = disjoint_set->parents;
+    int root = element;
+
+    while (parents[root] != root) {
+        root = parents[root];
+    }
+
+    while (parents[element] != root) {
+        int next = parents[element];
+        parents[element] = root;
+        element = next;
+    }
+
+    return root;
+}
+
+/**
+ * @brief Merges the sets containing the two param elements, hanging
+ * the root of the smaller set under the root of the larger set.
+ *
+ * @param disjoint_set The disjoint set.
+ * @param element_a An element of the first set.
+ * @param element_b An element of the second set.
+ * @return int The root of the merged set.
+ */
+int disjoint_set_union(DisjointSet* disjoint_set, int element_a, int element_b) {
+    int root_a = disjoint_set_find(disjoint_set, element_a);
+    int root_b = disjoint_set_find(disjoint_set, element_b);
+
+    if (root_a == root_b) {
+        return root_a;
+    }
+
+    if (disjoint_set->sizes[root_a] < disjoint_set->sizes[root_b]) {
+        int swap = root_a;
+        root_a = root_b;
+        root_b = swap;
+    }
+
+    disjoint_set->parents[root_b] = root_a;
+    disjoint_set->sizes[root_a] += disjoint_set->sizes[root_b];
+    disjoint_set->num_sets--;
+
+    return root_a;
+}
+
+// End Manipulation Functions
+// Begin Membership Functions
+
+/**
+ * @brief Checks if the two param elements are in the same set.
+ *
+ * @param disjoint_set The disjoint set.
+ * @param element_a The first element.
+ * @param element_b The second element.
+ * @return true If the elements are in the same set.
+ * @return false Otherwise.
+ */
+bool disjoint_set_is_same_set(DisjointSet* disjoint_set, int element_a, int element_b) {
+    return disjoint_set_find(disjoint_set, element_a) == disjoint_set_find(disjoint_set, element_b);
+}
+
+// End Membership Functions
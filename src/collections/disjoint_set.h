@@ -0,0 +1,32 @@
+#ifndef DISJOINT_SET_H_INCLUDED
+#define DISJOINT_SET_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../utilities/array_util.h"
+
+// Element i is a root if parents[i] == i, and sizes[i] is only
+// meaningful for roots.
+typedef struct DisjointSet {
+    int num_elements;
+    int num_sets;
+
+    int* parents;
+    int* sizes;
+} DisjointSet;
+
+// Create and Delete Functions
+DisjointSet* disjoint_set_new(int num_elements);
+void disjoint_set_delete(DisjointSet** ptr_disjoint_set);
+
+// Manipulation Functions
+int disjoint_set_find(DisjointSet* disjoint_set, int element);
+int disjoint_set_union(DisjointSet* disjoint_set, int element_a, int element_b);
+
+// Membership Functions
+bool disjoint_set_is_same_set(DisjointSet* disjoint_set, int element_a, int element_b);
+
+#endif
@@ -2,56 +2,242 @@
 
 // Begin Parser Functions
 /**
- * @brief Parses the file for the graph's directedness.
+ * @brief Parses the line for the graph's directedness.
  *
  * @note The file should have the directedness on the first line.
  *
  * @param graph The graph to set the directedness for.
- * @param file The file to parse.
+ * @param line The first line of the file.
  */
-static inline void _set_directedness(Graph* graph, FILE* file) {
-    assert(graph != NULL && file != NULL);
+static inline void _set_directedness(Graph* graph, const char* line) {
+    assert(graph != NULL && line != NULL);
+    assert(strcmp(line, "% directed\n") == 0 || strcmp(line, "% undirected\n") == 0);
 
-    const int len_buffer = 50;
-    char* buffer = calloc(len_buffer, sizeof(char));
+    graph->is_directed = (strcmp(line, "% directed\n") == 0);
+}
 
-    assert(fgets(buffer, len_buffer, file) != NULL);
-    assert(strcmp(buffer, "% directed\n") == 0 || strcmp(buffer, "% undirected\n") == 0);
+/**
+ * @brief Parses the line for the graph's vertices and edges count.
+ *
+ * @note The file should have these on the second line.
+ *
+ * @param graph The graph to set the vertices and edges count for.
+ * @param line The second line of the file.
+ */
+static inline void _set_num_vertices_edges(Graph* graph, const char* line) {
+    assert(graph != NULL && line != NULL);
 
-    graph->is_directed = (strcmp(buffer, "% directed\n") == 0);
+    int num_vertices, num_edges;
+    int num_parsed = sscanf(line, "%% %d %d", &num_vertices, &num_edges);
+    assert(num_parsed == 2);
+    (void)num_parsed;
 
-    free(buffer);
+    graph->num_vertices = num_vertices;
+    graph->num_edges = num_edges;
 }
 
 /**
- * @brief Parses the file for the graph's vertices and edges count.
+ * @brief Copies the line starting at param *ptr_cursor into the param
+ * line buffer as fgets would, and moves the cursor to the next line.
  *
- * @note The file should have these on the second line.
+ * @param ptr_cursor A pointer to the start of the line.
+ * @param end One past the last readable character.
+ * @param line The buffer to copy the line into.
+ * @param len_line The size of the buffer.
+ */
+static inline void _read_line(const char** ptr_cursor, const char* end, char* line, int len_line) {
+    const char* newline = memchr(*ptr_cursor, '\n', end - *ptr_cursor);
+    const char* line_end = newline == NULL ? end : newline + 1;
+
+    int len_copied = min((int)(line_end - *ptr_cursor), len_line - 1);
+    memcpy(line, *ptr_cursor, len_copied);
+    line[len_copied] = '\0';
+
+    *ptr_cursor = line_end;
+}
+
+/**
+ * @brief Folds the param ints into a running FNV-1a checksum of a
+ * binary graph file.
  *
- * @param graph The graph to set the vertices and edges count for.
- * @param file The file to parse.
+ * @param checksum The checksum of everything folded so far.
+ * @param data The ints to fold in.
+ * @param len_data The number of ints.
+ * @return uint64_t The updated checksum.
  */
-static inline void _set_num_vertices_edges(Graph* graph, FILE* file) {
-    assert(graph != NULL && file != NULL);
+static inline uint64_t _update_binary_checksum(uint64_t checksum, const int* data, int64_t len_data) {
+    const uint64_t fnv_prime = 1099511628211ULL;
 
-    const int len_buffer = 50;
-    char* buffer = calloc(len_buffer, sizeof(char));
+    for (int64_t i = 0; i < len_data; i++) {
+        checksum = (checksum ^ (uint32_t)data[i]) * fnv_prime;
+    }
 
-    int* ref_num_vertices = malloc(sizeof(int));
-    int* ref_num_edges = malloc(sizeof(int));
+    return checksum;
+}
 
-    assert(fgets(buffer, len_buffer, file) != NULL);
-    assert(sscanf(buffer, "%% %d %d", ref_num_vertices, ref_num_edges) == 2);
+/**
+ * @brief Computes the checksum of the arrays of a binary graph file.
+ *
+ * @param ptr_rows The row pointers.
+ * @param idx_cols The column indices.
+ * @param edge_weights The edge weights, or NULL if not stored.
+ * @param num_vertices The number of vertices.
+ * @param num_edges The number of non-zero entries.
+ * @return uint64_t The checksum stored in the file header.
+ */
+static uint64_t _compute_binary_checksum(const int* ptr_rows, const int* idx_cols, const int* edge_weights, int64_t num_vertices, int64_t num_edges) {
+    uint64_t checksum = 14695981039346656037ULL;
 
-    graph->num_vertices = *ref_num_vertices;
-    graph->num_edges = *ref_num_edges;
+    checksum = _update_binary_checksum(checksum, ptr_rows, num_vertices + 1);
+    checksum = _update_binary_checksum(checksum, idx_cols, num_edges);
 
-    free(buffer);
-    free(ref_num_vertices);
-    free(ref_num_edges);
+    if (edge_weights != NULL) {
+        checksum = _update_binary_checksum(checksum, edge_weights, num_edges);
+    }
+
+    return checksum;
+}
+
+/**
+ * @brief Checks that the arrays of a binary graph file form a valid
+ * CSR, so later walks of the graph cannot index out of bounds. The
+ * row pointers must start at 0, never decrease and end at num_edges,
+ * and every row must list distinct vertices in [0, num_vertices) in
+ * increasing order.
+ *
+ * @param ptr_rows The row pointers.
+ * @param idx_cols The column indices.
+ * @param num_vertices The number of vertices.
+ * @param num_edges The number of non-zero entries.
+ * @return bool True if the arrays form a valid CSR, false otherwise.
+ */
+static bool _is_valid_binary_csr(const int* ptr_rows, const int* idx_cols, int64_t num_vertices, int64_t num_edges) {
+    if (ptr_rows[0] != 0 || ptr_rows[num_vertices] != num_edges) {
+        return false;
+    }
+
+    for (int64_t u = 0; u < num_vertices; u++) {
+        if (ptr_rows[u] > ptr_rows[u + 1]) {
+            return false;
+        }
+
+        for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+            if (idx_cols[idx_nnz] < 0 || idx_cols[idx_nnz] >= num_vertices) {
+                return false;
+            }
+
+            if (idx_nnz > ptr_rows[u] && idx_cols[idx_nnz - 1] >= idx_cols[idx_nnz]) {
+                return false;
+            }
+        }
+    }
+
+    return true;
 }
 
 // End Parser Functions
+// Begin Orientation Helper Functions
+
+typedef struct _OrientWorkers {
+    Graph* graph;
+    Graph* directed_graph;
+    int (*f)(int, int, int*);
+    int* meta_data;
+
+    // Thread t orients the rows in [vertex_bounds[t], vertex_bounds[t + 1]).
+    vertex* vertex_bounds;
+} _OrientWorkers;
+
+typedef struct _OrientWorker {
+    _OrientWorkers* shared;
+    int idx_thread;
+} _OrientWorker;
+
+/**
+ * @brief Counts the out-degree of every vertex in a worker's range
+ * into the directed row pointers, shifted by one for the prefix sum.
+ */
+static void* _count_out_degrees(void* arg) {
+    _OrientWorker* worker = arg;
+    _OrientWorkers* shared = worker->shared;
+
+    int* ptr_rows = shared->graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = shared->graph->adjacency_matrix->idx_cols;
+    int* ptr_dir_rows = shared->directed_graph->adjacency_matrix->ptr_rows;
+
+    for (vertex u = shared->vertex_bounds[worker->idx_thread]; u < shared->vertex_bounds[worker->idx_thread + 1]; u++) {
+        int out_degree = 0;
+
+        for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+            out_degree += shared->f(u, idx_cols[idx_nnz], shared->meta_data) == idx_cols[idx_nnz];
+        }
+
+        ptr_dir_rows[u + 1] = out_degree;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Copies the out-neighbors, and their weights, of every vertex
+ * in a worker's range into the directed graph.
+ */
+static void* _copy_out_neighbors(void* arg) {
+    _OrientWorker* worker = arg;
+    _OrientWorkers* shared = worker->shared;
+
+    CompressedSparseRow* csr = shared->graph->adjacency_matrix;
+    CompressedSparseRow* dir_csr = shared->directed_graph->adjacency_matrix;
+
+    for (vertex u = shared->vertex_bounds[worker->idx_thread]; u < shared->vertex_bounds[worker->idx_thread + 1]; u++) {
+        int idx_dir_nnz = dir_csr->ptr_rows[u];
+
+        for (int idx_nnz = csr->ptr_rows[u]; idx_nnz < csr->ptr_rows[u + 1]; idx_nnz++) {
+            vertex v = csr->idx_cols[idx_nnz];
+
+            if (shared->f(u, v, shared->meta_data) != v) {
+                continue;
+            }
+
+            dir_csr->idx_cols[idx_dir_nnz] = v;
+
+            if (dir_csr->edge_weights != NULL) {
+                dir_csr->edge_weights[idx_dir_nnz] = csr->edge_weights[idx_nnz];
+            }
+
+            idx_dir_nnz++;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Runs param function on every orientation worker on its own
+ * thread and waits for all of them to finish.
+ */
+static void _run_orient_workers(_OrientWorker* workers, int num_threads, void* (*function)(void*)) {
+    if (num_threads == 1) {
+        function(&workers[0]);
+        return;
+    }
+
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+
+    for (int t = 0; t < num_threads; t++) {
+        int status = pthread_create(&threads[t], NULL, function, &workers[t]);
+        assert(status == 0);
+        (void)status;
+    }
+
+    for (int t = 0; t < num_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    free(threads);
+}
+
+// End Orientation Helper Functions
 // Begin Create and Delete Functions
 
 /**
@@ -100,11 +286,21 @@ Graph* graph_new_from_file(const char* file_path) {
 
     Graph* graph = malloc(sizeof(Graph));
 
+    const int len_buffer = 50;
+    char* buffer = calloc(len_buffer, sizeof(char));
+
     // parse the first line for graph type (directed or undirected)
-    _set_directedness(graph, file);
+    char* line = fgets(buffer, len_buffer, file);
+    assert(line != NULL);
+    _set_directedness(graph, buffer);
 
     // parse the second line for number of nodes and edges
-    _set_num_vertices_edges(graph, file);
+    line = fgets(buffer, len_buffer, file);
+    assert(line != NULL);
+    (void)line;
+    _set_num_vertices_edges(graph, buffer);
+
+    free(buffer);
 
     // create and file the graph from the file
     graph->adjacency_matrix = csr_new_from_file(file, graph->num_vertices, graph->num_vertices, graph->num_edges, graph->is_directed);
@@ -120,6 +316,178 @@ Graph* graph_new_from_file(const char* file_path) {
     return graph;
 }
 
+/**
+ * @brief Creates a new graph from the file at the specified path using
+ * multiple threads.
+ *
+ * The file has the same format as for graph_new_from_file, except the
+ * edges may be listed in any order. The file is memory mapped, the
+ * first two lines are parsed as in graph_new_from_file, then the rest
+ * of the mapping is handed to csr_new_from_buffer_parallel. The
+ * mapping is released before returning.
+ *
+ * @param file_path The path to the file to create the graph from.
+ * @param num_threads The number of threads to parse with.
+ * @return Graph* The newly created graph, or NULL if the file could
+ * not be opened or mapped, or if csr_new_from_buffer_parallel rejects
+ * its edge list.
+ */
+Graph* graph_new_from_file_parallel(const char* file_path, int num_threads) {
+    assert(file_path != NULL);
+
+    int file_descriptor = open(file_path, O_RDONLY);
+    if (file_descriptor < 0) {
+        return NULL;
+    }
+
+    struct stat file_stat;
+    if (fstat(file_descriptor, &file_stat) != 0) {
+        close(file_descriptor);
+        return NULL;
+    }
+
+    // An empty mapping is invalid, so map at least one page.
+    size_t len_file = file_stat.st_size;
+    size_t len_mapped = len_file > 0 ? len_file : 1;
+    char* region = mmap(NULL, len_mapped, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    close(file_descriptor);
+
+    if (region == MAP_FAILED) {
+        return NULL;
+    }
+
+    madvise(region, len_file, MADV_SEQUENTIAL);
+
+    Graph* graph = malloc(sizeof(Graph));
+
+    const int len_buffer = 50;
+    char* buffer = calloc(len_buffer, sizeof(char));
+    const char* cursor = region;
+    const char* end = region + len_file;
+
+    // parse the first line for graph type (directed or undirected)
+    _read_line(&cursor, end, buffer, len_buffer);
+    _set_directedness(graph, buffer);
+
+    // parse the second line for number of nodes and edges
+    _read_line(&cursor, end, buffer, len_buffer);
+    _set_num_vertices_edges(graph, buffer);
+
+    free(buffer);
+
+    graph->adjacency_matrix = csr_new_from_buffer_parallel(cursor, end - cursor, graph->num_vertices, graph->num_vertices, graph->num_edges, graph->is_directed, num_threads);
+    munmap(region, len_mapped);
+
+    if (graph->adjacency_matrix == NULL) {
+        free(graph);
+        return NULL;
+    }
+
+    if (graph->is_directed == false) {
+        graph->num_edges *= 2;
+    }
+
+    return graph;
+}
+
+/**
+ * @brief Creates a new graph by memory mapping a binary graph file
+ * written by graph_write_binary_file.
+ *
+ * The arrays of the adjacency matrix point directly into the mapped
+ * file, so nothing is parsed or copied and the pages are loaded
+ * lazily by the operating system on first access. The mapping is
+ * private, so writes to the arrays are never written back to the
+ * file. The mapping is released by graph_delete. If the file stores
+ * no weights, the adjacency matrix has no weights array and every
+ * edge has weight 1.
+ *
+ * @param file_path The path to the binary graph file.
+ * @param should_verify_checksum True if the checksum in the header
+ * should be verified. This reads the whole file, so it is slow for
+ * large graphs.
+ * @return Graph* The mapped graph, or NULL if the file could not be
+ * opened, is not a binary graph file of a supported version, is
+ * truncated, fails the checksum, or does not hold a valid CSR.
+ */
+Graph* graph_new_from_binary_file(const char* file_path, bool should_verify_checksum) {
+    assert(file_path != NULL);
+    assert(sizeof(int) == 4);
+
+    int file_descriptor = open(file_path, O_RDONLY);
+    if (file_descriptor < 0) {
+        return NULL;
+    }
+
+    struct stat file_stat;
+    if (fstat(file_descriptor, &file_stat) != 0 || (size_t)file_stat.st_size < sizeof(GraphBinaryHeader)) {
+        close(file_descriptor);
+        return NULL;
+    }
+
+    size_t len_file = file_stat.st_size;
+    void* region = mmap(NULL, len_file, PROT_READ | PROT_WRITE, MAP_PRIVATE, file_descriptor, 0);
+    close(file_descriptor);
+
+    if (region == MAP_FAILED) {
+        return NULL;
+    }
+
+    GraphBinaryHeader* header = region;
+    bool is_weighted = (header->flags & GRAPH_BINARY_FLAG_WEIGHTED) != 0;
+
+    bool is_valid = memcmp(header->magic, GRAPH_BINARY_MAGIC, sizeof(header->magic)) == 0;
+    is_valid = is_valid && header->version == GRAPH_BINARY_VERSION;
+    is_valid = is_valid && header->num_vertices >= 0 && header->num_vertices < INT32_MAX;
+    is_valid = is_valid && header->num_edges >= 0 && header->num_edges <= INT32_MAX;
+
+    size_t len_expected = sizeof(GraphBinaryHeader);
+    if (is_valid) {
+        len_expected += (header->num_vertices + 1 + header->num_edges * (is_weighted ? 2 : 1)) * sizeof(int);
+        is_valid = len_file == len_expected;
+    }
+
+    if (is_valid == false) {
+        munmap(region, len_file);
+        return NULL;
+    }
+
+    int* ptr_rows = (int*)((char*)region + sizeof(GraphBinaryHeader));
+    int* idx_cols = ptr_rows + header->num_vertices + 1;
+    int* edge_weights = is_weighted ? idx_cols + header->num_edges : NULL;
+
+    if (should_verify_checksum && _compute_binary_checksum(ptr_rows, idx_cols, edge_weights, header->num_vertices, header->num_edges) != header->checksum) {
+        munmap(region, len_file);
+        return NULL;
+    }
+
+    // The checksum is optional, so the structure is always checked.
+    if (_is_valid_binary_csr(ptr_rows, idx_cols, header->num_vertices, header->num_edges) == false) {
+        munmap(region, len_file);
+        return NULL;
+    }
+
+    CompressedSparseRow* csr = malloc(sizeof(CompressedSparseRow));
+    csr->num_rows = header->num_vertices;
+    csr->num_cols = header->num_vertices;
+    csr->num_nnzs = header->num_edges;
+    csr->num_ptr_rows = header->num_vertices + 1;
+    csr->ptr_rows = ptr_rows;
+    csr->idx_cols = idx_cols;
+    csr->edge_weights = edge_weights;
+    csr->mapped_region = region;
+    csr->len_mapped_region = len_file;
+    csr->is_set = true;
+
+    Graph* graph = malloc(sizeof(Graph));
+    graph->num_vertices = header->num_vertices;
+    graph->num_edges = header->num_edges;
+    graph->is_directed = (header->flags & GRAPH_BINARY_FLAG_DIRECTED) != 0;
+    graph->adjacency_matrix = csr;
+
+    return graph;
+}
+
 /**
  * @brief Creates a copy of the specified graph.
  *
@@ -160,102 +528,102 @@ void graph_delete(Graph** graph) {
  * @brief Creates a directed graph from the specified undirected
  * graph using the specified function to determine the edge direction.
  *
- * The function creates a deep copy of the specified undirected graph
- * then decompresses the CSR representation of the graph into a
- * coordinate format. The function then iterates over the coordinate
- * format and calls the specified function to determine the direction
- * of the edge. The function then sets the edge direction in the
- * directed graph. The current state of the csr directed graph is
- * invalid and must be sorted. Parallel sort is used to sort the
- * decompressed row indices, column indices, and edge weights on the
- * row indicides then the column indices. The function then compresses
- * the sorted row indicies into the equivalent row pointers for the
- * csr directed graph. The function then returns the newly created
- * directed graph.
+ * Every edge (u, v) is stored in both rows u and v of the undirected
+ * graph, and f points it towards one of them, so the out-neighbors of
+ * u are exactly the neighbors v in row u with f(u, v) == v. The rows
+ * of the undirected graph are sorted, so filtering each row in place
+ * keeps the rows of the directed graph sorted. The out-degrees are
+ * counted in a first pass and prefix summed into the row pointers,
+ * then a second pass copies the kept neighbors into their rows. The
+ * total work is O(n + m) and no sorting is needed.
  *
  * @param graph The undirected graph to create a directed graph from.
  * @param f The function to determine the direction of any given edge.
+ * It must return the same vertex for (u, v) and (v, u).
+ * @param meta_data The data passed to f, such as the degrees.
  * @return Graph* The newly created directed graph.
  */
 Graph* graph_make_directed(Graph* graph, int (*f)(int, int, int*), int* meta_data) {
+    return graph_make_directed_parallel(graph, f, meta_data, 1);
+}
+
+/**
+ * @brief The multithreaded variant of graph_make_directed.
+ *
+ * The vertices are split into one contiguous range per thread such
+ * that every range holds about the same number of non-zero entries.
+ * The threads count the out-degrees of their ranges, the row pointers
+ * are prefix summed, then the threads copy the out-neighbors of their
+ * ranges. Every thread only writes to its own rows.
+ *
+ * @param graph The undirected graph to create a directed graph from.
+ * @param f The function to determine the direction of any given edge.
+ * It must return the same vertex for (u, v) and (v, u), and must be
+ * safe to call from multiple threads.
+ * @param meta_data The data passed to f, such as the degrees.
+ * @param num_threads The number of threads to use.
+ * @return Graph* The newly created directed graph.
+ */
+Graph* graph_make_directed_parallel(Graph* graph, int (*f)(int, int, int*), int* meta_data, int num_threads) {
     assert(graph != NULL);
     assert(graph->adjacency_matrix->is_set);
     assert(f != NULL);
+    assert(num_threads > 0);
 
     assert(graph->is_directed == false);
 
-    // Create a deep copy of the graph. The copy will be modified
-    // to create the directed graph.
-    Graph* directed_graph = graph_copy(graph);
-    directed_graph->is_directed = true;
+    CompressedSparseRow* csr = graph->adjacency_matrix;
+    Graph* directed_graph = graph_new(graph->num_vertices, graph->num_edges / 2, true);
 
-    // For convenience.
-    CompressedSparseRow* adjacency_matrix = directed_graph->adjacency_matrix;
-    int* idx_dir_cols = adjacency_matrix->idx_cols;
-
-    // Expand/Express the CSR row pointers into coordinate format.
-    int* coord_rows = csr_get_coord_rows(directed_graph->adjacency_matrix);
-
-    int skipped = 0;
-
-    // Apply f to each row and column to obtain the new ordering.
-    for (int i = 0; i < graph->num_edges; i++) {
-        vertex u = coord_rows[i];
-        vertex v = idx_dir_cols[i];
-
-        // The CSR stores both (u, v) and (v, u) for undirected
-        // graphs, so skip the second instance of the edge or else
-        // the graph will contain duplicate edges as both (u, v)
-        // and (v, u) will be added to the directed graph and pointed
-        // in the same direction.
-        if (u >= v) {
-            skipped++;
-            continue;
-        }
+    if (csr->edge_weights == NULL) {
+        free(directed_graph->adjacency_matrix->edge_weights);
+        directed_graph->adjacency_matrix->edge_weights = NULL;
+    }
+
+    // Balance the ranges by non-zero entries rather than by vertices,
+    // as the degrees of real graphs are heavily skewed.
+    vertex* vertex_bounds = malloc((num_threads + 1) * sizeof(vertex));
+    vertex_bounds[0] = 0;
 
-        // apply f to determine the direction of the edge. f returns
-        // which vertex will be directed towards by the other.
-        vertex target = f(u, v, meta_data);
-        vertex source = target == u ? v : u;
+    for (int t = 1; t < num_threads; t++) {
+        long idx_nnz_target = (long)csr->num_nnzs * t / num_threads;
+        vertex u = vertex_bounds[t - 1];
 
-        // Apply the change. The skipped offset is used to account
-        // for the skipped edges in the undirected graph.
-        coord_rows[i - skipped] = source;
-        idx_dir_cols[i - skipped] = target;
+        while (u < graph->num_vertices && csr->ptr_rows[u] < idx_nnz_target) {
+            u++;
+        }
+
+        vertex_bounds[t] = u;
     }
 
-    // Update the number of edges in the directed graph. The number of
-    // edges in the directed graph should be exactly half of the
-    // initial edge count since the CSR stores both (u, v) and (v, u).
-    int num_edges = graph->num_edges - skipped;
-    assert(num_edges == directed_graph->num_edges / 2);
+    vertex_bounds[num_threads] = graph->num_vertices;
 
-    // Update the number of non-zero entries in the adjacency matrix.
-    adjacency_matrix->num_nnzs = num_edges;
-    directed_graph->num_edges = num_edges;
+    _OrientWorkers shared = {graph, directed_graph, f, meta_data, vertex_bounds};
+    _OrientWorker* workers = malloc(num_threads * sizeof(_OrientWorker));
 
-    // Reallocate the arrays to the new size to save memory.
-    coord_rows = realloc(coord_rows, num_edges * sizeof(int));
-    assert(coord_rows != NULL);
+    for (int t = 0; t < num_threads; t++) {
+        workers[t].shared = &shared;
+        workers[t].idx_thread = t;
+    }
 
-    adjacency_matrix->idx_cols = realloc(adjacency_matrix->idx_cols, num_edges * sizeof(int));
-    assert(adjacency_matrix->idx_cols != NULL);
+    _run_orient_workers(workers, num_threads, _count_out_degrees);
 
-    adjacency_matrix->edge_weights = realloc(adjacency_matrix->edge_weights, num_edges * sizeof(int));
-    assert(adjacency_matrix->edge_weights != NULL);
+    int* ptr_dir_rows = directed_graph->adjacency_matrix->ptr_rows;
+    for (vertex u = 0; u < graph->num_vertices; u++) {
+        ptr_dir_rows[u + 1] += ptr_dir_rows[u];
+    }
 
-    // Parallel sort by rows then columns to prepare for the new csr
-    array_parallel_sort_2(coord_rows, adjacency_matrix->idx_cols, directed_graph->num_edges, directed_graph->num_edges, true);
+    // The number of edges in the directed graph should be exactly
+    // half of the non-zero entries since the CSR stores both (u, v)
+    // and (v, u).
+    assert(ptr_dir_rows[graph->num_vertices] == directed_graph->num_edges);
 
-    // Return the coordinate format rows to the correct CSR row
-    // pointers format.
-    csr_compress_row_ptrs(directed_graph->adjacency_matrix, coord_rows);
+    _run_orient_workers(workers, num_threads, _copy_out_neighbors);
 
-    // Reallocate the row pointers to the new size to save memory.
-    directed_graph->adjacency_matrix->ptr_rows = realloc(directed_graph->adjacency_matrix->ptr_rows, (directed_graph->num_vertices + 1) * sizeof(int));
-    assert(directed_graph->adjacency_matrix->ptr_rows != NULL);
+    free(workers);
+    free(vertex_bounds);
 
-    free(coord_rows);
+    directed_graph->adjacency_matrix->is_set = true;
 
     return directed_graph;
 }
@@ -324,13 +692,19 @@ int graph_get_edge(Graph* graph, int idx_row, int idx_col) {
     // edge exists. If it does, we get the associated NNZ index which
     // can be used to index the weights array to get the associated
     // weight of the current edge. If the edge does not exist, then
-    // the ranged binary search returns -1.
-    int idx_nnz = array_binary_search_range(idx_cols, graph->num_edges, idx_begin_read, idx_end_read, idx_col);
+    // the ranged binary search returns -1. The upper bound of the
+    // ranged binary search is inclusive.
+    int idx_nnz = array_binary_search_range(idx_cols, graph->num_edges, idx_begin_read, idx_end_read - 1, idx_col);
 
     if (idx_nnz == -1) {
         return -1;
     }
 
+    // An unweighted graph has no weights array.
+    if (graph->adjacency_matrix->edge_weights == NULL) {
+        return 1;
+    }
+
     return graph->adjacency_matrix->edge_weights[idx_nnz];
 }
 
@@ -435,9 +809,173 @@ OrderedSet* graph_get_neighbors(Graph* graph, int idx_vertex_u) {
     return neighbors;
 }
 
+/**
+ * @brief Maps every non-zero entry (u, v) of the undirected graph to
+ * the index of its twin entry (v, u).
+ *
+ * The rows of the CSR are sorted, so the entries (v, u) with u < v
+ * are at the start of row v in increasing order of u. Visiting the
+ * rows in increasing order of u therefore finds the twins of row v
+ * in the same order they are stored, and a cursor per row is enough
+ * to pair every entry in O(n + m).
+ *
+ * @param graph The undirected graph to pair the entries of.
+ * @return int* An array of size graph->num_edges where index idx_nnz
+ * holds the nnz index of the reverse of entry idx_nnz.
+ */
+int* graph_get_reverse_edges(Graph* graph) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+
+    int* reverse_edges = malloc(max(graph->num_edges, 1) * sizeof(int));
+    assert(reverse_edges != NULL);
+
+    int* idx_next = malloc(max(graph->num_vertices, 1) * sizeof(int));
+    memcpy(idx_next, ptr_rows, graph->num_vertices * sizeof(int));
+
+    for (vertex u = 0; u < graph->num_vertices; u++) {
+        for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+            vertex v = idx_cols[idx_nnz];
+
+            if (v < u) {
+                continue;
+            }
+
+            int idx_twin = idx_next[v]++;
+            assert(idx_cols[idx_twin] == u);
+
+            reverse_edges[idx_nnz] = idx_twin;
+            reverse_edges[idx_twin] = idx_nnz;
+        }
+    }
+
+    free(idx_next);
+
+    return reverse_edges;
+}
+
+/**
+ * @brief Assigns an id to every undirected edge of the graph and
+ * returns the id of each non-zero entry.
+ *
+ * The entries (u, v) with u < v are numbered in the order they are
+ * stored, so the ids follow the lexicographic order of the edges.
+ * The twin entry (v, u) is given the same id.
+ *
+ * @param graph The undirected graph to number the edges of.
+ * @param reverse_edges The twin of each entry from
+ * graph_get_reverse_edges.
+ * @return int* An array of size graph->num_edges where index idx_nnz
+ * holds the id of the undirected edge stored at entry idx_nnz. The
+ * ids range from 0 to graph->num_edges / 2 - 1.
+ */
+int* graph_get_edge_ids(Graph* graph, int* reverse_edges) {
+    assert(graph != NULL);
+    assert(graph->is_directed == false);
+    assert(reverse_edges != NULL);
+
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+
+    int* edge_ids = malloc(max(graph->num_edges, 1) * sizeof(int));
+    assert(edge_ids != NULL);
+
+    int idx_edge = 0;
+
+    for (vertex u = 0; u < graph->num_vertices; u++) {
+        for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+            if (idx_cols[idx_nnz] < u) {
+                continue;
+            }
+
+            edge_ids[idx_nnz] = idx_edge;
+            edge_ids[reverse_edges[idx_nnz]] = idx_edge;
+            idx_edge++;
+        }
+    }
+
+    assert(idx_edge == graph->num_edges / 2);
+
+    return edge_ids;
+}
+
 // End Getter Functions
 // Begin Utility Functions
 
+/**
+ * @brief Writes the param graph to a binary graph file that can be
+ * memory mapped with graph_new_from_binary_file.
+ *
+ * The file holds a GraphBinaryHeader followed by the row pointers,
+ * the column indices, and optionally the edge weights, exactly as
+ * they are laid out in memory. The number of edges stored is the
+ * number of non-zero entries, so undirected graphs store both
+ * (u, v) and (v, u) and load without symmetrizing.
+ *
+ * @param graph The graph to write.
+ * @param file_path The path of the binary graph file to create.
+ * @param should_write_weights True if the edge weights should be
+ * stored. Unweighted graphs should pass false to save space.
+ * @return bool True if the file was written, false otherwise.
+ */
+bool graph_write_binary_file(Graph* graph, const char* file_path, bool should_write_weights) {
+    assert(graph != NULL);
+    assert(graph->adjacency_matrix != NULL);
+    assert(graph->adjacency_matrix->is_set);
+    assert(file_path != NULL);
+
+    CompressedSparseRow* csr = graph->adjacency_matrix;
+    int* edge_weights = should_write_weights ? csr->edge_weights : NULL;
+
+    GraphBinaryHeader header;
+    memset(&header, 0, sizeof(GraphBinaryHeader));
+    memcpy(header.magic, GRAPH_BINARY_MAGIC, sizeof(header.magic));
+    header.version = GRAPH_BINARY_VERSION;
+    header.flags = (graph->is_directed ? GRAPH_BINARY_FLAG_DIRECTED : 0) | (edge_weights != NULL ? GRAPH_BINARY_FLAG_WEIGHTED : 0);
+    header.num_vertices = graph->num_vertices;
+    header.num_edges = csr->num_nnzs;
+    header.checksum = _compute_binary_checksum(csr->ptr_rows, csr->idx_cols, edge_weights, header.num_vertices, header.num_edges);
+
+    FILE* file = fopen(file_path, "wb");
+    if (file == NULL) {
+        return false;
+    }
+
+    bool is_written = fwrite(&header, sizeof(GraphBinaryHeader), 1, file) == 1;
+    is_written = is_written && fwrite(csr->ptr_rows, sizeof(int), csr->num_ptr_rows, file) == (size_t)csr->num_ptr_rows;
+    is_written = is_written && fwrite(csr->idx_cols, sizeof(int), csr->num_nnzs, file) == (size_t)csr->num_nnzs;
+
+    if (edge_weights != NULL) {
+        is_written = is_written && fwrite(edge_weights, sizeof(int), csr->num_nnzs, file) == (size_t)csr->num_nnzs;
+    }
+
+    is_written = (fclose(file) == 0) && is_written;
+
+    return is_written;
+}
+
+/**
+ * @brief Converts a text graph file read by graph_new_from_file into
+ * an unweighted binary graph file.
+ *
+ * @param text_file_path The path to the text graph file.
+ * @param binary_file_path The path of the binary graph file to
+ * create.
+ * @return bool True if the file was written, false otherwise.
+ */
+bool graph_convert_to_binary_file(const char* text_file_path, const char* binary_file_path) {
+    Graph* graph = graph_new_from_file(text_file_path);
+    bool is_written = graph_write_binary_file(graph, binary_file_path, false);
+    graph_delete(&graph);
+
+    return is_written;
+}
+
 /**
  * @brief Prints the specified graph.
  *
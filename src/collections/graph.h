@@ -2,10 +2,15 @@
 #define GRAPH_H_INCLUDED
 
 #include <assert.h>
+#include <fcntl.h>
+#include <pthread.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include "../utilities/array_util.h"
@@ -19,6 +24,24 @@ typedef int* edge;
 typedef int* triangle;
 typedef int* square;
 
+// Binary CSR container. The header is followed by ptr_rows
+// (num_vertices + 1 ints), idx_cols (num_edges ints), then
+// edge_weights (num_edges ints) if the weighted flag is set.
+#define GRAPH_BINARY_MAGIC "GNDCSR\0\0"
+#define GRAPH_BINARY_VERSION 1
+#define GRAPH_BINARY_FLAG_DIRECTED 0x1
+#define GRAPH_BINARY_FLAG_WEIGHTED 0x2
+
+typedef struct GraphBinaryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    int64_t num_vertices;
+    int64_t num_edges;
+    uint64_t checksum;
+    uint64_t reserved[3];
+} GraphBinaryHeader;
+
 typedef struct Graph {
     int num_vertices;
     int num_edges;
@@ -29,18 +52,25 @@ typedef struct Graph {
 // Create and Delete Functions
 Graph* graph_new(int num_vertices, int num_edges, bool is_directed);
 Graph* graph_new_from_file(const char* file_path);
+Graph* graph_new_from_file_parallel(const char* file_path, int num_threads);
+Graph* graph_new_from_binary_file(const char* file_path, bool should_verify_checksum);
 void graph_delete(Graph** graph);
 
 // Manipulator Functions
 Graph* graph_make_directed(Graph* graph, int (*f)(int, int, int*), int* meta_data);
+Graph* graph_make_directed_parallel(Graph* graph, int (*f)(int, int, int*), int* meta_data, int num_threads);
 
 // Getter Functions
 int graph_get_edge(Graph* graph, int row_idx, int col_idx);
 int* graph_get_out_degrees(Graph* graph);
 int* graph_get_in_degrees(Graph* graph);
 OrderedSet* graph_get_neighbors(Graph* graph, int idx_vertex_u);
+int* graph_get_reverse_edges(Graph* graph);
+int* graph_get_edge_ids(Graph* graph, int* reverse_edges);
 
 // Utility Functions
+bool graph_write_binary_file(Graph* graph, const char* file_path, bool should_write_weights);
+bool graph_convert_to_binary_file(const char* text_file_path, const char* binary_file_path);
 void graph_print(Graph* graph, bool should_print_newline);
 
 #endif
\ No newline at end of file
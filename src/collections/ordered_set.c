@@ -284,9 +284,10 @@ OrderedSet* ordered_set_union(OrderedSet* set_1, OrderedSet* set_2) {
  * @brief Computes the intersection of param set_1 and param set_2.
  *
  * If either set is empty, an empty set is returned. The function then
- * uses a while-loop to iterate through both sets to find the
- * intersection. The intersection is stored in a new OrderedSet and
- * fitted before being returned.
+ * uses set_intersection to find the intersection, which picks a merge,
+ * galloping, or vector kernel based on the sizes of the two sets. The
+ * intersection is stored in a new OrderedSet and fitted before being
+ * returned.
  *
  * @param set_1 The first set to compute the intersection of.
  * @param set_2 The second set to compute the intersection of.
@@ -314,16 +315,7 @@ OrderedSet* ordered_set_intersection(OrderedSet* set_1, OrderedSet* set_2) {
     }
 
     OrderedSet* intersection_set = ordered_set_new(smaller_set->size);
-    int idx_intersection_set = 0;
-
-    for (int i = 0; i < smaller_set->size; i++) {
-        int element = smaller_set->elements[i];
-        if (ordered_set_contains(larger_set, element)) {
-            intersection_set->elements[idx_intersection_set] = element;
-            idx_intersection_set++;
-            intersection_set->size++;
-        }
-    }
+    intersection_set->size = set_intersection(smaller_set->elements, smaller_set->size, larger_set->elements, larger_set->size, intersection_set->elements);
 
     ordered_set_fit(intersection_set);
 
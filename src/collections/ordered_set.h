@@ -8,6 +8,7 @@
 #include <string.h>
 
 #include "../utilities/array_util.h"
+#include "../utilities/set_intersection.h"
 #include "generic_linked_list.h"
 
 typedef struct OrderedSet {
@@ -1,19 +1,104 @@
 #include "queue.h"
 
+/**
+ * This class contains a FIFO queue backed by a circular buffer. The
+ * front of the queue is at elements[idx_head] and the queue wraps
+ * around the end of the buffer, so both enqueue and dequeue are O(1)
+ * and nothing is shifted on removal. The buffer only grows, and it
+ * grows geometrically so that enqueue is amortized O(1). A fixed
+ * capacity queue never grows and never reallocates.
+ */
+
+// Begin Helper Functions
+
+/**
+ * @brief Converts a position relative to the front of the queue into
+ * an index of the circular buffer.
+ *
+ * @param queue The queue to index.
+ * @param offset The position relative to the front of the queue,
+ * where 0 <= offset <= capacity.
+ * @return int The index into queue->elements.
+ */
+static inline int _get_index(Queue* queue, int offset) {
+    int idx = queue->idx_head + offset;
+    return idx >= queue->capacity ? idx - queue->capacity : idx;
+}
+
+/**
+ * @brief Grows the circular buffer to hold at least param
+ * min_capacity elements.
+ *
+ * The capacity is increased by the larger of the resize amount and
+ * the current capacity. If the queue wraps around the end of the old
+ * buffer, the wrapped prefix is copied to just past the old end so
+ * the queue is contiguous from idx_head again.
+ *
+ * @param queue The queue to grow.
+ * @param min_capacity The minimum capacity after growing.
+ */
+static void _grow(Queue* queue, int min_capacity) {
+    assert(queue->is_fixed_capacity == false);
+
+    int old_capacity = queue->capacity;
+    int new_capacity = old_capacity;
+
+    while (new_capacity < min_capacity) {
+        new_capacity += max(max(queue->num_resize_amount, new_capacity), 1);
+    }
+
+    queue->elements = realloc(queue->elements, sizeof(int) * new_capacity);
+    assert(queue->elements != NULL);
+
+    int num_wrapped = queue->idx_head + queue->size - old_capacity;
+
+    if (num_wrapped > 0) {
+        memcpy(&queue->elements[old_capacity], queue->elements, sizeof(int) * num_wrapped);
+    }
+
+    queue->capacity = new_capacity;
+}
+
+// End Helper Functions
+// Begin Create and Delete Functions
+
 /**
  * @brief Create a new Queue object.
  *
- * @param num_resize_amount The resize amount is the value by which
- * the capacity of the queue is increased or decreased when the queue
- * is full or empty, respectively.
+ * @param num_resize_amount The resize amount is the minimum value by
+ * which the capacity of the queue is increased when the queue is
+ * full. It is also the initial capacity of the queue.
  * @return Queue* A pointer to the new Queue object.
  */
 Queue* queue_new(int num_resize_amount) {
+    assert(num_resize_amount >= 0);
+
     Queue* queue = (Queue*)malloc(sizeof(Queue));
-    queue->elements = (int*)malloc(sizeof(int) * num_resize_amount);
+    queue->elements = (int*)malloc(sizeof(int) * max(num_resize_amount, 1));
     queue->capacity = num_resize_amount;
     queue->size = 0;
+    queue->idx_head = 0;
     queue->num_resize_amount = num_resize_amount;
+    queue->is_fixed_capacity = false;
+
+    return queue;
+}
+
+/**
+ * @brief Create a new Queue object that holds at most param capacity
+ * elements at once.
+ *
+ * The queue never reallocates. Enqueueing into a full fixed capacity
+ * queue is an error. This is useful when the number of elements in
+ * the queue is bounded ahead of time, such as peeling each vertex of
+ * a graph at most once.
+ *
+ * @param capacity The maximum number of elements in the queue.
+ * @return Queue* A pointer to the new Queue object.
+ */
+Queue* queue_new_fixed(int capacity) {
+    Queue* queue = queue_new(capacity);
+    queue->is_fixed_capacity = true;
 
     return queue;
 }
@@ -36,13 +121,14 @@ void queue_delete(Queue** ptr_queue) {
     *ptr_queue = NULL;
 }
 
-// Manipulation Functions
+// End Create and Delete Functions
+// Begin Manipulation Functions
 
 /**
  * @brief Add an element to the end of the queue.
  *
  * If the queue is full, the capacity of the queue is increased by
- * the resize amount.
+ * the larger of the resize amount and the current capacity.
  *
  * @param queue The queue to which the element is added.
  * @param element The element to add to the end of the queue.
@@ -51,45 +137,68 @@ void queue_enqueue(Queue* queue, int element) {
     assert(queue != NULL);
 
     if (queue->size == queue->capacity) {
-        int new_capacity = queue->capacity + queue->num_resize_amount;
+        _grow(queue, queue->size + 1);
+    }
 
-        queue->elements = realloc(queue->elements, sizeof(int) * new_capacity);
-        assert(queue->elements != NULL);
+    queue->elements[_get_index(queue, queue->size)] = element;
+    queue->size++;
+}
+
+/**
+ * @brief Add every element of param elements to the end of the queue
+ * in order.
+ *
+ * The queue is grown at most once, then the elements are copied in
+ * at most two contiguous blocks, one up to the end of the circular
+ * buffer and one from the start of it.
+ *
+ * @param queue The queue to which the elements are added.
+ * @param elements The elements to add to the end of the queue.
+ * @param num_elements The number of elements to add.
+ */
+void queue_enqueue_all(Queue* queue, int* elements, int num_elements) {
+    assert(queue != NULL);
+    assert(elements != NULL || num_elements == 0);
+    assert(num_elements >= 0);
 
-        queue->capacity = new_capacity;
+    if (num_elements == 0) {
+        return;
     }
 
-    queue->elements[queue->size] = element;
-    queue->size++;
+    if (queue->size + num_elements > queue->capacity) {
+        _grow(queue, queue->size + num_elements);
+    }
+
+    int idx_tail = _get_index(queue, queue->size);
+    int num_before_wrap = min(num_elements, queue->capacity - idx_tail);
+
+    memcpy(&queue->elements[idx_tail], elements, sizeof(int) * num_before_wrap);
+    memcpy(queue->elements, &elements[num_before_wrap], sizeof(int) * (num_elements - num_before_wrap));
+
+    queue->size += num_elements;
 }
 
 /**
  * @brief Remove an element from the front of the queue.
  *
- * If the difference between the size and the capacity of the queue
- * is greater than or equal to the resize amount, the capacity of the
- * queue is decreased by the resize amount.
+ * The head index is advanced past the removed element. The capacity
+ * of the queue is never decreased.
  *
  * @param queue The queue to which the element is removed.
- * @param element The element to remove from the front of the queue.
  * @return int The element removed from the front of the queue.
  */
 int queue_dequeue(Queue* queue) {
     assert(queue->size > 0);
 
-    int element = queue->elements[0];
-    memmove(queue->elements, &queue->elements[1], sizeof(int) * (queue->capacity - 1));
-    queue->elements[queue->capacity - 1] = 0;
+    int element = queue->elements[queue->idx_head];
 
+    queue->idx_head = _get_index(queue, 1);
     queue->size--;
 
-    if (queue->size < queue->capacity - queue->num_resize_amount) {
-        int new_capacity = queue->capacity - queue->num_resize_amount;
-
-        queue->elements = realloc(queue->elements, sizeof(int) * new_capacity);
-        assert(queue->elements != NULL);
-
-        queue->capacity = new_capacity;
+    // Reset the head when the queue empties so the next elements are
+    // written contiguously from the start of the buffer.
+    if (queue->size == 0) {
+        queue->idx_head = 0;
     }
 
     return element;
@@ -107,9 +216,25 @@ int queue_dequeue(Queue* queue) {
 int queue_peek(Queue* queue) {
     assert(queue->size > 0);
 
-    return queue->elements[0];
+    return queue->elements[queue->idx_head];
 }
 
+/**
+ * @brief Removes every element from the queue without releasing the
+ * memory of the queue.
+ *
+ * @param queue The queue to clear.
+ */
+void queue_clear(Queue* queue) {
+    assert(queue != NULL);
+
+    queue->size = 0;
+    queue->idx_head = 0;
+}
+
+// End Manipulation Functions
+// Begin Membership Functions
+
 /**
  * @brief Checks to see if the list contains a specified element.
  *
@@ -120,10 +245,19 @@ int queue_peek(Queue* queue) {
  * @return bool True if the element exists, otherwise false.
  */
 bool queue_contains(Queue* queue, int element) {
-    return array_linear_search(queue->elements, queue->size, element) > -1;
+    assert(queue != NULL);
+
+    for (int i = 0; i < queue->size; i++) {
+        if (queue->elements[_get_index(queue, i)] == element) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
-// Utility Functions
+// End Membership Functions
+// Begin Utility Functions
 
 /**
  * @brief Checks to see if the queue is empty.
@@ -147,7 +281,7 @@ void queue_print(Queue* queue, bool should_print_newline) {
 
     printf("Queue: [");
     for (int i = 0; i < queue->size; i++) {
-        printf("%d", queue->elements[i]);
+        printf("%d", queue->elements[_get_index(queue, i)]);
         if (i != queue->size - 1) {
             printf(", ");
         }
@@ -157,4 +291,6 @@ void queue_print(Queue* queue, bool should_print_newline) {
     if (should_print_newline) {
         printf("\n");
     }
-}
\ No newline at end of file
+}
+
+// End Utility Functions
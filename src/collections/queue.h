@@ -11,19 +11,24 @@
 typedef struct Queue {
     int capacity;
     int size;
+    int idx_head;
 
     int* elements;
     int num_resize_amount;
+    bool is_fixed_capacity;
 } Queue;
 
 // Create and Delete Functions
 Queue* queue_new(int num_resize_amount);
+Queue* queue_new_fixed(int capacity);
 void queue_delete(Queue** ptr_queue);
 
 // Manipulation Functions
 void queue_enqueue(Queue* queue, int element);
+void queue_enqueue_all(Queue* queue, int* elements, int num_elements);
 int queue_dequeue(Queue* queue);
 int queue_peek(Queue* queue);
+void queue_clear(Queue* queue);
 
 // Membership functions
 bool queue_contains(Queue* queue, int element);
@@ -32,4 +37,4 @@ bool queue_contains(Queue* queue, int element);
 bool queue_is_empty(Queue* queue);
 void queue_print(Queue* queue, bool should_print_newline);
 
-#endif
\ No newline at end of file
+#endif
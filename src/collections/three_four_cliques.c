@@ -1,5 +1,30 @@
 #include "three_four_cliques.h"
 
+/**
+ * @brief Grows the param buffer of k-cliques geometrically until it
+ * can hold at least param min_capacity cliques.
+ *
+ * @param ptr_cliques A pointer to the buffer.
+ * @param ptr_capacity A pointer to the capacity of the buffer in
+ * cliques.
+ * @param k The size of each clique.
+ * @param min_capacity The number of cliques the buffer must hold.
+ */
+static void _reserve(vertex** ptr_cliques, int* ptr_capacity, int k, int min_capacity) {
+    if (min_capacity <= *ptr_capacity) {
+        return;
+    }
+
+    int capacity = max(*ptr_capacity, 16);
+    while (capacity < min_capacity) {
+        capacity *= 2;
+    }
+
+    *ptr_capacity = capacity;
+    *ptr_cliques = realloc(*ptr_cliques, (size_t)capacity * k * sizeof(vertex));
+    assert(*ptr_cliques != NULL);
+}
+
 /**
  * @brief Creates a new collection of three-cliques and
  * four-cliques.
@@ -16,6 +41,8 @@ ThreeFourCliques* three_four_cliques_new(bool is_storing_cliques) {
 
     three_four_cliques->num_three_cliques = 0;
     three_four_cliques->num_four_cliques = 0;
+    three_four_cliques->capacity_three_cliques = 0;
+    three_four_cliques->capacity_four_cliques = 0;
 
     three_four_cliques->three_cliques = NULL;
     three_four_cliques->four_cliques = NULL;
@@ -33,18 +60,8 @@ ThreeFourCliques* three_four_cliques_new(bool is_storing_cliques) {
 void three_four_cliques_delete(ThreeFourCliques** ptr_three_four_cliques) {
     ThreeFourCliques* three_four_cliques = *ptr_three_four_cliques;
 
-    if (three_four_cliques->is_storing_cliques) {
-        for (int i = 0; i < three_four_cliques->num_three_cliques; i++) {
-            free(three_four_cliques->three_cliques[i]);
-        }
-
-        for (int i = 0; i < three_four_cliques->num_four_cliques; i++) {
-            free(three_four_cliques->four_cliques[i]);
-        }
-
-        free(three_four_cliques->three_cliques);
-        free(three_four_cliques->four_cliques);
-    }
+    free(three_four_cliques->three_cliques);
+    free(three_four_cliques->four_cliques);
 
     free(three_four_cliques);
     *ptr_three_four_cliques = NULL;
@@ -77,35 +94,168 @@ void three_four_cliques_record(void* ptr_three_four_cliques, vertex u, vertex v,
     bool is_three_clique = (x == -1);
 
     if (is_three_clique) {
-        three_four_cliques->num_three_cliques++;
+        vertex three_clique[3] = {u, v, w};
+        three_four_cliques_append_three(three_four_cliques, three_clique, 1);
     } else {
-        three_four_cliques->num_four_cliques++;
+        vertex four_clique[4] = {u, v, w, x};
+        three_four_cliques_append_four(three_four_cliques, four_clique, 1);
     }
+}
 
-    if (three_four_cliques->is_storing_cliques == false) {
-        return;
+/**
+ * @brief Sorts the vertices of each clique in the param buffer of
+ * k-cliques. Cliques are small, so insertion sort is used.
+ */
+static inline void _sort_cliques(vertex* cliques, int num_cliques, int k) {
+    for (int idx_clique = 0; idx_clique < num_cliques; idx_clique++) {
+        vertex* clique_to_sort = &cliques[(size_t)idx_clique * k];
+
+        for (int i = 1; i < k; i++) {
+            vertex val = clique_to_sort[i];
+            int j = i - 1;
+
+            while (j >= 0 && clique_to_sort[j] > val) {
+                clique_to_sort[j + 1] = clique_to_sort[j];
+                j--;
+            }
+
+            clique_to_sort[j + 1] = val;
+        }
     }
+}
 
-    if (is_three_clique) {
-        clique three_clique = calloc(3, sizeof(vertex));
-        three_clique[0] = min_3(u, v, w);
-        three_clique[2] = max_3(u, v, w);
-        three_clique[1] = u + v + w - three_clique[0] - three_clique[2];
+/**
+ * @brief Appends the param three-cliques to the collection.
+ *
+ * The buffer holds num_cliques three-cliques back to back. Each
+ * clique is sorted in place before it is copied. If the collection is
+ * not storing cliques, only the count is updated.
+ *
+ * @param three_four_cliques The collection.
+ * @param cliques The three-cliques to append.
+ * @param num_cliques The number of three-cliques in the buffer.
+ */
+void three_four_cliques_append_three(ThreeFourCliques* three_four_cliques, vertex* cliques, int num_cliques) {
+    assert(three_four_cliques != NULL);
+    assert(cliques != NULL || num_cliques == 0);
 
-        three_four_cliques->three_cliques = realloc(three_four_cliques->three_cliques, sizeof(clique) * three_four_cliques->num_three_cliques);
-        three_four_cliques->three_cliques[three_four_cliques->num_three_cliques - 1] = three_clique;
-    } else {
-        clique four_clique = calloc(4, sizeof(vertex));
-        four_clique[0] = u;
-        four_clique[1] = v;
-        four_clique[2] = w;
-        four_clique[3] = x;
+    if (three_four_cliques->is_storing_cliques) {
+        _sort_cliques(cliques, num_cliques, 3);
+        _reserve(&three_four_cliques->three_cliques, &three_four_cliques->capacity_three_cliques, 3, three_four_cliques->num_three_cliques + num_cliques);
+        memcpy(&three_four_cliques->three_cliques[(size_t)three_four_cliques->num_three_cliques * 3], cliques, (size_t)num_cliques * 3 * sizeof(vertex));
+    }
+
+    three_four_cliques->num_three_cliques += num_cliques;
+}
+
+/**
+ * @brief Appends the param four-cliques to the collection.
+ *
+ * The buffer holds num_cliques four-cliques back to back. Each
+ * clique is sorted in place before it is copied. If the collection is
+ * not storing cliques, only the count is updated.
+ *
+ * @param three_four_cliques The collection.
+ * @param cliques The four-cliques to append.
+ * @param num_cliques The number of four-cliques in the buffer.
+ */
+void three_four_cliques_append_four(ThreeFourCliques* three_four_cliques, vertex* cliques, int num_cliques) {
+    assert(three_four_cliques != NULL);
+    assert(cliques != NULL || num_cliques == 0);
+
+    if (three_four_cliques->is_storing_cliques) {
+        _sort_cliques(cliques, num_cliques, 4);
+        _reserve(&three_four_cliques->four_cliques, &three_four_cliques->capacity_four_cliques, 4, three_four_cliques->num_four_cliques + num_cliques);
+        memcpy(&three_four_cliques->four_cliques[(size_t)three_four_cliques->num_four_cliques * 4], cliques, (size_t)num_cliques * 4 * sizeof(vertex));
+    }
+
+    three_four_cliques->num_four_cliques += num_cliques;
+}
+
+/**
+ * @brief Returns a view of a stored three-clique. The view points
+ * into the collection's buffer and is invalidated by any append.
+ *
+ * @param three_four_cliques The collection.
+ * @param idx_clique The index of the three-clique.
+ * @return clique The sorted vertices of the three-clique.
+ */
+clique three_four_cliques_get_three(ThreeFourCliques* three_four_cliques, int idx_clique) {
+    assert(three_four_cliques != NULL);
+    assert(three_four_cliques->is_storing_cliques);
+    assert(idx_clique >= 0 && idx_clique < three_four_cliques->num_three_cliques);
+
+    return &three_four_cliques->three_cliques[(size_t)idx_clique * 3];
+}
+
+/**
+ * @brief Returns a view of a stored four-clique. The view points
+ * into the collection's buffer and is invalidated by any append.
+ *
+ * @param three_four_cliques The collection.
+ * @param idx_clique The index of the four-clique.
+ * @return clique The sorted vertices of the four-clique.
+ */
+clique three_four_cliques_get_four(ThreeFourCliques* three_four_cliques, int idx_clique) {
+    assert(three_four_cliques != NULL);
+    assert(three_four_cliques->is_storing_cliques);
+    assert(idx_clique >= 0 && idx_clique < three_four_cliques->num_four_cliques);
+
+    return &three_four_cliques->four_cliques[(size_t)idx_clique * 4];
+}
 
-        qsort(four_clique, 4, sizeof(vertex), cmp_ints_asc);
+/**
+ * @brief Moves every clique recorded in param ptr_from into param
+ * ptr_into.
+ *
+ * This is used to reduce the per-thread collections of the parallel
+ * clique functions. The counts are summed and, if the cliques are
+ * stored, the buffers of ptr_from are appended to ptr_into and
+ * ptr_from is left empty.
+ *
+ * @param ptr_into The collection to merge into.
+ * @param ptr_from The collection to merge from.
+ */
+void three_four_cliques_merge(void* ptr_into, void* ptr_from) {
+    assert(ptr_into != NULL);
+    assert(ptr_from != NULL);
+
+    ThreeFourCliques* into = ptr_into;
+    ThreeFourCliques* from = ptr_from;
 
-        three_four_cliques->four_cliques = realloc(three_four_cliques->four_cliques, sizeof(clique) * three_four_cliques->num_four_cliques);
-        three_four_cliques->four_cliques[three_four_cliques->num_four_cliques - 1] = four_clique;
+    assert(into->is_storing_cliques == from->is_storing_cliques);
+
+    // The cliques of ptr_from are already sorted, so they are copied
+    // directly rather than through the append functions.
+    if (into->is_storing_cliques) {
+        if (from->num_three_cliques > 0) {
+            _reserve(&into->three_cliques, &into->capacity_three_cliques, 3, into->num_three_cliques + from->num_three_cliques);
+            memcpy(&into->three_cliques[(size_t)into->num_three_cliques * 3], from->three_cliques, (size_t)from->num_three_cliques * 3 * sizeof(vertex));
+        }
+
+        if (from->num_four_cliques > 0) {
+            _reserve(&into->four_cliques, &into->capacity_four_cliques, 4, into->num_four_cliques + from->num_four_cliques);
+            memcpy(&into->four_cliques[(size_t)into->num_four_cliques * 4], from->four_cliques, (size_t)from->num_four_cliques * 4 * sizeof(vertex));
+        }
     }
+
+    into->num_three_cliques += from->num_three_cliques;
+    into->num_four_cliques += from->num_four_cliques;
+    from->num_three_cliques = 0;
+    from->num_four_cliques = 0;
+}
+
+/**
+ * @brief Records a three-clique in the current collection. This
+ * matches the record signature of enumerate_three_cliques.
+ *
+ * @param ptr_three_four_cliques
+ * @param u
+ * @param v
+ * @param w
+ */
+void three_four_cliques_record_three(void* ptr_three_four_cliques, vertex u, vertex v, vertex w) {
+    three_four_cliques_record(ptr_three_four_cliques, u, v, w, -1);
 }
 
 /**
@@ -127,7 +277,8 @@ void three_four_cliques_print(ThreeFourCliques* collector, bool print_cliques) {
     printf("3,4-Cliques { \n\n");
     printf("3-Cliques(%d): ", collector->num_three_cliques);
     for (int i = 0; i < collector->num_three_cliques; i++) {
-        printf("(%d, %d, %d)", collector->three_cliques[i][0], collector->three_cliques[i][1], collector->three_cliques[i][2]);
+        clique three_clique = three_four_cliques_get_three(collector, i);
+        printf("(%d, %d, %d)", three_clique[0], three_clique[1], three_clique[2]);
         if (i < collector->num_three_cliques - 1) {
             printf(", ");
         }
@@ -135,7 +286,8 @@ void three_four_cliques_print(ThreeFourCliques* collector, bool print_cliques) {
 
     printf("\n\n4-Cliques(%d): ", collector->num_four_cliques);
     for (int i = 0; i < collector->num_four_cliques; i++) {
-        printf("(%d, %d, %d, %d)", collector->four_cliques[i][0], collector->four_cliques[i][1], collector->four_cliques[i][2], collector->four_cliques[i][3]);
+        clique four_clique = three_four_cliques_get_four(collector, i);
+        printf("(%d, %d, %d, %d)", four_clique[0], four_clique[1], four_clique[2], four_clique[3]);
         if (i < collector->num_four_cliques - 1) {
             printf(", ");
         }
@@ -11,17 +11,28 @@
 #include "../utilities/math.h"
 #include "../utilities/stopwatch.h"
 
+// The stored cliques are sorted and kept back to back, so three-clique
+// i is three_cliques[3 * i] to three_cliques[3 * i + 2] and four-clique
+// i is four_cliques[4 * i] to four_cliques[4 * i + 3].
 typedef struct ThreeFourCliques {
     bool is_storing_cliques;
     int num_three_cliques;
     int num_four_cliques;
-    clique* three_cliques;
-    clique* four_cliques;
+    int capacity_three_cliques;
+    int capacity_four_cliques;
+    vertex* three_cliques;
+    vertex* four_cliques;
 } ThreeFourCliques;
 
 ThreeFourCliques* three_four_cliques_new(bool is_storing_cliques);
 void three_four_cliques_delete(ThreeFourCliques** ptr_three_four_cliques);
 void three_four_cliques_record(void* ptr_three_four_cliques, vertex u, vertex v, vertex w, vertex x);
+void three_four_cliques_record_three(void* ptr_three_four_cliques, vertex u, vertex v, vertex w);
+void three_four_cliques_append_three(ThreeFourCliques* three_four_cliques, vertex* cliques, int num_cliques);
+void three_four_cliques_append_four(ThreeFourCliques* three_four_cliques, vertex* cliques, int num_cliques);
+void three_four_cliques_merge(void* ptr_into, void* ptr_from);
+clique three_four_cliques_get_three(ThreeFourCliques* three_four_cliques, int idx_clique);
+clique three_four_cliques_get_four(ThreeFourCliques* three_four_cliques, int idx_clique);
 void three_four_cliques_print(ThreeFourCliques* collector, bool print_cliques);
 
 #endif
\ No newline at end of file
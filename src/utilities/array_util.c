@@ -533,17 +533,19 @@ void array_parallel_sort_2(int* array_1, int* array_2, int len_array_1, int len_
 
     for (int i = 0; i < len_array_1; i++) {
         int lower_bound = i;
-        int upper_bound = i;
+        int upper_bound = len_array_1;
 
+        // The last run of equal values in array_1 extends to the end
+        // of the array, so upper_bound defaults to len_array_1.
         for (int j = i + 1; j < len_array_1; j++) {
             if (array_1[j] != array_1[i]) {
                 upper_bound = j;
-                i = j - 1;
                 break;
             }
         }
 
         qsort(&array_2[lower_bound], upper_bound - lower_bound, sizeof(int), cmp_qsort_min);
+        i = upper_bound - 1;
     }
 }
 
@@ -0,0 +1,356 @@
+#include "set_intersection.h"
+
+/**
+ * This class contains the intersection kernels used by the clique
+ * algorithms. Every kernel intersects two strictly increasing arrays
+ * and writes the common elements, in increasing order, into a caller
+ * provided buffer that must hold at least min(len_set_1, len_set_2)
+ * elements and must not overlap either input. Every kernel returns
+ * the number of elements written. set_intersection_size only counts
+ * the common elements and writes nothing.
+ */
+
+// Begin Helper Functions
+
+/**
+ * @brief Finds the index of the first element of param array in
+ * [idx_begin, len_array) that is not less than param val_target.
+ *
+ * The search gallops forward from idx_begin by doubling the step
+ * until it passes param val_target, then binary searches the last
+ * step. This costs O(log(d)) where d is the distance moved, instead
+ * of O(log(len_array)).
+ *
+ * @param array The sorted array to search.
+ * @param len_array The length of the array.
+ * @param idx_begin The index to start galloping from.
+ * @param val_target The value to search for.
+ * @return int The lower bound index of param val_target, which is
+ * len_array if every element is less than param val_target.
+ */
+static inline int _gallop(const int* array, int len_array, int idx_begin, int val_target) {
+    if (idx_begin >= len_array || array[idx_begin] >= val_target) {
+        return idx_begin;
+    }
+
+    // array[idx_lower_bound] < val_target is maintained.
+    int idx_lower_bound = idx_begin;
+    int step = 1;
+
+    while (idx_lower_bound + step < len_array && array[idx_lower_bound + step] < val_target) {
+        idx_lower_bound += step;
+        step <<= 1;
+    }
+
+    int idx_upper_bound = idx_lower_bound + step < len_array ? idx_lower_bound + step : len_array;
+
+    // Binary search (idx_lower_bound, idx_upper_bound] for the first
+    // element not less than val_target.
+    while (idx_upper_bound - idx_lower_bound > 1) {
+        int idx_middle = idx_lower_bound + (idx_upper_bound - idx_lower_bound) / 2;
+
+        if (array[idx_middle] < val_target) {
+            idx_lower_bound = idx_middle;
+        } else {
+            idx_upper_bound = idx_middle;
+        }
+    }
+
+    return idx_upper_bound;
+}
+
+// End Helper Functions
+// Begin Intersection Functions
+
+/**
+ * @brief Intersects two sorted sets with a linear merge.
+ *
+ * This is O(len_set_1 + len_set_2) and is the fastest scalar kernel
+ * when the sets are of similar size.
+ *
+ * @param set_1 The first sorted set.
+ * @param len_set_1 The length of the first set.
+ * @param set_2 The second sorted set.
+ * @param len_set_2 The length of the second set.
+ * @param intersection The output buffer.
+ * @return int The number of elements in the intersection.
+ */
+int set_intersection_merge(const int* set_1, int len_set_1, const int* set_2, int len_set_2, int* intersection) {
+    int idx_set_1 = 0;
+    int idx_set_2 = 0;
+    int len_intersection = 0;
+
+    while (idx_set_1 < len_set_1 && idx_set_2 < len_set_2) {
+        int element_1 = set_1[idx_set_1];
+        int element_2 = set_2[idx_set_2];
+
+        if (element_1 < element_2) {
+            idx_set_1++;
+        } else if (element_1 > element_2) {
+            idx_set_2++;
+        } else {
+            intersection[len_intersection++] = element_1;
+            idx_set_1++;
+            idx_set_2++;
+        }
+    }
+
+    return len_intersection;
+}
+
+/**
+ * @brief Intersects a small sorted set with a much larger sorted set
+ * by galloping through the larger set.
+ *
+ * For every element of the small set, the larger set is galloped
+ * forward from the previous match position. This is
+ * O(len_small_set * log(len_large_set / len_small_set)), which is
+ * much cheaper than a linear merge when the sizes are skewed, such as
+ * intersecting the neighborhood of a low degree vertex with the
+ * neighborhood of a hub.
+ *
+ * @param small_set The smaller sorted set.
+ * @param len_small_set The length of the smaller set.
+ * @param large_set The larger sorted set.
+ * @param len_large_set The length of the larger set.
+ * @param intersection The output buffer.
+ * @return int The number of elements in the intersection.
+ */
+int set_intersection_galloping(const int* small_set, int len_small_set, const int* large_set, int len_large_set, int* intersection) {
+    int idx_large_set = 0;
+    int len_intersection = 0;
+
+    for (int i = 0; i < len_small_set && idx_large_set < len_large_set; i++) {
+        int element = small_set[i];
+        idx_large_set = _gallop(large_set, len_large_set, idx_large_set, element);
+
+        if (idx_large_set < len_large_set && large_set[idx_large_set] == element) {
+            intersection[len_intersection++] = element;
+            idx_large_set++;
+        }
+    }
+
+    return len_intersection;
+}
+
+/**
+ * @brief Intersects two sorted sets by comparing blocks of elements
+ * with vector instructions.
+ *
+ * A block of set_1 is compared against every rotation of a block of
+ * set_2, which compares every pair of elements in the two blocks.
+ * The matching elements of the set_1 block are written out, then the
+ * block with the smaller last element is advanced (both if equal).
+ * AVX2 compares blocks of 8 and SSE4 compares blocks of 4. The tails
+ * are finished with a linear merge. Without either instruction set,
+ * this is a linear merge.
+ *
+ * @param set_1 The first sorted set.
+ * @param len_set_1 The length of the first set.
+ * @param set_2 The second sorted set.
+ * @param len_set_2 The length of the second set.
+ * @param intersection The output buffer.
+ * @return int The number of elements in the intersection.
+ */
+int set_intersection_simd(const int* set_1, int len_set_1, const int* set_2, int len_set_2, int* intersection) {
+    int idx_set_1 = 0;
+    int idx_set_2 = 0;
+    int len_intersection = 0;
+
+#if defined(__AVX2__)
+    const __m256i rotate_1 = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+
+    while (idx_set_1 + 8 <= len_set_1 && idx_set_2 + 8 <= len_set_2) {
+        __m256i block_1 = _mm256_loadu_si256((const __m256i*)&set_1[idx_set_1]);
+        __m256i block_2 = _mm256_loadu_si256((const __m256i*)&set_2[idx_set_2]);
+        __m256i matches = _mm256_cmpeq_epi32(block_1, block_2);
+
+        for (int i = 1; i < 8; i++) {
+            block_2 = _mm256_permutevar8x32_epi32(block_2, rotate_1);
+            matches = _mm256_or_si256(matches, _mm256_cmpeq_epi32(block_1, block_2));
+        }
+
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(matches));
+
+        // Spill the block to extract the matching elements.
+        int block[8];
+        _mm256_storeu_si256((__m256i*)block, block_1);
+
+        while (mask != 0) {
+            intersection[len_intersection++] = block[__builtin_ctz(mask)];
+            mask &= mask - 1;
+        }
+
+        int last_1 = set_1[idx_set_1 + 7];
+        int last_2 = set_2[idx_set_2 + 7];
+        idx_set_1 += (last_1 <= last_2) ? 8 : 0;
+        idx_set_2 += (last_2 <= last_1) ? 8 : 0;
+    }
+#elif defined(__SSE4_1__)
+    while (idx_set_1 + 4 <= len_set_1 && idx_set_2 + 4 <= len_set_2) {
+        __m128i block_1 = _mm_loadu_si128((const __m128i*)&set_1[idx_set_1]);
+        __m128i block_2 = _mm_loadu_si128((const __m128i*)&set_2[idx_set_2]);
+
+        __m128i matches = _mm_cmpeq_epi32(block_1, block_2);
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(block_1, _mm_shuffle_epi32(block_2, _MM_SHUFFLE(0, 3, 2, 1))));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(block_1, _mm_shuffle_epi32(block_2, _MM_SHUFFLE(1, 0, 3, 2))));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(block_1, _mm_shuffle_epi32(block_2, _MM_SHUFFLE(2, 1, 0, 3))));
+
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(matches));
+
+        // Spill the block to extract the matching elements.
+        int block[4];
+        _mm_storeu_si128((__m128i*)block, block_1);
+
+        while (mask != 0) {
+            intersection[len_intersection++] = block[__builtin_ctz(mask)];
+            mask &= mask - 1;
+        }
+
+        int last_1 = set_1[idx_set_1 + 3];
+        int last_2 = set_2[idx_set_2 + 3];
+        idx_set_1 += (last_1 <= last_2) ? 4 : 0;
+        idx_set_2 += (last_2 <= last_1) ? 4 : 0;
+    }
+#endif
+
+    len_intersection += set_intersection_merge(&set_1[idx_set_1], len_set_1 - idx_set_1, &set_2[idx_set_2], len_set_2 - idx_set_2, &intersection[len_intersection]);
+
+    return len_intersection;
+}
+
+/**
+ * @brief Intersects two sorted sets with the kernel best suited to
+ * their sizes.
+ *
+ * If one set is at least SET_INTERSECTION_GALLOP_RATIO times larger
+ * than the other, the smaller set gallops through the larger set.
+ * Otherwise, the vector kernel is used, which falls back to a linear
+ * merge when no vector instruction set is available.
+ *
+ * @param set_1 The first sorted set.
+ * @param len_set_1 The length of the first set.
+ * @param set_2 The second sorted set.
+ * @param len_set_2 The length of the second set.
+ * @param intersection The output buffer, which must hold at least
+ * min(len_set_1, len_set_2) elements.
+ * @return int The number of elements in the intersection.
+ */
+int set_intersection(const int* set_1, int len_set_1, const int* set_2, int len_set_2, int* intersection) {
+    assert(len_set_1 >= 0 && len_set_2 >= 0);
+    assert(intersection != NULL || len_set_1 == 0 || len_set_2 == 0);
+
+    if (len_set_1 == 0 || len_set_2 == 0) {
+        return 0;
+    }
+
+    if (len_set_1 * (long)SET_INTERSECTION_GALLOP_RATIO <= len_set_2) {
+        return set_intersection_galloping(set_1, len_set_1, set_2, len_set_2, intersection);
+    }
+
+    if (len_set_2 * (long)SET_INTERSECTION_GALLOP_RATIO <= len_set_1) {
+        return set_intersection_galloping(set_2, len_set_2, set_1, len_set_1, intersection);
+    }
+
+    return set_intersection_simd(set_1, len_set_1, set_2, len_set_2, intersection);
+}
+
+/**
+ * @brief Counts the elements common to two sorted sets without
+ * writing them.
+ *
+ * This uses the same kernel choice as set_intersection, but the
+ * matches of each vector block are counted with a popcount instead
+ * of being spilled, so counting cliques needs no output buffer.
+ *
+ * @param set_1 The first sorted set.
+ * @param len_set_1 The length of the first set.
+ * @param set_2 The second sorted set.
+ * @param len_set_2 The length of the second set.
+ * @return int The number of elements in the intersection.
+ */
+int set_intersection_size(const int* set_1, int len_set_1, const int* set_2, int len_set_2) {
+    assert(len_set_1 >= 0 && len_set_2 >= 0);
+
+    if (len_set_1 == 0 || len_set_2 == 0) {
+        return 0;
+    }
+
+    // Gallop the smaller set through the larger one if they are skewed.
+    if (len_set_1 * (long)SET_INTERSECTION_GALLOP_RATIO <= len_set_2 || len_set_2 * (long)SET_INTERSECTION_GALLOP_RATIO <= len_set_1) {
+        const int* small_set = len_set_1 <= len_set_2 ? set_1 : set_2;
+        const int* large_set = len_set_1 <= len_set_2 ? set_2 : set_1;
+        int len_small_set = min(len_set_1, len_set_2);
+        int len_large_set = max(len_set_1, len_set_2);
+
+        int idx_large_set = 0;
+        int len_intersection = 0;
+
+        for (int i = 0; i < len_small_set && idx_large_set < len_large_set; i++) {
+            idx_large_set = _gallop(large_set, len_large_set, idx_large_set, small_set[i]);
+
+            if (idx_large_set < len_large_set && large_set[idx_large_set] == small_set[i]) {
+                len_intersection++;
+                idx_large_set++;
+            }
+        }
+
+        return len_intersection;
+    }
+
+    int idx_set_1 = 0;
+    int idx_set_2 = 0;
+    int len_intersection = 0;
+
+#if defined(__AVX2__)
+    const __m256i rotate_1 = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+
+    while (idx_set_1 + 8 <= len_set_1 && idx_set_2 + 8 <= len_set_2) {
+        __m256i block_1 = _mm256_loadu_si256((const __m256i*)&set_1[idx_set_1]);
+        __m256i block_2 = _mm256_loadu_si256((const __m256i*)&set_2[idx_set_2]);
+        __m256i matches = _mm256_cmpeq_epi32(block_1, block_2);
+
+        for (int i = 1; i < 8; i++) {
+            block_2 = _mm256_permutevar8x32_epi32(block_2, rotate_1);
+            matches = _mm256_or_si256(matches, _mm256_cmpeq_epi32(block_1, block_2));
+        }
+
+        len_intersection += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(matches)));
+
+        int last_1 = set_1[idx_set_1 + 7];
+        int last_2 = set_2[idx_set_2 + 7];
+        idx_set_1 += (last_1 <= last_2) ? 8 : 0;
+        idx_set_2 += (last_2 <= last_1) ? 8 : 0;
+    }
+#elif defined(__SSE4_1__)
+    while (idx_set_1 + 4 <= len_set_1 && idx_set_2 + 4 <= len_set_2) {
+        __m128i block_1 = _mm_loadu_si128((const __m128i*)&set_1[idx_set_1]);
+        __m128i block_2 = _mm_loadu_si128((const __m128i*)&set_2[idx_set_2]);
+
+        __m128i matches = _mm_cmpeq_epi32(block_1, block_2);
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(block_1, _mm_shuffle_epi32(block_2, _MM_SHUFFLE(0, 3, 2, 1))));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(block_1, _mm_shuffle_epi32(block_2, _MM_SHUFFLE(1, 0, 3, 2))));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(block_1, _mm_shuffle_epi32(block_2, _MM_SHUFFLE(2, 1, 0, 3))));
+
+        len_intersection += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(matches)));
+
+        int last_1 = set_1[idx_set_1 + 3];
+        int last_2 = set_2[idx_set_2 + 3];
+        idx_set_1 += (last_1 <= last_2) ? 4 : 0;
+        idx_set_2 += (last_2 <= last_1) ? 4 : 0;
+    }
+#endif
+
+    while (idx_set_1 < len_set_1 && idx_set_2 < len_set_2) {
+        int element_1 = set_1[idx_set_1];
+        int element_2 = set_2[idx_set_2];
+
+        len_intersection += element_1 == element_2;
+        idx_set_1 += element_1 <= element_2;
+        idx_set_2 += element_2 <= element_1;
+    }
+
+    return len_intersection;
+}
+
+// End Intersection Functions
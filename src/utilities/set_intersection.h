@@ -0,0 +1,25 @@
+#ifndef SET_INTERSECTION_H_INCLUDED
+#define SET_INTERSECTION_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "math.h"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+// When the larger set is at least this many times the size of the
+// smaller set, galloping is used instead of a linear merge.
+#define SET_INTERSECTION_GALLOP_RATIO 32
+
+// Intersection Functions
+int set_intersection(const int* set_1, int len_set_1, const int* set_2, int len_set_2, int* intersection);
+int set_intersection_merge(const int* set_1, int len_set_1, const int* set_2, int len_set_2, int* intersection);
+int set_intersection_galloping(const int* small_set, int len_small_set, const int* large_set, int len_large_set, int* intersection);
+int set_intersection_simd(const int* set_1, int len_set_1, const int* set_2, int len_set_2, int* intersection);
+int set_intersection_size(const int* set_1, int len_set_1, const int* set_2, int len_set_2);
+
+#endif
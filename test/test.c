@@ -1,13 +1,24 @@
 #include <stdio.h>
 
 #include "test_array_util.h"
+#include "test_bucket_structure.h"
 #include "test_clique.h"
+#include "test_clique_set.h"
+#include "test_clique_sink.h"
 #include "test_compressed_sparse_row.h"
 #include "test_core.h"
+#include "test_disjoint_set.h"
 #include "test_generic_linked_list.h"
 #include "test_graph.h"
+#include "test_maximal_clique.h"
+#include "test_maximum_clique.h"
+#include "test_nucleus_decomposition.h"
 #include "test_ordered_set.h"
+#include "test_pivoter.h"
 #include "test_queue.h"
+#include "test_set_intersection.h"
+#include "test_three_four_nucleus.h"
+#include "test_truss.h"
 
 int main() {
     // Index of the first test to run. Allows us to skip previous
@@ -15,15 +26,26 @@ int main() {
     // not changing.
     int idx_begin_tests = 0;
 
-    void (*test_functions[8])() = {
+    void (*test_functions[19])() = {
         test_generic_linked_list,
         test_array_util,
         test_ordered_set,
+        test_set_intersection,
         test_queue,
+        test_bucket_structure,
+        test_disjoint_set,
+        test_clique_set,
+        test_clique_sink,
         test_compressed_sparse_row,
         test_graph,
         test_core,
         test_clique,
+        test_pivoter,
+        test_maximal_clique,
+        test_maximum_clique,
+        test_truss,
+        test_nucleus_decomposition,
+        test_three_four_nucleus,
     };
 
     int num_tests = sizeof(test_functions) / sizeof(test_functions[0]);
@@ -0,0 +1,196 @@
+#include "test_bucket_structure.h"
+
+void test_bucket_structure_next_batch() {
+    bool is_passing = true;
+    int keys[] = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3};
+    int expected_keys[] = {1, 2, 3, 4, 5, 6, 9};
+    int expected_sizes[] = {2, 1, 2, 1, 2, 1, 1};
+
+    // Two open buckets force the window to move four times.
+    BucketStructure* buckets = bucket_structure_new(NUM_ELEMS, keys, 2);
+    int* batch;
+    int key;
+    int num_batch;
+    int num_batches = 0;
+    int num_extracted = 0;
+
+    while ((num_batch = bucket_structure_next_batch(buckets, &batch, &key)) > 0) {
+        is_passing = is_passing && num_batches < 7;
+        is_passing = is_passing && key == expected_keys[num_batches];
+        is_passing = is_passing && num_batch == expected_sizes[num_batches];
+
+        for (int i = 0; i < num_batch; i++) {
+            is_passing = is_passing && keys[batch[i]] == key;
+        }
+
+        num_extracted += num_batch;
+        num_batches++;
+    }
+
+    is_passing = is_passing && num_batches == 7 && num_extracted == NUM_ELEMS;
+    is_passing = is_passing && bucket_structure_is_empty(buckets);
+
+    bucket_structure_delete(&buckets);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_bucket_structure_decrement() {
+    bool is_passing = true;
+    int keys[] = {2, 5, 5, 7, 30, 30};
+
+    BucketStructure* buckets = bucket_structure_new(6, keys, 4);
+    int* batch;
+    int key;
+
+    is_passing = is_passing && bucket_structure_next_batch(buckets, &batch, &key) == 1;
+    is_passing = is_passing && key == 2 && batch[0] == 0;
+
+    // Lowered to the current key, then clamped there.
+    for (int i = 0; i < 4; i++) {
+        bucket_structure_decrement(buckets, 1);
+    }
+
+    // Moved from the overflow bucket into the window.
+    for (int i = 0; i < 26; i++) {
+        bucket_structure_decrement(buckets, 4);
+    }
+
+    is_passing = is_passing && buckets->keys[1] == 2 && buckets->keys[4] == 4;
+
+    // Elements lowered to the current key come back with the same key.
+    is_passing = is_passing && bucket_structure_next_batch(buckets, &batch, &key) == 1;
+    is_passing = is_passing && key == 2 && batch[0] == 1;
+
+    is_passing = is_passing && bucket_structure_next_batch(buckets, &batch, &key) == 1;
+    is_passing = is_passing && key == 4 && batch[0] == 4;
+
+    is_passing = is_passing && bucket_structure_next_batch(buckets, &batch, &key) == 1;
+    is_passing = is_passing && key == 5 && batch[0] == 2;
+
+    is_passing = is_passing && bucket_structure_next_batch(buckets, &batch, &key) == 1;
+    is_passing = is_passing && key == 7 && batch[0] == 3;
+
+    is_passing = is_passing && bucket_structure_next_batch(buckets, &batch, &key) == 1;
+    is_passing = is_passing && key == 30 && batch[0] == 5;
+
+    is_passing = is_passing && bucket_structure_next_batch(buckets, &batch, &key) == 0;
+
+    bucket_structure_delete(&buckets);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_bucket_structure_update_batch() {
+    bool is_passing = true;
+    int num_elements = 4 * BUCKET_MIN_UPDATES_PER_THREAD;
+    int* keys = malloc(num_elements * sizeof(int));
+    int* elements = malloc(num_elements * sizeof(int));
+    int* new_keys = malloc(num_elements * sizeof(int));
+
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = 10 + i % 500;
+    }
+
+    BucketStructure* serial = bucket_structure_new(num_elements, keys, 16);
+    BucketStructure* parallel = bucket_structure_new(num_elements, keys, 16);
+    int* batch_serial;
+    int* batch_parallel;
+    int key_serial;
+    int key_parallel;
+
+    is_passing = is_passing && bucket_structure_next_batch(serial, &batch_serial, &key_serial) == num_elements / 500 + 1;
+    is_passing = is_passing && bucket_structure_next_batch(parallel, &batch_parallel, &key_parallel) == num_elements / 500 + 1;
+
+    // Every element other than the extracted ones is moved, some
+    // below the current key, some within the window and some up into
+    // the overflow bucket.
+    int num_updates = 0;
+    for (int i = 0; i < num_elements; i++) {
+        if (i % 500 != 0) {
+            elements[num_updates] = i;
+            new_keys[num_updates] = (i * 7) % 1000;
+            num_updates++;
+        }
+    }
+
+    bucket_structure_update_batch(serial, elements, new_keys, num_updates, 1);
+    bucket_structure_update_batch(parallel, elements, new_keys, num_updates, 4);
+
+    is_passing = is_passing && array_is_equal(serial->keys, parallel->keys, num_elements, num_elements);
+
+    int* extracted = calloc(num_elements, sizeof(int));
+    int num_serial;
+    int num_parallel;
+
+    while ((num_serial = bucket_structure_next_batch(serial, &batch_serial, &key_serial)) > 0) {
+        num_parallel = bucket_structure_next_batch(parallel, &batch_parallel, &key_parallel);
+        is_passing = is_passing && num_serial == num_parallel && key_serial == key_parallel;
+
+        for (int i = 0; i < num_parallel && is_passing; i++) {
+            is_passing = is_passing && parallel->keys[batch_parallel[i]] == key_parallel;
+            extracted[batch_parallel[i]]++;
+        }
+    }
+
+    is_passing = is_passing && bucket_structure_next_batch(parallel, &batch_parallel, &key_parallel) == 0;
+
+    for (int i = 0; i < num_elements; i++) {
+        is_passing = is_passing && (i % 500 == 0 || extracted[i] == 1);
+    }
+
+    bucket_structure_delete(&serial);
+    bucket_structure_delete(&parallel);
+    free(keys);
+    free(elements);
+    free(new_keys);
+    free(extracted);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_bucket_structure_compaction() {
+    bool is_passing = true;
+    int num_elements = 100;
+    int num_open = 64;
+    int* keys = malloc(num_elements * sizeof(int));
+
+    for (int i = 0; i < num_elements; i++) {
+        keys[i] = i == 0 ? 0 : 200;
+    }
+
+    BucketStructure* buckets = bucket_structure_new(num_elements, keys, num_open);
+    long max_entries = (long)BUCKET_COMPACTION_FACTOR * num_elements + num_open;
+    int* batch;
+    int key;
+
+    is_passing = is_passing && bucket_structure_next_batch(buckets, &batch, &key) == 1;
+
+    // Lowering element i to key i appends thousands of entries in
+    // total, but never more than the compaction bound at once.
+    for (int i = 1; i < num_elements; i++) {
+        for (int j = 0; j < 200 - i; j++) {
+            bucket_structure_decrement(buckets, i);
+            is_passing = is_passing && buckets->num_entries <= max_entries;
+        }
+    }
+
+    for (int i = 1; i < num_elements; i++) {
+        is_passing = is_passing && bucket_structure_next_batch(buckets, &batch, &key) == 1;
+        is_passing = is_passing && key == i && batch[0] == i;
+    }
+
+    is_passing = is_passing && bucket_structure_next_batch(buckets, &batch, &key) == 0;
+
+    bucket_structure_delete(&buckets);
+    free(keys);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_bucket_structure() {
+    test_bucket_structure_next_batch();
+    test_bucket_structure_decrement();
+    test_bucket_structure_update_batch();
+    test_bucket_structure_compaction();
+}
@@ -0,0 +1,16 @@
+#ifndef TEST_BUCKET_STRUCTURE_H_INCLUDED
+#define TEST_BUCKET_STRUCTURE_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/collections/bucket_structure.h"
+#include "../src/utilities/array_util.h"
+#include "../src/utilities/print_format.h"
+#include "test_params.h"
+
+void test_bucket_structure();
+
+#endif
@@ -1,5 +1,363 @@
 #include "test_clique.h"
 
+// The number of 3-cliques and 4-cliques in data/input/sample.
+#define NUM_SAMPLE_THREE_CLIQUES 15
+#define NUM_SAMPLE_FOUR_CLIQUES 2
+
+// The number of 3-cliques to 6-cliques in data/input/ca-netscience.
+#define NUM_NETSCIENCE_THREE_CLIQUES 921
+#define NUM_NETSCIENCE_FOUR_CLIQUES 631
+#define NUM_NETSCIENCE_FIVE_CLIQUES 358
+#define NUM_NETSCIENCE_SIX_CLIQUES 166
+
+#define NUM_ORIENTATIONS 3
+
+static const CliqueOrientation orientations[NUM_ORIENTATIONS] = {ORIENTATION_DEGREE, ORIENTATION_VERTEX_ID, ORIENTATION_DEGENERACY};
+
+/**
+ * @brief Checks that every stored three-clique is distinct.
+ *
+ * @param collector The collection of three-cliques.
+ * @return bool True if no three-clique was recorded twice.
+ */
+static bool _are_three_cliques_distinct(ThreeFourCliques* collector) {
+    for (int i = 0; i < collector->num_three_cliques; i++) {
+        for (int j = i + 1; j < collector->num_three_cliques; j++) {
+            if (memcmp(three_four_cliques_get_three(collector, i), three_four_cliques_get_three(collector, j), 3 * sizeof(vertex)) == 0) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void test_enumerate_three_cliques() {
+    Graph* graph = graph_new_from_file("data/input/sample");
+    bool is_passing = true;
+
+    for (int i = 0; i < NUM_ORIENTATIONS; i++) {
+        ThreeFourCliques* collector = three_four_cliques_new(true);
+
+        enumerate_three_cliques(graph, orientations[i], collector, three_four_cliques_record_three);
+
+        is_passing = is_passing && collector->num_three_cliques == NUM_SAMPLE_THREE_CLIQUES;
+        is_passing = is_passing && _are_three_cliques_distinct(collector);
+
+        three_four_cliques_delete(&collector);
+    }
+
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_enumerate_four_cliques() {
+    Graph* graph = graph_new_from_file("data/input/sample");
+    Graph* netscience_graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    bool is_passing = true;
+
+    for (int i = 0; i < NUM_ORIENTATIONS; i++) {
+        ThreeFourCliques* collector = three_four_cliques_new(false);
+        enumerate_four_cliques(graph, orientations[i], collector, three_four_cliques_record);
+
+        is_passing = is_passing && collector->num_three_cliques == NUM_SAMPLE_THREE_CLIQUES;
+        is_passing = is_passing && collector->num_four_cliques == NUM_SAMPLE_FOUR_CLIQUES;
+
+        three_four_cliques_delete(&collector);
+
+        collector = three_four_cliques_new(false);
+        enumerate_four_cliques(netscience_graph, orientations[i], collector, three_four_cliques_record);
+
+        is_passing = is_passing && collector->num_three_cliques == NUM_NETSCIENCE_THREE_CLIQUES;
+        is_passing = is_passing && collector->num_four_cliques == NUM_NETSCIENCE_FOUR_CLIQUES;
+
+        three_four_cliques_delete(&collector);
+    }
+
+    graph_delete(&graph);
+    graph_delete(&netscience_graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_enumerate_three_cliques_parallel() {
+    Graph* graph = graph_new_from_file("data/input/sample");
+
+    int num_threads = 4;
+    ThreeFourCliques* collectors[4];
+
+    for (int i = 0; i < num_threads; i++) {
+        collectors[i] = three_four_cliques_new(true);
+    }
+
+    enumerate_three_cliques_parallel(graph, ORIENTATION_DEGENERACY, num_threads, (void**)collectors, three_four_cliques_record_three, three_four_cliques_merge);
+
+    bool is_passing = collectors[0]->num_three_cliques == NUM_SAMPLE_THREE_CLIQUES;
+    is_passing = is_passing && _are_three_cliques_distinct(collectors[0]);
+
+    for (int i = 1; i < num_threads; i++) {
+        is_passing = is_passing && collectors[i]->num_three_cliques == 0;
+    }
+
+    for (int i = 0; i < num_threads; i++) {
+        three_four_cliques_delete(&collectors[i]);
+    }
+
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+/**
+ * @brief Counts the k-cliques reported by enumerate_k_cliques_callback.
+ */
+static void _count_k_clique(void* ptr_count, clique k_clique, int k) {
+    (void)k_clique;
+    (void)k;
+    (*(long*)ptr_count)++;
+}
+
+void test_enumerate_k_cliques_callback() {
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    long expected_counts[] = {NUM_NETSCIENCE_THREE_CLIQUES, NUM_NETSCIENCE_FOUR_CLIQUES, NUM_NETSCIENCE_FIVE_CLIQUES, NUM_NETSCIENCE_SIX_CLIQUES};
+    bool is_passing = true;
+
+    for (int i = 0; i < NUM_ORIENTATIONS; i++) {
+        for (int k = 3; k <= 6; k++) {
+            long count = 0;
+            enumerate_k_cliques_callback(graph, k, orientations[i], &count, _count_k_clique);
+            is_passing = is_passing && count == expected_counts[k - 3];
+        }
+    }
+
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_enumerate_k_cliques() {
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    bool is_passing = true;
+
+    for (int i = 0; i < NUM_ORIENTATIONS; i++) {
+        CliqueSet* five_cliques = enumerate_k_cliques(graph, 5, ENGINE_CHIBA_NISHIZEKI, orientations[i]);
+        CliqueSet* six_cliques = enumerate_k_cliques(graph, 6, ENGINE_CHIBA_NISHIZEKI, orientations[i]);
+
+        is_passing = is_passing && five_cliques->size == NUM_NETSCIENCE_FIVE_CLIQUES;
+        is_passing = is_passing && six_cliques->size == NUM_NETSCIENCE_SIX_CLIQUES;
+
+        clique_set_delete(&five_cliques);
+        clique_set_delete(&six_cliques);
+    }
+
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_enumerate_cliques_batched() {
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    bool is_passing = true;
+
+    for (int i = 0; i < NUM_ORIENTATIONS; i++) {
+        long num_three_cliques = 0;
+        CliqueSet* three_cliques = clique_set_new(3, 1);
+        CliqueSet* four_cliques = clique_set_new(4, 1);
+
+        CliqueSink* three_counter = clique_sink_new_counter(3, &num_three_cliques);
+        CliqueSink* three_store = clique_sink_new_store(three_cliques);
+        CliqueSink* four_store = clique_sink_new_store(four_cliques);
+
+        enumerate_three_cliques_batched(graph, orientations[i], three_counter);
+        enumerate_four_cliques_batched(graph, orientations[i], three_store, four_store);
+
+        CliqueSet* expected_four_cliques = enumerate_k_cliques(graph, 4, ENGINE_CHIBA_NISHIZEKI, orientations[i]);
+
+        is_passing = is_passing && num_three_cliques == NUM_NETSCIENCE_THREE_CLIQUES;
+        is_passing = is_passing && three_cliques->size == NUM_NETSCIENCE_THREE_CLIQUES;
+        is_passing = is_passing && clique_set_is_equal(four_cliques, expected_four_cliques);
+
+        clique_sink_delete(&three_counter);
+        clique_sink_delete(&three_store);
+        clique_sink_delete(&four_store);
+        clique_set_delete(&three_cliques);
+        clique_set_delete(&four_cliques);
+        clique_set_delete(&expected_four_cliques);
+    }
+
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_count_cliques() {
+    Graph* sample_graph = graph_new_from_file("data/input/sample");
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    long expected_counts[] = {NUM_NETSCIENCE_THREE_CLIQUES, NUM_NETSCIENCE_FOUR_CLIQUES, NUM_NETSCIENCE_FIVE_CLIQUES, NUM_NETSCIENCE_SIX_CLIQUES};
+    bool is_passing = true;
+
+    for (int i = 0; i < NUM_ORIENTATIONS; i++) {
+        is_passing = is_passing && count_three_cliques(sample_graph, orientations[i]) == NUM_SAMPLE_THREE_CLIQUES;
+        is_passing = is_passing && count_four_cliques(sample_graph, orientations[i]) == NUM_SAMPLE_FOUR_CLIQUES;
+        is_passing = is_passing && count_three_cliques(graph, orientations[i]) == NUM_NETSCIENCE_THREE_CLIQUES;
+        is_passing = is_passing && count_four_cliques(graph, orientations[i]) == NUM_NETSCIENCE_FOUR_CLIQUES;
+
+        for (int k = 3; k <= 6; k++) {
+            is_passing = is_passing && count_k_cliques(graph, k, orientations[i]) == expected_counts[k - 3];
+        }
+    }
+
+    is_passing = is_passing && count_k_cliques(graph, 1, ORIENTATION_DEGREE) == graph->num_vertices;
+    is_passing = is_passing && count_k_cliques(graph, 2, ORIENTATION_DEGREE) == graph->num_edges / 2;
+
+    graph_delete(&sample_graph);
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+/**
+ * @brief Adds one to the count of every vertex of the clique.
+ */
+static void _count_clique_vertices(void* ptr_vertex_counts, clique k_clique, int k) {
+    for (int i = 0; i < k; i++) {
+        ((long*)ptr_vertex_counts)[k_clique[i]]++;
+    }
+}
+
+void test_count_cliques_local() {
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    int* reverse_edges = graph_get_reverse_edges(graph);
+    int* edge_ids = graph_get_edge_ids(graph, reverse_edges);
+    int num_edges = graph->num_edges / 2;
+    bool is_passing = true;
+
+    for (int k = 2; k <= 6; k++) {
+        long* vertex_counts = count_k_cliques_per_vertex(graph, k, ORIENTATION_DEGENERACY);
+        long* edge_counts = count_k_cliques_per_edge(graph, k, ORIENTATION_DEGREE, edge_ids);
+        long* expected_vertex_counts = calloc(graph->num_vertices, sizeof(long));
+
+        enumerate_k_cliques_callback(graph, k, ORIENTATION_VERTEX_ID, expected_vertex_counts, _count_clique_vertices);
+
+        long num_edge_memberships = 0;
+        for (int e = 0; e < num_edges; e++) {
+            num_edge_memberships += edge_counts[e];
+        }
+
+        is_passing = is_passing && memcmp(vertex_counts, expected_vertex_counts, graph->num_vertices * sizeof(long)) == 0;
+        is_passing = is_passing && num_edge_memberships == count_k_cliques(graph, k, ORIENTATION_DEGREE) * k * (k - 1) / 2;
+
+        free(vertex_counts);
+        free(edge_counts);
+        free(expected_vertex_counts);
+    }
+
+    // The per-edge triangle counts are the edge supports.
+    long* edge_counts = count_k_cliques_per_edge(graph, 3, ORIENTATION_DEGENERACY, edge_ids);
+    int* supports = get_edge_supports(graph, edge_ids);
+
+    for (int e = 0; e < num_edges; e++) {
+        is_passing = is_passing && edge_counts[e] == supports[e];
+    }
+
+    free(edge_counts);
+    free(supports);
+    free(reverse_edges);
+    free(edge_ids);
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+/**
+ * @brief Checks that the unrolled kernels of
+ * enumerate_k_cliques_callback and the recursive search past
+ * CLIQUE_MAX_UNROLLED_K agree with edge-oriented branching.
+ */
+void test_enumerate_k_cliques_kernels() {
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    bool is_passing = true;
+
+    for (int k = 2; k <= CLIQUE_MAX_UNROLLED_K + 2; k++) {
+        long vertex_count = 0;
+        long edge_count = 0;
+
+        enumerate_k_cliques_callback(graph, k, ORIENTATION_DEGENERACY, &vertex_count, _count_k_clique);
+        enumerate_k_cliques_ebbkc(graph, k, &edge_count, _count_k_clique);
+
+        is_passing = is_passing && vertex_count == edge_count;
+    }
+
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+/**
+ * @brief Checks that edge-oriented branching reports the same
+ * k-cliques as Chiba-Nishizeki's algorithm.
+ */
+void test_enumerate_k_cliques_ebbkc() {
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    long expected_counts[] = {NUM_NETSCIENCE_THREE_CLIQUES, NUM_NETSCIENCE_FOUR_CLIQUES, NUM_NETSCIENCE_FIVE_CLIQUES, NUM_NETSCIENCE_SIX_CLIQUES};
+    bool is_passing = true;
+
+    for (int k = 3; k <= 6; k++) {
+        long count = 0;
+        enumerate_k_cliques_ebbkc(graph, k, &count, _count_k_clique);
+        is_passing = is_passing && count == expected_counts[k - 3];
+    }
+
+    for (int k = 1; k <= 7; k++) {
+        CliqueSet* edge_cliques = enumerate_k_cliques(graph, k, ENGINE_EBBKC, ORIENTATION_DEGREE);
+        CliqueSet* vertex_cliques = enumerate_k_cliques(graph, k, ENGINE_CHIBA_NISHIZEKI, ORIENTATION_DEGENERACY);
+
+        is_passing = is_passing && clique_set_is_equal(edge_cliques, vertex_cliques);
+
+        clique_set_delete(&edge_cliques);
+        clique_set_delete(&vertex_cliques);
+    }
+
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+/**
+ * @brief Checks that the degeneracy orientation bounds every
+ * out-degree by the degeneracy of the graph.
+ */
+void test_get_oriented_graph() {
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    Graph* directed_graph = get_oriented_graph(graph, ORIENTATION_DEGENERACY);
+    CoreDecomposition* decomposition = run_core_decomposition(graph);
+
+    int* out_degrees = graph_get_out_degrees(directed_graph);
+    bool is_passing = directed_graph->num_edges == graph->num_edges / 2;
+
+    for (vertex u = 0; u < graph->num_vertices; u++) {
+        is_passing = is_passing && out_degrees[u] <= decomposition->degeneracy;
+    }
+
+    free(out_degrees);
+    core_decomposition_delete(&decomposition);
+    graph_delete(&directed_graph);
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
 void test_clique() {
-    printf("No test for clique algorithms yet.\n");
-}
\ No newline at end of file
+    test_enumerate_three_cliques();
+    test_enumerate_four_cliques();
+    test_enumerate_three_cliques_parallel();
+    test_enumerate_k_cliques();
+    test_enumerate_k_cliques_callback();
+    test_enumerate_k_cliques_ebbkc();
+    test_enumerate_k_cliques_kernels();
+    test_enumerate_cliques_batched();
+    test_count_cliques();
+    test_count_cliques_local();
+    test_get_oriented_graph();
+}
@@ -1,8 +1,17 @@
 #ifndef TEST_CLIQUE_H_INCLUDED
 #define TEST_CLIQUE_H_INCLUDED
 
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/algorithms/clique.h"
+#include "../src/collections/graph.h"
+#include "../src/collections/three_four_cliques.h"
 #include "../src/utilities/print_format.h"
 
 void test_clique();
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,97 @@
+#include "test_clique_set.h"
+
+void test_clique_set_insert() {
+    CliqueSet* clique_set = clique_set_new(3, 1);
+
+    vertex cliques[4][3] = {{5, 1, 3}, {0, 2, 1}, {3, 5, 1}, {2, 4, 3}};
+    bool expected_inserted[] = {true, true, false, true};
+    int expected_elements[] = {0, 1, 2, 1, 3, 5, 2, 3, 4};
+
+    bool is_passing = true;
+
+    for (int i = 0; i < 4; i++) {
+        is_passing = is_passing && clique_set_insert(clique_set, cliques[i]) == expected_inserted[i];
+    }
+
+    is_passing = is_passing && clique_set->size == 3;
+    is_passing = is_passing && clique_set->is_sorted == false;
+
+    clique_set_finalize(clique_set);
+
+    is_passing = is_passing && clique_set->is_sorted;
+    is_passing = is_passing && memcmp(clique_set->elements, expected_elements, sizeof(expected_elements)) == 0;
+
+    vertex missing_clique[] = {1, 2, 3};
+    is_passing = is_passing && clique_set_find(clique_set, clique_set_get(clique_set, 1)) == 1;
+    is_passing = is_passing && clique_set_find(clique_set, missing_clique) == -1;
+
+    clique_set_delete(&clique_set);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_clique_set_insert_many() {
+    CliqueSet* clique_set = clique_set_new(4, 1);
+    int num_cliques = 20000;
+
+    bool is_passing = true;
+
+    // Insert every clique twice in a scrambled order, forcing the hash
+    // table to grow many times.
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < num_cliques; i++) {
+            int j = (i * 7919) % num_cliques;
+            vertex four_clique[] = {j + 3, j, j + 2, j + 1};
+            is_passing = is_passing && clique_set_insert(clique_set, four_clique) == (pass == 0);
+        }
+    }
+
+    clique_set_finalize(clique_set);
+    is_passing = is_passing && clique_set->size == num_cliques;
+
+    for (int i = 0; i < num_cliques; i++) {
+        vertex four_clique[] = {i, i + 1, i + 2, i + 3};
+        is_passing = is_passing && memcmp(clique_set_get(clique_set, i), four_clique, sizeof(four_clique)) == 0;
+        is_passing = is_passing && clique_set_find(clique_set, four_clique) == i;
+    }
+
+    clique_set_delete(&clique_set);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_clique_set_insert_batch() {
+    CliqueSet* clique_set = clique_set_new(2, 1);
+    CliqueSet* expected_clique_set = clique_set_new(2, 1);
+
+    vertex initial_cliques[] = {1, 2, 5, 6, 9, 3};
+    vertex batch_cliques[] = {6, 5, 0, 1, 4, 3, 8, 9, 1, 0, 7, 8, 2, 1};
+
+    bool is_passing = true;
+
+    for (int i = 0; i < 3; i++) {
+        clique_set_insert(clique_set, &initial_cliques[2 * i]);
+        clique_set_insert(expected_clique_set, &initial_cliques[2 * i]);
+    }
+
+    for (int i = 0; i < 7; i++) {
+        vertex batch_clique[] = {batch_cliques[2 * i], batch_cliques[2 * i + 1]};
+        clique_set_insert(expected_clique_set, batch_clique);
+    }
+
+    clique_set_insert_batch(clique_set, batch_cliques, 7);
+
+    is_passing = is_passing && clique_set->size == 7;
+    is_passing = is_passing && clique_set_is_equal(clique_set, expected_clique_set);
+
+    clique_set_delete(&clique_set);
+    clique_set_delete(&expected_clique_set);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_clique_set() {
+    test_clique_set_insert();
+    test_clique_set_insert_many();
+    test_clique_set_insert_batch();
+}
@@ -0,0 +1,102 @@
+#include "test_clique_sink.h"
+
+// Enough cliques to fill several batches and leave a partial one.
+#define NUM_SINK_CLIQUES (3 * CLIQUE_SINK_BATCH_SIZE + 17)
+
+/**
+ * @brief Pushes the cliques (i, i + 1, i + 2) for i in
+ * [0, NUM_SINK_CLIQUES) into param sink, then flushes it.
+ */
+static void _push_path_cliques(CliqueSink* sink) {
+    for (int i = 0; i < NUM_SINK_CLIQUES; i++) {
+        vertex three_clique[3] = {i, i + 1, i + 2};
+        clique_sink_push(sink, three_clique);
+    }
+
+    clique_sink_flush(sink);
+}
+
+void test_clique_sink_counter() {
+    long count = 0;
+    CliqueSink* sink = clique_sink_new_counter(3, &count);
+
+    _push_path_cliques(sink);
+    bool is_passing = count == NUM_SINK_CLIQUES && sink->num_buffered == 0;
+
+    clique_sink_delete(&sink);
+    is_passing = is_passing && sink == NULL && count == NUM_SINK_CLIQUES;
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_clique_sink_store() {
+    CliqueSet* clique_set = clique_set_new(3, 1);
+    CliqueSink* sink = clique_sink_new_store(clique_set);
+
+    _push_path_cliques(sink);
+    clique_sink_delete(&sink);
+
+    bool is_passing = clique_set->size == NUM_SINK_CLIQUES;
+
+    for (int i = 0; i < NUM_SINK_CLIQUES; i++) {
+        vertex three_clique[3] = {i, i + 1, i + 2};
+        is_passing = is_passing && clique_set_find(clique_set, three_clique) >= 0;
+    }
+
+    clique_set_delete(&clique_set);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_clique_sink_vertex_counter() {
+    int num_vertices = NUM_SINK_CLIQUES + 2;
+    long* vertex_counts = calloc(num_vertices, sizeof(long));
+    CliqueSink* sink = clique_sink_new_vertex_counter(3, vertex_counts);
+
+    _push_path_cliques(sink);
+    clique_sink_delete(&sink);
+
+    // The ends of the path are in fewer cliques.
+    bool is_passing = vertex_counts[0] == 1 && vertex_counts[1] == 2;
+    is_passing = is_passing && vertex_counts[num_vertices - 1] == 1 && vertex_counts[num_vertices - 2] == 2;
+
+    for (int v = 2; v < num_vertices - 2; v++) {
+        is_passing = is_passing && vertex_counts[v] == 3;
+    }
+
+    free(vertex_counts);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_clique_sink_file() {
+    FILE* file = tmpfile();
+    CliqueSink* sink = clique_sink_new_file(3, file);
+
+    _push_path_cliques(sink);
+    clique_sink_delete(&sink);
+
+    rewind(file);
+
+    bool is_passing = true;
+    int num_lines = 0;
+    vertex u, v, w;
+
+    while (fscanf(file, "%d %d %d", &u, &v, &w) == 3) {
+        is_passing = is_passing && u == num_lines && v == num_lines + 1 && w == num_lines + 2;
+        num_lines++;
+    }
+
+    is_passing = is_passing && num_lines == NUM_SINK_CLIQUES;
+
+    fclose(file);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_clique_sink() {
+    test_clique_sink_counter();
+    test_clique_sink_store();
+    test_clique_sink_vertex_counter();
+    test_clique_sink_file();
+}
@@ -0,0 +1,15 @@
+#ifndef TEST_CLIQUE_SINK_H_INCLUDED
+#define TEST_CLIQUE_SINK_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/collections/clique_sink.h"
+#include "../src/utilities/print_format.h"
+
+void test_clique_sink();
+
+#endif
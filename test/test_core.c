@@ -1,6 +1,6 @@
 #include "test_core.h"
 
-void test_core() {
+void test_get_vertices_not_in_k_core() {
     Graph* undirected_graph = graph_new_from_file("data/input/sample");
 
     bool expected_removed_k3[] = {false, false, false, false, false, false, false, false, false, false, false, true, true, true, true};
@@ -19,4 +19,98 @@ void test_core() {
     graph_delete(&undirected_graph);
 
     print_test_result(__FILE__, __func__, is_passing);
-}
\ No newline at end of file
+}
+
+void test_run_core_decomposition() {
+    Graph* undirected_graph = graph_new_from_file("data/input/sample");
+
+    int expected_core_numbers[] = {3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 2, 2, 2, 2};
+
+    CoreDecomposition* decomposition = run_core_decomposition(undirected_graph);
+
+    bool is_passing = array_is_equal(decomposition->core_numbers, expected_core_numbers, decomposition->num_vertices, undirected_graph->num_vertices);
+    is_passing = is_passing && decomposition->degeneracy == 3;
+
+    // Every vertex must have at most degeneracy neighbors that come
+    // after it in the degeneracy ordering.
+    int* ranks = calloc(undirected_graph->num_vertices, sizeof(int));
+    for (int i = 0; i < undirected_graph->num_vertices; i++) {
+        ranks[decomposition->ordering[i]] = i;
+    }
+
+    int* ptr_rows = undirected_graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = undirected_graph->adjacency_matrix->idx_cols;
+
+    for (vertex u = 0; u < undirected_graph->num_vertices; u++) {
+        int num_later_neighbors = 0;
+
+        for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+            if (ranks[idx_cols[idx_nnz]] > ranks[u]) {
+                num_later_neighbors++;
+            }
+        }
+
+        is_passing = is_passing && num_later_neighbors <= decomposition->degeneracy;
+    }
+
+    free(ranks);
+    core_decomposition_delete(&decomposition);
+    graph_delete(&undirected_graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_run_core_decomposition_parallel() {
+    char* paths[] = {"data/input/sample", "data/input/ca-netscience"};
+    int thread_counts[] = {1, 2, 4};
+    bool is_passing = true;
+
+    for (int idx_path = 0; idx_path < 2; idx_path++) {
+        Graph* undirected_graph = graph_new_from_file_parallel(paths[idx_path], 1);
+        int num_vertices = undirected_graph->num_vertices;
+        int* ptr_rows = undirected_graph->adjacency_matrix->ptr_rows;
+        int* idx_cols = undirected_graph->adjacency_matrix->idx_cols;
+        int* ranks = malloc(num_vertices * sizeof(int));
+
+        CoreDecomposition* expected = run_core_decomposition(undirected_graph);
+
+        for (int idx_threads = 0; idx_threads < 3; idx_threads++) {
+            CoreDecomposition* decomposition = run_core_decomposition_parallel(undirected_graph, thread_counts[idx_threads]);
+
+            is_passing = is_passing && array_is_equal(decomposition->core_numbers, expected->core_numbers, num_vertices, num_vertices);
+            is_passing = is_passing && decomposition->degeneracy == expected->degeneracy;
+
+            // Every vertex must have at most core number neighbors
+            // that come after it in the ordering.
+            for (int i = 0; i < num_vertices; i++) {
+                ranks[decomposition->ordering[i]] = i;
+            }
+
+            for (vertex u = 0; u < num_vertices; u++) {
+                int num_later_neighbors = 0;
+
+                for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+                    if (ranks[idx_cols[idx_nnz]] > ranks[u]) {
+                        num_later_neighbors++;
+                    }
+                }
+
+                is_passing = is_passing && num_later_neighbors <= decomposition->core_numbers[u];
+            }
+
+            core_decomposition_delete(&decomposition);
+        }
+
+        free(ranks);
+        core_decomposition_delete(&expected);
+        graph_delete(&undirected_graph);
+    }
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_core() {
+    test_get_vertices_not_in_k_core();
+    test_run_core_decomposition();
+    test_run_core_decomposition_parallel();
+}
@@ -0,0 +1,57 @@
+#include "test_disjoint_set.h"
+
+void test_disjoint_set_union() {
+    DisjointSet* disjoint_set = disjoint_set_new(NUM_ELEMS);
+
+    bool is_passing = disjoint_set->num_sets == NUM_ELEMS;
+
+    // Merge the even elements and the odd elements.
+    for (int i = 2; i < NUM_ELEMS; i++) {
+        disjoint_set_union(disjoint_set, i - 2, i);
+    }
+
+    is_passing = is_passing && disjoint_set->num_sets == 2;
+
+    for (int i = 0; i < NUM_ELEMS; i++) {
+        is_passing = is_passing && disjoint_set_is_same_set(disjoint_set, 0, i) == (i % 2 == 0);
+        is_passing = is_passing && disjoint_set_is_same_set(disjoint_set, 1, i) == (i % 2 == 1);
+    }
+
+    // Merging a set with itself changes nothing.
+    int root = disjoint_set_union(disjoint_set, 0, NUM_ELEMS - 2);
+    is_passing = is_passing && root == disjoint_set_find(disjoint_set, 4) && disjoint_set->num_sets == 2;
+    is_passing = is_passing && disjoint_set->sizes[root] == NUM_ELEMS / 2;
+
+    disjoint_set_union(disjoint_set, 1, 0);
+    is_passing = is_passing && disjoint_set->num_sets == 1;
+    is_passing = is_passing && disjoint_set->sizes[disjoint_set_find(disjoint_set, 3)] == NUM_ELEMS;
+
+    disjoint_set_delete(&disjoint_set);
+    is_passing = is_passing && disjoint_set == NULL;
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_disjoint_set_path_compression() {
+    DisjointSet* disjoint_set = disjoint_set_new(NUM_ELEMS);
+
+    // Build a chain by hand, then check that one find flattens it.
+    for (int i = 1; i < NUM_ELEMS; i++) {
+        disjoint_set->parents[i] = i - 1;
+    }
+
+    bool is_passing = disjoint_set_find(disjoint_set, NUM_ELEMS - 1) == 0;
+
+    for (int i = 0; i < NUM_ELEMS; i++) {
+        is_passing = is_passing && disjoint_set->parents[i] == 0;
+    }
+
+    disjoint_set_delete(&disjoint_set);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_disjoint_set() {
+    test_disjoint_set_union();
+    test_disjoint_set_path_compression();
+}
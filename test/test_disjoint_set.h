@@ -0,0 +1,15 @@
+#ifndef TEST_DISJOINT_SET_H_INCLUDED
+#define TEST_DISJOINT_SET_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/collections/disjoint_set.h"
+#include "../src/utilities/print_format.h"
+#include "test_params.h"
+
+void test_disjoint_set();
+
+#endif
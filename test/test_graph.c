@@ -1,5 +1,186 @@
 #include "test_graph.h"
 
+void test_graph_binary_file() {
+    Graph* text_graph = graph_new_from_file("data/input/sample");
+
+    char file_path[] = "/tmp/test_graph_binary_XXXXXX";
+    int file_descriptor = mkstemp(file_path);
+    close(file_descriptor);
+
+    bool is_passing = graph_convert_to_binary_file("data/input/sample", file_path);
+
+    Graph* binary_graph = graph_new_from_binary_file(file_path, true);
+    is_passing = is_passing && binary_graph != NULL;
+
+    if (binary_graph != NULL) {
+        CompressedSparseRow* text_csr = text_graph->adjacency_matrix;
+        CompressedSparseRow* binary_csr = binary_graph->adjacency_matrix;
+
+        is_passing = is_passing && binary_graph->num_vertices == text_graph->num_vertices;
+        is_passing = is_passing && binary_graph->num_edges == text_graph->num_edges;
+        is_passing = is_passing && binary_graph->is_directed == text_graph->is_directed;
+        is_passing = is_passing && binary_csr->edge_weights == NULL;
+        is_passing = is_passing && array_is_equal(binary_csr->ptr_rows, text_csr->ptr_rows, binary_csr->num_ptr_rows, text_csr->num_ptr_rows);
+        is_passing = is_passing && array_is_equal(binary_csr->idx_cols, text_csr->idx_cols, binary_csr->num_nnzs, text_csr->num_nnzs);
+
+        graph_delete(&binary_graph);
+    }
+
+    // Corrupt one column index so the checksum no longer matches.
+    FILE* file = fopen(file_path, "r+b");
+    fseek(file, sizeof(GraphBinaryHeader) + (text_graph->num_vertices + 1) * sizeof(int), SEEK_SET);
+    int corrupted_col = text_graph->num_vertices - 1;
+    fwrite(&corrupted_col, sizeof(int), 1, file);
+    fclose(file);
+
+    is_passing = is_passing && graph_new_from_binary_file(file_path, true) == NULL;
+
+    // Without the checksum, a column index or row pointer out of range
+    // is still rejected.
+    int corrupted_values[] = {text_graph->num_vertices, -1, text_graph->num_edges + 1};
+    long corrupted_offsets[] = {
+        sizeof(GraphBinaryHeader) + (text_graph->num_vertices + 1) * sizeof(int),
+        sizeof(GraphBinaryHeader) + (text_graph->num_vertices + 1) * sizeof(int),
+        sizeof(GraphBinaryHeader) + sizeof(int),
+    };
+
+    for (int i = 0; i < 3; i++) {
+        is_passing = is_passing && graph_convert_to_binary_file("data/input/sample", file_path);
+
+        file = fopen(file_path, "r+b");
+        fseek(file, corrupted_offsets[i], SEEK_SET);
+        fwrite(&corrupted_values[i], sizeof(int), 1, file);
+        fclose(file);
+
+        is_passing = is_passing && graph_new_from_binary_file(file_path, false) == NULL;
+    }
+
+    unlink(file_path);
+    graph_delete(&text_graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_graph_new_from_file_parallel() {
+    bool is_passing = true;
+
+    Graph* expected_graph = graph_new_from_file("data/input/sample");
+
+    for (int num_threads = 1; num_threads <= 7; num_threads += 3) {
+        Graph* graph = graph_new_from_file_parallel("data/input/sample", num_threads);
+
+        is_passing = is_passing && graph->num_vertices == expected_graph->num_vertices;
+        is_passing = is_passing && graph->num_edges == expected_graph->num_edges;
+        is_passing = is_passing && graph->is_directed == expected_graph->is_directed;
+        is_passing = is_passing && csr_is_equal(graph->adjacency_matrix, expected_graph->adjacency_matrix);
+
+        graph_delete(&graph);
+    }
+
+    graph_delete(&expected_graph);
+
+    // The rows of ca-netscience are not sorted, so graph_new_from_file
+    // cannot read it. The result must not depend on the thread count.
+    expected_graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    is_passing = is_passing && expected_graph->num_edges == 2 * 914;
+
+    for (int num_threads = 2; num_threads <= 8; num_threads *= 2) {
+        Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", num_threads);
+        is_passing = is_passing && csr_is_equal(graph->adjacency_matrix, expected_graph->adjacency_matrix);
+        graph_delete(&graph);
+    }
+
+    graph_delete(&expected_graph);
+
+    // The edges may be listed in any order.
+    char file_path[] = "/tmp/test_graph_parallel_XXXXXX";
+    int file_descriptor = mkstemp(file_path);
+    FILE* file = fdopen(file_descriptor, "w");
+    fprintf(file, "%% undirected\n%% 5 5\n3 4\r\n0 1\n\n2 0\n4 1 1\n1 3");
+    fclose(file);
+
+    Graph* graph = graph_new_from_file_parallel(file_path, 3);
+
+    int expected_ptr_rows[] = {0, 2, 5, 6, 8, 10};
+    int expected_idx_cols[] = {1, 2, 0, 3, 4, 0, 1, 4, 1, 3};
+
+    is_passing = is_passing && graph->num_edges == 10;
+    is_passing = is_passing && array_is_equal(graph->adjacency_matrix->ptr_rows, expected_ptr_rows, 6, 6);
+    is_passing = is_passing && array_is_equal(graph->adjacency_matrix->idx_cols, expected_idx_cols, 10, 10);
+
+    graph_delete(&graph);
+
+    // A file listing more or fewer edges than its header, a vertex out
+    // of range or too large for an int, a malformed line, a self-loop
+    // or a duplicate edge is rejected.
+    char* invalid_files[] = {
+        "% undirected\n% 3 1\n0 1\n1 2\n",
+        "% undirected\n% 3 2\n0 1\n",
+        "% undirected\n% 3 2\n0 1\n1 3\n",
+        "% undirected\n% 3 2\n0 1\n4294967295 2\n",
+        "% undirected\n% 3 2\n0 1\n-1 2\n",
+        "% undirected\n% 3 2\n0 1\na b\n",
+        "% undirected\n% 3 2\n0 1\n2 2\n",
+        "% undirected\n% 3 2\n0 1\n1 0\n",
+    };
+
+    for (int i = 0; i < 8; i++) {
+        file = fopen(file_path, "w");
+        fputs(invalid_files[i], file);
+        fclose(file);
+
+        is_passing = is_passing && graph_new_from_file_parallel(file_path, 2) == NULL;
+    }
+
+    unlink(file_path);
+    is_passing = is_passing && graph_new_from_file_parallel(file_path, 2) == NULL;
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+static int _orient_towards_larger_id(int u, int v, int* _unused) {
+    (void)_unused;
+    return u > v ? u : v;
+}
+
+void test_graph_make_directed() {
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    Graph* directed_graph = graph_make_directed(graph, _orient_towards_larger_id, NULL);
+
+    CompressedSparseRow* csr = graph->adjacency_matrix;
+    CompressedSparseRow* dir_csr = directed_graph->adjacency_matrix;
+
+    bool is_passing = directed_graph->is_directed && directed_graph->num_edges == graph->num_edges / 2;
+
+    // The rows of the directed graph must be the sorted neighbors
+    // with larger ids.
+    for (vertex u = 0; u < graph->num_vertices; u++) {
+        int idx_dir_nnz = dir_csr->ptr_rows[u];
+
+        for (int idx_nnz = csr->ptr_rows[u]; idx_nnz < csr->ptr_rows[u + 1]; idx_nnz++) {
+            if (csr->idx_cols[idx_nnz] > u) {
+                is_passing = is_passing && idx_dir_nnz < dir_csr->ptr_rows[u + 1] && dir_csr->idx_cols[idx_dir_nnz] == csr->idx_cols[idx_nnz];
+                idx_dir_nnz++;
+            }
+        }
+
+        is_passing = is_passing && idx_dir_nnz == dir_csr->ptr_rows[u + 1];
+    }
+
+    for (int num_threads = 2; num_threads <= 8; num_threads *= 2) {
+        Graph* parallel_directed_graph = graph_make_directed_parallel(graph, _orient_towards_larger_id, NULL, num_threads);
+        is_passing = is_passing && csr_is_equal(parallel_directed_graph->adjacency_matrix, dir_csr);
+        graph_delete(&parallel_directed_graph);
+    }
+
+    graph_delete(&directed_graph);
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
 void test_graph() {
-    printf("No test for graph yet.\n");
-}
\ No newline at end of file
+    test_graph_binary_file();
+    test_graph_new_from_file_parallel();
+    test_graph_make_directed();
+}
@@ -6,8 +6,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include "../src/collections/graph.h"
+#include "../src/utilities/array_util.h"
 #include "../src/utilities/print_format.h"
 
 void test_graph();
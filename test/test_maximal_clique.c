@@ -0,0 +1,68 @@
+#include "test_maximal_clique.h"
+
+// The number of maximal cliques of each size in data/input/sample and
+// data/input/ca-netscience, which has one isolated vertex.
+#define MAX_TEST_CLIQUE_SIZE 10
+
+static const long expected_sample_histogram[MAX_TEST_CLIQUE_SIZE] = {0, 0, 7, 7, 2};
+static const long expected_netscience_histogram[MAX_TEST_CLIQUE_SIZE] = {0, 1, 37, 75, 53, 27, 5, 3, 2, 1};
+
+/**
+ * @brief Counts the maximal cliques of each size, where
+ * ptr_histogram holds MAX_TEST_CLIQUE_SIZE counts.
+ */
+static void _record_clique_size(void* ptr_histogram, clique maximal_clique, int size) {
+    (void)maximal_clique;
+    assert(size < MAX_TEST_CLIQUE_SIZE);
+    ((long*)ptr_histogram)[size]++;
+}
+
+/**
+ * @brief Adds the second histogram into the first.
+ */
+static void _reduce_histograms(void* ptr_into, void* ptr_from) {
+    for (int i = 0; i < MAX_TEST_CLIQUE_SIZE; i++) {
+        ((long*)ptr_into)[i] += ((long*)ptr_from)[i];
+    }
+}
+
+void test_enumerate_maximal_cliques() {
+    Graph* sample_graph = graph_new_from_file("data/input/sample");
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+
+    long sample_histogram[MAX_TEST_CLIQUE_SIZE] = {0};
+    long netscience_histogram[MAX_TEST_CLIQUE_SIZE] = {0};
+
+    enumerate_maximal_cliques(sample_graph, sample_histogram, _record_clique_size);
+    enumerate_maximal_cliques(graph, netscience_histogram, _record_clique_size);
+
+    bool is_passing = memcmp(sample_histogram, expected_sample_histogram, sizeof(sample_histogram)) == 0;
+    is_passing = is_passing && memcmp(netscience_histogram, expected_netscience_histogram, sizeof(netscience_histogram)) == 0;
+
+    graph_delete(&sample_graph);
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_enumerate_maximal_cliques_parallel() {
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    int num_threads = 3;
+    bool is_passing = true;
+
+    long histograms[3][MAX_TEST_CLIQUE_SIZE] = {{0}};
+    void* collections[3] = {histograms[0], histograms[1], histograms[2]};
+
+    enumerate_maximal_cliques_parallel(graph, num_threads, collections, _record_clique_size, _reduce_histograms);
+
+    is_passing = is_passing && memcmp(histograms[0], expected_netscience_histogram, sizeof(histograms[0])) == 0;
+
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_maximal_clique() {
+    test_enumerate_maximal_cliques();
+    test_enumerate_maximal_cliques_parallel();
+}
@@ -0,0 +1,16 @@
+#ifndef TEST_MAXIMAL_CLIQUE_H_INCLUDED
+#define TEST_MAXIMAL_CLIQUE_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/algorithms/maximal_clique.h"
+#include "../src/collections/graph.h"
+#include "../src/utilities/print_format.h"
+
+void test_maximal_clique();
+
+#endif
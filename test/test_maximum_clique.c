@@ -0,0 +1,67 @@
+#include "test_maximum_clique.h"
+
+// The clique numbers of data/input/sample and data/input/ca-netscience.
+#define SAMPLE_CLIQUE_NUMBER 4
+#define NETSCIENCE_CLIQUE_NUMBER 9
+
+/**
+ * @brief Checks that every pair of vertices of the clique is an edge.
+ */
+static bool _is_clique(Graph* graph, MaximumClique* maximum_clique) {
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+
+    for (int i = 0; i < maximum_clique->size; i++) {
+        vertex u = maximum_clique->vertices[i];
+
+        for (int j = i + 1; j < maximum_clique->size; j++) {
+            if (array_binary_search_range(idx_cols, graph->num_edges, ptr_rows[u], ptr_rows[u + 1] - 1, maximum_clique->vertices[j]) < 0) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void test_find_maximum_clique() {
+    Graph* sample_graph = graph_new_from_file("data/input/sample");
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+
+    MaximumClique* sample_clique = find_maximum_clique(sample_graph, 0);
+    MaximumClique* netscience_clique = find_maximum_clique(graph, 0);
+
+    bool is_passing = sample_clique->is_optimal && sample_clique->size == SAMPLE_CLIQUE_NUMBER;
+    is_passing = is_passing && _is_clique(sample_graph, sample_clique);
+    is_passing = is_passing && netscience_clique->is_optimal && netscience_clique->size == NETSCIENCE_CLIQUE_NUMBER;
+    is_passing = is_passing && _is_clique(graph, netscience_clique);
+
+    maximum_clique_delete(&sample_clique);
+    maximum_clique_delete(&netscience_clique);
+    graph_delete(&sample_graph);
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+/**
+ * @brief Checks that a search stopped by the time limit still returns
+ * a valid clique, the best found so far.
+ */
+void test_find_maximum_clique_time_limit() {
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    MaximumClique* maximum_clique = find_maximum_clique(graph, 1e-9);
+
+    bool is_passing = maximum_clique->size > 0 && maximum_clique->size <= NETSCIENCE_CLIQUE_NUMBER;
+    is_passing = is_passing && _is_clique(graph, maximum_clique);
+
+    maximum_clique_delete(&maximum_clique);
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_maximum_clique() {
+    test_find_maximum_clique();
+    test_find_maximum_clique_time_limit();
+}
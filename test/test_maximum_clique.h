@@ -0,0 +1,15 @@
+#ifndef TEST_MAXIMUM_CLIQUE_H_INCLUDED
+#define TEST_MAXIMUM_CLIQUE_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/algorithms/maximum_clique.h"
+#include "../src/collections/graph.h"
+#include "../src/utilities/print_format.h"
+
+void test_maximum_clique();
+
+#endif
@@ -0,0 +1,153 @@
+#include "test_nucleus_decomposition.h"
+
+/**
+ * @brief Runs the (r,s) nucleus decomposition on the sample graph
+ * and compares the nucleus numbers against the expected answer.
+ *
+ * @param r
+ * @param s
+ * @param expected The expected nucleus number of each r-clique in
+ * lexicographic order.
+ * @param num_expected The expected number of r-cliques.
+ * @return bool True if the nucleus numbers match, false otherwise.
+ */
+static bool _is_nucleus_decomposition_equal(int r, int s, int* expected, int num_expected) {
+    Graph* graph = graph_new_from_file("data/input/sample");
+    NucleusDecomposition* decomposition = run_nucleus_decomposition(graph, r, s);
+
+    bool is_passing = array_is_equal(decomposition->nucleus_numbers, expected, decomposition->num_r_cliques, num_expected);
+
+    nucleus_decomposition_delete(&decomposition);
+    graph_delete(&graph);
+
+    return is_passing;
+}
+
+void test_nucleus_decomposition_1_2() {
+    int expected[] = {3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 2, 2, 2, 2};
+    bool is_passing = _is_nucleus_decomposition_equal(1, 2, expected, 15);
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_nucleus_decomposition_2_3() {
+    int expected[] = {1, 1, 1, 2, 1, 2, 2, 2, 2, 2, 2, 2, 1, 2, 2, 1, 1, 2, 1, 2, 0, 1, 0, 1, 0, 1, 0, 0, 0, 0};
+    bool is_passing = _is_nucleus_decomposition_equal(2, 3, expected, 30);
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_nucleus_decomposition_3_4() {
+    int expected[] = {0, 0, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0};
+    bool is_passing = _is_nucleus_decomposition_equal(3, 4, expected, 15);
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_nucleus_decomposition_1_3() {
+    int expected[] = {2, 3, 3, 3, 3, 3, 3, 3, 2, 3, 2, 0, 0, 0, 0};
+    bool is_passing = _is_nucleus_decomposition_equal(1, 3, expected, 15);
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+/**
+ * @brief Records the number of iterations and checks that every
+ * updated estimate decreased.
+ */
+static bool _count_local_iterations(void* context, LocalIterationStats* stats) {
+    int* ptr_num_iterations = context;
+    *ptr_num_iterations = stats->iteration;
+
+    return stats->num_updated >= 0 && stats->sum_decrease >= stats->num_updated;
+}
+
+/**
+ * @brief Stops the local decomposition after its first iteration.
+ */
+static bool _stop_local_iterations(void* context, LocalIterationStats* stats) {
+    (void)context;
+    (void)stats;
+
+    return false;
+}
+
+void test_nucleus_decomposition_local() {
+    char* paths[] = {"data/input/sample", "data/input/ca-netscience"};
+    int rs[][2] = {{1, 2}, {2, 3}, {3, 4}, {1, 3}};
+    LocalUpdateMode modes[] = {LOCAL_UPDATE_SYNCHRONOUS, LOCAL_UPDATE_ASYNCHRONOUS};
+    int thread_counts[] = {1, 3};
+    bool is_passing = true;
+
+    for (int idx_path = 0; idx_path < 2; idx_path++) {
+        Graph* graph = graph_new_from_file_parallel(paths[idx_path], 1);
+
+        for (int idx_rs = 0; idx_rs < 4; idx_rs++) {
+            int r = rs[idx_rs][0];
+            int s = rs[idx_rs][1];
+            NucleusDecomposition* expected = run_nucleus_decomposition(graph, r, s);
+
+            for (int idx_mode = 0; idx_mode < 2; idx_mode++) {
+                for (int idx_threads = 0; idx_threads < 2; idx_threads++) {
+                    int num_iterations = 0;
+                    NucleusDecomposition* decomposition = run_nucleus_decomposition_local(graph, r, s, modes[idx_mode], thread_counts[idx_threads], 0, &num_iterations, _count_local_iterations);
+
+                    is_passing = is_passing && decomposition->is_exact && num_iterations > 0;
+                    is_passing = is_passing && decomposition->max_nucleus_number == expected->max_nucleus_number;
+                    is_passing = is_passing && array_is_equal(decomposition->nucleus_numbers, expected->nucleus_numbers, decomposition->num_r_cliques, expected->num_r_cliques);
+
+                    nucleus_decomposition_delete(&decomposition);
+                }
+            }
+
+            // Stopping early leaves upper bounds on the nucleus numbers.
+            NucleusDecomposition* approximate = run_nucleus_decomposition_local(graph, r, s, LOCAL_UPDATE_SYNCHRONOUS, 1, 0, NULL, _stop_local_iterations);
+
+            for (int i = 0; i < approximate->num_r_cliques; i++) {
+                is_passing = is_passing && approximate->nucleus_numbers[i] >= expected->nucleus_numbers[i];
+            }
+
+            nucleus_decomposition_delete(&approximate);
+            nucleus_decomposition_delete(&expected);
+        }
+
+        graph_delete(&graph);
+    }
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_nucleus_decomposition_hierarchy() {
+    Graph* graph = graph_new_from_file("data/input/sample");
+    NucleusDecomposition* decomposition = run_nucleus_decomposition_hierarchy(graph, 2, 3);
+    NucleusHierarchy* hierarchy = decomposition->hierarchy;
+
+    // Two 4-cliques are the 2-nuclei, joined by triangles into one
+    // 1-nucleus, and the 7 edges in no triangle are 0-nuclei.
+    int expected_parents[] = {2, 2, -1, -1, -1, -1, -1, -1, -1, -1};
+    int expected_nucleus_numbers[] = {2, 2, 1, 0, 0, 0, 0, 0, 0, 0};
+    int expected_vertex_counts[] = {4, 4, 11, 2, 2, 2, 2, 2, 2, 2};
+    long expected_edge_counts[] = {6, 6, 23, 1, 1, 1, 1, 1, 1, 1};
+
+    bool is_passing = hierarchy != NULL && hierarchy->num_nodes == 10;
+    is_passing = is_passing && array_is_equal(hierarchy->parents, expected_parents, hierarchy->num_nodes, 10);
+    is_passing = is_passing && array_is_equal(hierarchy->nucleus_numbers, expected_nucleus_numbers, hierarchy->num_nodes, 10);
+    is_passing = is_passing && array_is_equal(hierarchy->vertex_counts, expected_vertex_counts, hierarchy->num_nodes, 10);
+    is_passing = is_passing && memcmp(hierarchy->edge_counts, expected_edge_counts, 10 * sizeof(long)) == 0;
+    is_passing = is_passing && hierarchy->densities[0] == 1.0 && hierarchy->densities[3] == 1.0;
+
+    // Every r-clique lies in a node of its own nucleus number.
+    for (int i = 0; i < decomposition->num_r_cliques; i++) {
+        is_passing = is_passing && hierarchy->nucleus_numbers[hierarchy->r_clique_nodes[i]] == decomposition->nucleus_numbers[i];
+    }
+
+    nucleus_decomposition_delete(&decomposition);
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_nucleus_decomposition() {
+    test_nucleus_decomposition_1_2();
+    test_nucleus_decomposition_2_3();
+    test_nucleus_decomposition_3_4();
+    test_nucleus_decomposition_1_3();
+    test_nucleus_decomposition_local();
+    test_nucleus_decomposition_hierarchy();
+}
@@ -0,0 +1,16 @@
+#ifndef TEST_NUCLEUS_DECOMPOSITION_H_INCLUDED
+#define TEST_NUCLEUS_DECOMPOSITION_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/algorithms/nucleus_decomposition.h"
+#include "../src/collections/graph.h"
+#include "../src/utilities/print_format.h"
+
+void test_nucleus_decomposition();
+
+#endif
@@ -0,0 +1,95 @@
+#include "test_pivoter.h"
+
+void test_count_all_cliques() {
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    CliqueCounts* clique_counts = count_all_cliques(graph, false);
+
+    bool is_passing = clique_counts->vertex_counts == NULL;
+    is_passing = is_passing && clique_counts->counts[1] == graph->num_vertices;
+    is_passing = is_passing && clique_counts->counts[2] == graph->num_edges / 2;
+
+    for (int k = 3; k <= clique_counts->max_clique_size; k++) {
+        is_passing = is_passing && clique_counts->counts[k] == count_k_cliques(graph, k, ORIENTATION_DEGENERACY);
+    }
+
+    // The clique number is the largest k with a k-clique.
+    is_passing = is_passing && count_k_cliques(graph, clique_counts->max_clique_size + 1, ORIENTATION_DEGENERACY) == 0;
+
+    clique_counts_delete(&clique_counts);
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_count_all_cliques_per_vertex() {
+    Graph* graph = graph_new_from_file_parallel("data/input/ca-netscience", 1);
+    CliqueCounts* clique_counts = count_all_cliques(graph, true);
+    bool is_passing = clique_counts->vertex_counts != NULL;
+
+    for (int k = 1; k <= clique_counts->max_clique_size + 1; k++) {
+        long* expected_counts = count_k_cliques_per_vertex(graph, k, ORIENTATION_DEGENERACY);
+
+        for (vertex v = 0; v < graph->num_vertices; v++) {
+            is_passing = is_passing && clique_counts_get_vertex(clique_counts, v, k) == expected_counts[v];
+        }
+
+        free(expected_counts);
+    }
+
+    clique_counts_delete(&clique_counts);
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+/**
+ * @brief Checks the counts of a complete graph, whose only clique
+ * tree path holds one vertex and pivots on every other vertex, so
+ * the counts far exceed any single enumeration.
+ */
+void test_count_all_cliques_complete() {
+    int num_vertices = 80;
+    Graph* graph = graph_new(num_vertices, num_vertices * (num_vertices - 1), false);
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+
+    int idx_nnz = 0;
+    for (vertex u = 0; u < num_vertices; u++) {
+        ptr_rows[u] = idx_nnz;
+
+        for (vertex v = 0; v < num_vertices; v++) {
+            if (u != v) {
+                idx_cols[idx_nnz++] = v;
+            }
+        }
+    }
+
+    ptr_rows[num_vertices] = idx_nnz;
+    graph->adjacency_matrix->is_set = true;
+
+    CliqueCounts* clique_counts = count_all_cliques(graph, true);
+    bool is_passing = clique_counts->max_clique_size == num_vertices;
+
+    double expected_count = 1;
+    for (int k = 1; k <= num_vertices; k++) {
+        expected_count = expected_count * (num_vertices - k + 1) / k;
+        double relative_error = (clique_counts->counts[k] - expected_count) / expected_count;
+        is_passing = is_passing && relative_error < 1e-9 && relative_error > -1e-9;
+
+        // Every vertex is in k / n of the k-cliques.
+        double expected_vertex_count = expected_count * k / num_vertices;
+        double vertex_error = (clique_counts_get_vertex(clique_counts, num_vertices - 1, k) - expected_vertex_count) / expected_vertex_count;
+        is_passing = is_passing && vertex_error < 1e-9 && vertex_error > -1e-9;
+    }
+
+    clique_counts_delete(&clique_counts);
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_pivoter() {
+    test_count_all_cliques();
+    test_count_all_cliques_per_vertex();
+    test_count_all_cliques_complete();
+}
@@ -0,0 +1,16 @@
+#ifndef TEST_PIVOTER_H_INCLUDED
+#define TEST_PIVOTER_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/algorithms/clique.h"
+#include "../src/algorithms/pivoter.h"
+#include "../src/collections/graph.h"
+#include "../src/utilities/print_format.h"
+
+void test_pivoter();
+
+#endif
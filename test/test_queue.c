@@ -38,7 +38,82 @@ void test_queue_dequeue() {
     print_test_result(__FILE__, __func__, is_passing);
 }
 
+void test_queue_wrap_around() {
+    bool is_passing = true;
+    int* answer = array_generate_sequence_shuffled(RANGE_ELEMS_S1_LOW, INC_VALUE, NUM_ELEMS);
+
+    // Interleave enqueues and dequeues so the tail wraps around the
+    // end of the buffer before the queue is forced to grow.
+    Queue* queue = queue_new(4);
+    queue_enqueue(queue, answer[0]);
+    queue_enqueue(queue, answer[1]);
+    queue_enqueue(queue, answer[2]);
+
+    is_passing = is_passing && (queue_dequeue(queue) == answer[0]);
+    is_passing = is_passing && (queue_dequeue(queue) == answer[1]);
+
+    for (int i = 3; i < NUM_ELEMS; i++) {
+        queue_enqueue(queue, answer[i]);
+    }
+
+    is_passing = is_passing && queue_contains(queue, answer[NUM_ELEMS - 1]);
+    is_passing = is_passing && (queue_contains(queue, answer[0]) == false);
+
+    for (int i = 2; i < NUM_ELEMS; i++) {
+        is_passing = is_passing && (queue_dequeue(queue) == answer[i]);
+    }
+
+    is_passing = is_passing && queue_is_empty(queue);
+
+    queue_delete(&queue);
+    free(answer);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_queue_enqueue_all() {
+    bool is_passing = true;
+    int* answer = array_generate_sequence_shuffled(RANGE_ELEMS_S1_LOW, INC_VALUE, NUM_ELEMS);
+
+    Queue* queue = queue_new_fixed(NUM_ELEMS);
+    queue_enqueue_all(queue, answer, NUM_ELEMS / 2);
+
+    for (int i = 0; i < NUM_ELEMS / 2 - 2; i++) {
+        is_passing = is_passing && (queue_dequeue(queue) == answer[i]);
+    }
+
+    // Fill the fixed buffer with a single bulk enqueue so the copy is
+    // split across the end of the buffer.
+    int num_block = NUM_ELEMS / 2 + NUM_ELEMS / 2 - 2;
+    int* block = malloc(sizeof(int) * num_block);
+    memcpy(block, &answer[NUM_ELEMS / 2], sizeof(int) * (NUM_ELEMS / 2));
+    memcpy(&block[NUM_ELEMS / 2], answer, sizeof(int) * (NUM_ELEMS / 2 - 2));
+
+    queue_enqueue_all(queue, block, num_block);
+    is_passing = is_passing && (queue->capacity == NUM_ELEMS);
+    is_passing = is_passing && (queue->size == NUM_ELEMS);
+
+    for (int i = NUM_ELEMS / 2 - 2; i < NUM_ELEMS / 2; i++) {
+        is_passing = is_passing && (queue_dequeue(queue) == answer[i]);
+    }
+
+    for (int i = 0; i < num_block; i++) {
+        is_passing = is_passing && (queue_dequeue(queue) == block[i]);
+    }
+
+    free(block);
+
+    is_passing = is_passing && (queue->size == 0);
+
+    queue_delete(&queue);
+    free(answer);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
 void test_queue() {
     test_queue_enqueue();
     test_queue_dequeue();
+    test_queue_wrap_around();
+    test_queue_enqueue_all();
 }
\ No newline at end of file
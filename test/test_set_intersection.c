@@ -0,0 +1,123 @@
+#include "test_set_intersection.h"
+
+// Begin Helper Functions
+
+/**
+ * @brief Generates the multiples of param step in [0, len_range).
+ *
+ * Two such sets with coprime steps share exactly the multiples of
+ * the product of the steps, which makes the expected intersection
+ * easy to compute.
+ *
+ * @param step The distance between consecutive elements.
+ * @param len_range The exclusive upper bound of the elements.
+ * @param ptr_len_set The number of elements generated.
+ * @return int* The sorted set.
+ */
+static int* _generate_multiples(int step, int len_range, int* ptr_len_set) {
+    *ptr_len_set = (len_range + step - 1) / step;
+    return array_generate_sequence(0, step, *ptr_len_set);
+}
+
+/**
+ * @brief Checks that param kernel intersects the multiples of step_1
+ * and the multiples of step_2 in [0, len_range) into the multiples
+ * of step_1 * step_2.
+ *
+ * @param kernel The intersection kernel to check.
+ * @param step_1 The step of the first set.
+ * @param step_2 The step of the second set, coprime with step_1.
+ * @param len_range The exclusive upper bound of the elements.
+ * @return bool True if the kernel produced the expected set.
+ */
+static bool _is_intersection_correct(int (*kernel)(const int*, int, const int*, int, int*), int step_1, int step_2, int len_range) {
+    int len_set_1, len_set_2, len_expected;
+    int* set_1 = _generate_multiples(step_1, len_range, &len_set_1);
+    int* set_2 = _generate_multiples(step_2, len_range, &len_set_2);
+    int* expected = _generate_multiples(step_1 * step_2, len_range, &len_expected);
+
+    int* intersection = malloc(min(len_set_1, len_set_2) * sizeof(int));
+    int len_intersection = kernel(set_1, len_set_1, set_2, len_set_2, intersection);
+
+    bool is_correct = array_is_equal(intersection, expected, len_intersection, len_expected);
+
+    free(set_1);
+    free(set_2);
+    free(expected);
+    free(intersection);
+
+    return is_correct;
+}
+
+// End Helper Functions
+// Begin Intersection Function Unit Tests
+
+void test_set_intersection_merge() {
+    bool is_passing = _is_intersection_correct(set_intersection_merge, 2, 3, 1000);
+    is_passing = is_passing && _is_intersection_correct(set_intersection_merge, 1, 7, 50);
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_set_intersection_galloping() {
+    bool is_passing = _is_intersection_correct(set_intersection_galloping, 97, 1, 10000);
+    is_passing = is_passing && _is_intersection_correct(set_intersection_galloping, 5, 3, 1000);
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_set_intersection_simd() {
+    bool is_passing = true;
+
+    // Cover full blocks, partial tails, and blocks that only partially
+    // overlap in range.
+    for (int len_range = 1; len_range < 200; len_range += 7) {
+        is_passing = is_passing && _is_intersection_correct(set_intersection_simd, 2, 3, len_range);
+        is_passing = is_passing && _is_intersection_correct(set_intersection_simd, 1, 5, len_range);
+        is_passing = is_passing && _is_intersection_correct(set_intersection_simd, 7, 1, len_range);
+    }
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_set_intersection_dispatch() {
+    bool is_passing = _is_intersection_correct(set_intersection, 2, 3, 1000);
+    is_passing = is_passing && _is_intersection_correct(set_intersection, 1, 101, 10000);
+    is_passing = is_passing && _is_intersection_correct(set_intersection, 101, 1, 10000);
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_set_intersection_size() {
+    bool is_passing = true;
+
+    // Both the galloping and the vector paths are covered.
+    int steps[][2] = {{2, 3}, {1, 5}, {7, 1}, {1, 101}, {101, 1}};
+
+    for (int i = 0; i < 5; i++) {
+        for (int len_range = 1; len_range < 2000; len_range += 97) {
+            int len_set_1, len_set_2, len_expected;
+            int* set_1 = _generate_multiples(steps[i][0], len_range, &len_set_1);
+            int* set_2 = _generate_multiples(steps[i][1], len_range, &len_set_2);
+            int* expected = _generate_multiples(steps[i][0] * steps[i][1], len_range, &len_expected);
+
+            is_passing = is_passing && set_intersection_size(set_1, len_set_1, set_2, len_set_2) == len_expected;
+
+            free(set_1);
+            free(set_2);
+            free(expected);
+        }
+    }
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+// End Intersection Function Unit Tests
+// Begin Entry Function
+
+void test_set_intersection() {
+    test_set_intersection_merge();
+    test_set_intersection_galloping();
+    test_set_intersection_simd();
+    test_set_intersection_dispatch();
+    test_set_intersection_size();
+}
+
+// End Entry Function
@@ -0,0 +1,16 @@
+#ifndef TEST_SET_INTERSECTION_H_INCLUDED
+#define TEST_SET_INTERSECTION_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/utilities/array_util.h"
+#include "../src/utilities/print_format.h"
+#include "../src/utilities/set_intersection.h"
+
+void test_set_intersection();
+
+#endif
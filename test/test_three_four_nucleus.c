@@ -0,0 +1,45 @@
+#include "test_three_four_nucleus.h"
+
+/**
+ * @brief Runs the memory-lean (3,4) nucleus decomposition on the
+ * param graph and compares the triangles, their nucleus numbers and
+ * the number of 4-cliques against run_nucleus_decomposition.
+ *
+ * @param path The path of the graph file.
+ * @return bool True if the decompositions match, false otherwise.
+ */
+static bool _is_three_four_nucleus_equal(char* path) {
+    Graph* graph = graph_new_from_file_parallel(path, 1);
+    ThreeFourNucleusDecomposition* decomposition = run_three_four_nucleus_decomposition(graph);
+    NucleusDecomposition* expected = run_nucleus_decomposition(graph, 3, 4);
+
+    bool is_passing = array_is_equal(decomposition->nucleus_numbers, expected->nucleus_numbers, decomposition->num_triangles, expected->num_r_cliques);
+    is_passing = is_passing && decomposition->num_four_cliques == count_four_cliques(graph, ORIENTATION_DEGENERACY);
+
+    for (int t = 0; t < decomposition->num_triangles && is_passing; t++) {
+        vertex triangle[3];
+        three_four_nucleus_get_triangle(decomposition, t, triangle);
+        is_passing = array_is_equal(triangle, clique_set_get(expected->r_cliques, t), 3, 3);
+    }
+
+    nucleus_decomposition_delete(&expected);
+    three_four_nucleus_decomposition_delete(&decomposition);
+    graph_delete(&graph);
+
+    return is_passing;
+}
+
+void test_three_four_nucleus_sample() {
+    bool is_passing = _is_three_four_nucleus_equal("data/input/sample");
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_three_four_nucleus_netscience() {
+    bool is_passing = _is_three_four_nucleus_equal("data/input/ca-netscience");
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_three_four_nucleus() {
+    test_three_four_nucleus_sample();
+    test_three_four_nucleus_netscience();
+}
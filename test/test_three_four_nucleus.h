@@ -0,0 +1,18 @@
+#ifndef TEST_THREE_FOUR_NUCLEUS_H_INCLUDED
+#define TEST_THREE_FOUR_NUCLEUS_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/algorithms/clique.h"
+#include "../src/algorithms/nucleus_decomposition.h"
+#include "../src/algorithms/three_four_nucleus.h"
+#include "../src/collections/graph.h"
+#include "../src/utilities/print_format.h"
+
+void test_three_four_nucleus();
+
+#endif
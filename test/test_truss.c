@@ -0,0 +1,80 @@
+#include "test_truss.h"
+
+void test_graph_get_edge_ids() {
+    Graph* graph = graph_new_from_file("data/input/sample");
+
+    int* ptr_rows = graph->adjacency_matrix->ptr_rows;
+    int* idx_cols = graph->adjacency_matrix->idx_cols;
+
+    int* reverse_edges = graph_get_reverse_edges(graph);
+    int* edge_ids = graph_get_edge_ids(graph, reverse_edges);
+
+    bool is_passing = true;
+    int idx_expected_edge = 0;
+
+    for (vertex u = 0; u < graph->num_vertices; u++) {
+        for (int idx_nnz = ptr_rows[u]; idx_nnz < ptr_rows[u + 1]; idx_nnz++) {
+            vertex v = idx_cols[idx_nnz];
+            int idx_twin = reverse_edges[idx_nnz];
+
+            // The twin of (u, v) must be (v, u) and share its id.
+            is_passing = is_passing && idx_twin >= ptr_rows[v] && idx_twin < ptr_rows[v + 1];
+            is_passing = is_passing && idx_cols[idx_twin] == u;
+            is_passing = is_passing && edge_ids[idx_twin] == edge_ids[idx_nnz];
+
+            // The ids of (u, v), u < v, follow lexicographic order.
+            if (u < v) {
+                is_passing = is_passing && edge_ids[idx_nnz] == idx_expected_edge;
+                idx_expected_edge++;
+            }
+        }
+    }
+
+    free(reverse_edges);
+    free(edge_ids);
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_get_edge_supports() {
+    Graph* graph = graph_new_from_file("data/input/sample");
+
+    int expected_supports[] = {1, 1, 2, 2, 2, 3, 2, 2, 2, 3, 2, 2, 2, 2, 3, 2, 2, 3, 2, 2, 0, 1, 0, 1, 0, 1, 0, 0, 0, 0};
+
+    int* reverse_edges = graph_get_reverse_edges(graph);
+    int* edge_ids = graph_get_edge_ids(graph, reverse_edges);
+    int* supports = get_edge_supports(graph, edge_ids);
+
+    bool is_passing = array_is_equal(supports, expected_supports, graph->num_edges / 2, 30);
+
+    free(reverse_edges);
+    free(edge_ids);
+    free(supports);
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_run_truss_decomposition() {
+    Graph* graph = graph_new_from_file("data/input/sample");
+
+    int expected_truss_numbers[] = {3, 3, 3, 4, 3, 4, 4, 4, 4, 4, 4, 4, 3, 4, 4, 3, 3, 4, 3, 4, 2, 3, 2, 3, 2, 3, 2, 2, 2, 2};
+
+    TrussDecomposition* decomposition = run_truss_decomposition(graph);
+
+    bool is_passing = array_is_equal(decomposition->truss_numbers, expected_truss_numbers, decomposition->num_edges, 30);
+    is_passing = is_passing && decomposition->max_truss_number == 4;
+    is_passing = is_passing && decomposition->edge_sources[0] == 0 && decomposition->edge_targets[0] == 1;
+
+    truss_decomposition_delete(&decomposition);
+    graph_delete(&graph);
+
+    print_test_result(__FILE__, __func__, is_passing);
+}
+
+void test_truss() {
+    test_graph_get_edge_ids();
+    test_get_edge_supports();
+    test_run_truss_decomposition();
+}
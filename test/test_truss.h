@@ -0,0 +1,16 @@
+#ifndef TEST_TRUSS_H_INCLUDED
+#define TEST_TRUSS_H_INCLUDED
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/algorithms/truss.h"
+#include "../src/collections/graph.h"
+#include "../src/utilities/print_format.h"
+
+void test_truss();
+
+#endif